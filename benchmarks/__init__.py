@@ -0,0 +1 @@
+"""Benchmark suites for vldt, runnable with asv or benchmarks/run.py."""
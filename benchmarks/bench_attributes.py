@@ -0,0 +1,33 @@
+"""Benchmarks of reading and assigning instance attributes."""
+
+from benchmarks.models import SHAPES
+
+
+class Attributes:
+    """Time field and extra attribute access on a flat model."""
+
+    def setup(self):
+        """Prepare an instance with an extra attribute."""
+        model, data = SHAPES["flat"]
+        self.instance = model(**data)
+        self.instance.extra = "value"
+
+    def time_getattr_field(self):
+        """Read a declared field."""
+        self.instance.name
+
+    def time_getattr_extra(self):
+        """Read an extra attribute."""
+        self.instance.extra
+
+    def time_setattr_field(self):
+        """Assign a declared field a value of its type."""
+        self.instance.id = 2
+
+    def time_setattr_field_coerced(self):
+        """Assign a declared field a value that must be converted."""
+        self.instance.id = "2"
+
+    def time_setattr_extra(self):
+        """Assign an extra attribute."""
+        self.instance.extra = "other"
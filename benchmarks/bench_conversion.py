@@ -0,0 +1,40 @@
+"""Benchmarks of building instances from and exporting them to dicts and JSON."""
+
+from benchmarks.models import SHAPES, shape_json
+
+
+class Conversion:
+    """Time each conversion entry point on every model shape."""
+
+    params = list(SHAPES)
+    param_names = ["shape"]
+
+    def setup(self, shape):
+        """Prepare the model, its inputs and an instance.
+
+        Args:
+            shape (str): The name of the shape.
+        """
+        self.model, self.data = SHAPES[shape]
+        self.text = shape_json(shape)
+        self.instance = self.model(**self.data)
+
+    def time_init(self, shape):
+        """Build an instance from keyword arguments."""
+        self.model(**self.data)
+
+    def time_from_dict(self, shape):
+        """Build an instance from a dict."""
+        self.model.from_dict(self.data)
+
+    def time_from_json(self, shape):
+        """Build an instance from JSON text."""
+        self.model.from_json(self.text)
+
+    def time_to_dict(self, shape):
+        """Export an instance to a dict."""
+        self.instance.to_dict()
+
+    def time_to_json(self, shape):
+        """Export an instance to JSON text."""
+        self.instance.to_json()
@@ -0,0 +1,73 @@
+"""Benchmarks of schema compilation, import time and instance memory."""
+
+import tracemalloc
+
+from vldt import freelist_stats
+
+from benchmarks.models import SHAPES, make_model
+
+INSTANCES = 1000
+
+
+class Schema:
+    """Time defining a model class and compiling its schema."""
+
+    params = list(SHAPES)
+    param_names = ["shape"]
+
+    def setup(self, shape):
+        """Copy the annotations of the shape.
+
+        Args:
+            shape (str): The name of the shape.
+        """
+        self.name = SHAPES[shape][0].__name__
+        self.annotations = dict(SHAPES[shape][0].__annotations__)
+
+    def time_define_and_compile(self, shape):
+        """Define a class from the annotations and compile its schema."""
+        # freelist_stats compiles the schema without validating an instance.
+        freelist_stats(make_model(self.name, self.annotations))
+
+
+class Memory:
+    """Track the memory held by instances of each shape."""
+
+    params = list(SHAPES)
+    param_names = ["shape"]
+
+    def setup(self, shape):
+        """Prepare the model and its input.
+
+        Args:
+            shape (str): The name of the shape.
+        """
+        self.model, self.data = SHAPES[shape]
+
+    def track_bytes_per_instance(self, shape):
+        """Measure the memory allocated per validated instance.
+
+        Includes the values the instance holds, such as converted lists.
+
+        Returns:
+            float: The number of bytes per instance.
+        """
+        tracemalloc.start()
+        try:
+            instances = [self.model(**self.data) for _ in range(INSTANCES)]
+            size, _ = tracemalloc.get_traced_memory()
+        finally:
+            tracemalloc.stop()
+        del instances
+        return size / INSTANCES
+
+    track_bytes_per_instance.unit = "bytes"
+
+
+def timeraw_import():
+    """Time importing vldt in a fresh interpreter.
+
+    Returns:
+        str: The code to time.
+    """
+    return "import vldt"
@@ -0,0 +1,27 @@
+"""Benchmarks of the validation failure path."""
+
+from vldt import ValidationError
+
+from benchmarks.models import INVALID
+
+
+class Failures:
+    """Time rejecting invalid input, including building the error."""
+
+    params = list(INVALID)
+    param_names = ["shape"]
+
+    def setup(self, shape):
+        """Prepare the model and its invalid input.
+
+        Args:
+            shape (str): The name of the shape.
+        """
+        self.model, self.data = INVALID[shape]
+
+    def time_invalid_init(self, shape):
+        """Build an instance from invalid keyword arguments."""
+        try:
+            self.model(**self.data)
+        except (ValidationError, ValueError):
+            pass
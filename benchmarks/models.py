@@ -0,0 +1,249 @@
+"""Model shapes and deterministic inputs shared by the benchmark suites.
+
+Each shape isolates one dimension of the schema: the number of fields, the
+nesting depth, the size of a container or the kind of field. The inputs
+are built from fixed values, so every run validates the same data.
+"""
+
+import json
+from typing import Any, Dict, List, Optional, Union
+
+from vldt import DataModel, ValidatorMode, field_validator, model_validator
+
+WIDE_FIELDS = 100
+DEEP_LEVELS = 10
+LARGE_LIST_SIZE = 10_000
+
+
+def make_model(name: str, annotations: Dict[str, Any], **namespace) -> type:
+    """Create a DataModel subclass from field annotations.
+
+    Args:
+        name (str): The class name.
+        annotations (Dict[str, Any]): Field names mapped to their types.
+        **namespace: Other class attributes, such as defaults.
+
+    Returns:
+        type: The new model class.
+    """
+    return type(name, (DataModel,), {"__annotations__": annotations, **namespace})
+
+
+class Flat(DataModel):
+    """Model with a handful of primitive fields.
+
+    Attributes:
+        id (int): The identifier.
+        name (str): The name.
+        score (float): The score.
+        active (bool): Whether the record is active.
+        note (Optional[str]): An optional note.
+    """
+
+    id: int
+    name: str
+    score: float
+    active: bool
+    note: Optional[str]
+
+
+class Address(DataModel):
+    """Model nested in Nested.
+
+    Attributes:
+        street (str): The street address.
+        city (str): The city name.
+    """
+
+    street: str
+    city: str
+
+
+class Item(DataModel):
+    """Model held in a list by Nested.
+
+    Attributes:
+        sku (str): The stock keeping unit.
+        quantity (int): The quantity.
+    """
+
+    sku: str
+    quantity: int
+
+
+class Nested(DataModel):
+    """Model holding a nested model, a list of models and a dict.
+
+    Attributes:
+        id (int): The identifier.
+        address (Address): The address.
+        items (List[Item]): The ordered items.
+        labels (Dict[str, str]): Free-form labels.
+    """
+
+    id: int
+    address: Address
+    items: List[Item]
+    labels: Dict[str, str]
+
+
+Wide = make_model(
+    "Wide",
+    {f"field_{i}": int if i % 2 else str for i in range(WIDE_FIELDS)},
+)
+
+
+def _make_deep() -> type:
+    """Create a chain of DEEP_LEVELS models, each nesting the next.
+
+    Returns:
+        type: The outermost model class.
+    """
+    model = make_model("Level0", {"value": int})
+    for level in range(1, DEEP_LEVELS):
+        model = make_model(f"Level{level}", {"value": int, "child": model})
+    return model
+
+
+Deep = _make_deep()
+
+
+class LargeList(DataModel):
+    """Model with one large list of ints.
+
+    Attributes:
+        values (List[int]): The values.
+    """
+
+    values: List[int]
+
+
+class Unions(DataModel):
+    """Model whose fields are unions resolved by different members.
+
+    Attributes:
+        first (Union[int, str]): Matched by its first member.
+        last (Union[int, str, List[int], Dict[str, int]]): Matched by its
+            last member.
+        coerced (Union[List[int], float]): Converted by a later member.
+    """
+
+    first: Union[int, str]
+    last: Union[int, str, List[int], Dict[str, int]]
+    coerced: Union[List[int], float]
+
+
+class Validated(DataModel):
+    """Model with field and model validators.
+
+    Attributes:
+        name (str): The name, normalized by a BEFORE validator.
+        age (int): The age, checked by an AFTER validator.
+    """
+
+    name: str
+    age: int
+
+    @field_validator(mode=ValidatorMode.BEFORE)
+    @classmethod
+    def strip_name(cls, name: Any):
+        """Strip whitespace from the name.
+
+        Args:
+            name (Any): The input value of the name.
+
+        Returns:
+            Any: The stripped name, or the value unchanged.
+        """
+        return name.strip() if isinstance(name, str) else name
+
+    @field_validator(mode=ValidatorMode.AFTER)
+    @classmethod
+    def check_age(cls, age: int):
+        """Reject negative ages.
+
+        Args:
+            age (int): The validated age.
+
+        Returns:
+            int: The unchanged age.
+
+        Raises:
+            ValueError: If the age is negative.
+        """
+        if age < 0:
+            raise ValueError("age must be non-negative")
+        return age
+
+    @model_validator(mode=ValidatorMode.AFTER)
+    def check_model(self):
+        """Check the instance as a whole."""
+        if not self.name:
+            raise ValueError("name must not be empty")
+
+
+def _deep_data(level: int) -> Dict[str, Any]:
+    """Build the input of a Level<level> model.
+
+    Args:
+        level (int): The level of the model.
+
+    Returns:
+        Dict[str, Any]: The input dict.
+    """
+    data: Dict[str, Any] = {"value": level}
+    if level:
+        data["child"] = _deep_data(level - 1)
+    return data
+
+
+SHAPES = {
+    "flat": (
+        Flat,
+        {"id": 1, "name": "record", "score": 0.5, "active": True, "note": None},
+    ),
+    "nested": (
+        Nested,
+        {
+            "id": 1,
+            "address": {"street": "Main", "city": "Springfield"},
+            "items": [{"sku": f"sku-{i}", "quantity": i} for i in range(10)],
+            "labels": {f"key_{i}": f"value_{i}" for i in range(5)},
+        },
+    ),
+    "wide": (
+        Wide,
+        {f"field_{i}": i if i % 2 else f"value_{i}" for i in range(WIDE_FIELDS)},
+    ),
+    "deep": (Deep, _deep_data(DEEP_LEVELS - 1)),
+    "large_list": (LargeList, {"values": list(range(LARGE_LIST_SIZE))}),
+    "unions": (Unions, {"first": 1, "last": {"a": 1, "b": 2}, "coerced": "2.5"}),
+    "validated": (Validated, {"name": "  Ann  ", "age": 30}),
+}
+
+# Inputs that fail validation, one per shape kind.
+INVALID = {
+    "flat": (Flat, {"id": "x", "name": "record", "score": [], "active": True}),
+    "nested": (
+        Nested,
+        {
+            "id": 1,
+            "address": {"street": "Main"},
+            "items": [{"sku": "a", "quantity": "many"}] * 10,
+            "labels": {},
+        },
+    ),
+    "validated": (Validated, {"name": "Ann", "age": -1}),
+}
+
+
+def shape_json(shape: str) -> str:
+    """Return the input of a shape as JSON text.
+
+    Args:
+        shape (str): The name of the shape.
+
+    Returns:
+        str: The JSON text.
+    """
+    return json.dumps(SHAPES[shape][1])
@@ -0,0 +1,238 @@
+"""Run the benchmark suites without asv and compare against a baseline.
+
+The suites follow the asv conventions: classes with ``params``,
+``param_names`` and ``setup``, whose ``time_*`` methods are timed and whose
+``track_*`` methods return a value, and module-level ``timeraw_*`` functions
+returning code timed in a fresh interpreter. This runner uses the vldt
+importable from the current environment, such as an in-place build::
+
+    python benchmarks/run.py --output results.json
+    python benchmarks/run.py --baseline results.json --threshold 1.2
+
+With a baseline, it exits with status 1 if any timing is slower than the
+baseline by more than the threshold factor.
+"""
+
+import argparse
+import importlib
+import inspect
+import itertools
+import json
+import os
+import pkgutil
+import subprocess
+import sys
+import timeit
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+if ROOT not in sys.path:
+    sys.path.insert(0, ROOT)
+
+import benchmarks  # noqa: E402
+
+
+def parameter_sets(suite):
+    """Return the parameter combinations of a suite class.
+
+    Args:
+        suite (type): The suite class.
+
+    Returns:
+        list: Tuples of parameters, one per combination.
+    """
+    params = getattr(suite, "params", None)
+    if params is None:
+        return [()]
+    if len(getattr(suite, "param_names", ())) > 1:
+        return list(itertools.product(*params))
+    return [(value,) for value in params]
+
+
+def measure_call(func, repeat):
+    """Time a call, returning the best time per call in seconds.
+
+    Args:
+        func (callable): The function to time.
+        repeat (int): The number of timed rounds.
+
+    Returns:
+        float: The best time per call.
+    """
+    timer = timeit.Timer(func)
+    number, _ = timer.autorange()
+    return min(timer.repeat(repeat=repeat, number=number)) / number
+
+
+def measure_raw(code, repeat):
+    """Time running code in a fresh interpreter.
+
+    Args:
+        code (str): The code to run.
+        repeat (int): The number of runs.
+
+    Returns:
+        float: The best time in seconds.
+    """
+    script = (
+        "import time\n"
+        "start = time.perf_counter()\n"
+        f"exec({code!r})\n"
+        "print(time.perf_counter() - start)\n"
+    )
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    return min(
+        float(
+            subprocess.run(
+                [sys.executable, "-c", script],
+                check=True,
+                capture_output=True,
+                text=True,
+                env=env,
+            ).stdout
+        )
+        for _ in range(repeat)
+    )
+
+
+def run_suites(pattern, repeat):
+    """Run every benchmark whose name contains a pattern.
+
+    Args:
+        pattern (str): Substring the benchmark names must contain.
+        repeat (int): The number of timed rounds.
+
+    Returns:
+        dict: Benchmark names mapped to their results.
+    """
+    results = {}
+    for info in pkgutil.iter_modules(benchmarks.__path__):
+        if not info.name.startswith("bench_"):
+            continue
+        module = importlib.import_module(f"benchmarks.{info.name}")
+        for name, obj in vars(module).items():
+            full_name = f"{info.name}.{name}"
+            if name.startswith("timeraw_") and inspect.isfunction(obj):
+                if pattern in full_name:
+                    results[full_name] = {
+                        "kind": "time",
+                        "value": measure_raw(obj(), repeat),
+                    }
+            elif inspect.isclass(obj) and obj.__module__ == module.__name__:
+                results.update(run_suite(full_name, obj, pattern, repeat))
+    return results
+
+
+def run_suite(suite_name, suite, pattern, repeat):
+    """Run the benchmarks of one suite class.
+
+    Args:
+        suite_name (str): The qualified name of the suite.
+        suite (type): The suite class.
+        pattern (str): Substring the benchmark names must contain.
+        repeat (int): The number of timed rounds.
+
+    Returns:
+        dict: Benchmark names mapped to their results.
+    """
+    results = {}
+    methods = [
+        name
+        for name in dir(suite)
+        if name.startswith(("time_", "track_")) and pattern in f"{suite_name}.{name}"
+    ]
+    for params in parameter_sets(suite) if methods else ():
+        for method_name in methods:
+            instance = suite()
+            if hasattr(instance, "setup"):
+                instance.setup(*params)
+            method = getattr(instance, method_name)
+            label = f"{suite_name}.{method_name}"
+            if params:
+                label += f"({', '.join(map(str, params))})"
+            if method_name.startswith("time_"):
+                value = measure_call(lambda: method(*params), repeat)
+                results[label] = {"kind": "time", "value": value}
+            else:
+                results[label] = {
+                    "kind": "track",
+                    "value": method(*params),
+                    "unit": getattr(method, "unit", ""),
+                }
+    return results
+
+
+def format_result(result):
+    """Format a result for display.
+
+    Args:
+        result (dict): The result.
+
+    Returns:
+        str: The formatted value.
+    """
+    if result["kind"] != "time":
+        return f"{result['value']:.1f} {result['unit']}".strip()
+    value = result["value"]
+    for unit, scale in (("s", 1), ("ms", 1e3), ("us", 1e6)):
+        if value * scale >= 1:
+            return f"{value * scale:.3f} {unit}"
+    return f"{value * 1e9:.1f} ns"
+
+
+def compare(results, baseline, threshold):
+    """Report the timings slower than the baseline by the threshold.
+
+    Args:
+        results (dict): The current results.
+        baseline (dict): The baseline results.
+        threshold (float): The slowdown factor considered a regression.
+
+    Returns:
+        list: The names of the regressed benchmarks.
+    """
+    regressions = []
+    for name, result in results.items():
+        previous = baseline.get(name)
+        if not previous or result["kind"] != "time" or not previous["value"]:
+            continue
+        ratio = result["value"] / previous["value"]
+        if ratio > threshold:
+            regressions.append(name)
+            print(f"REGRESSION {name}: {ratio:.2f}x ({format_result(previous)})")
+    return regressions
+
+
+def main():
+    """Parse the arguments, run the benchmarks and report the results.
+
+    Returns:
+        int: The exit status.
+    """
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        "-k", "--pattern", default="", help="only run names containing this"
+    )
+    parser.add_argument("--repeat", type=int, default=5, help="timed rounds")
+    parser.add_argument("--output", help="write the results to this JSON file")
+    parser.add_argument("--baseline", help="compare with this results file")
+    parser.add_argument(
+        "--threshold", type=float, default=1.2, help="regression factor"
+    )
+    args = parser.parse_args()
+
+    results = run_suites(args.pattern, args.repeat)
+    width = max(map(len, results), default=0)
+    for name, result in results.items():
+        print(f"{name:<{width}}  {format_result(result)}")
+    if args.output:
+        with open(args.output, "w") as output:
+            json.dump(results, output, indent=2, sort_keys=True)
+    if args.baseline:
+        with open(args.baseline) as baseline:
+            if compare(results, json.load(baseline), args.threshold):
+                return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -21,8 +21,14 @@ class BuildExt(build_ext):
                 ext.extra_link_args = ["/LTCG"]
             else:
                 # GCC/Clang flags (Linux/macOS)
-                ext.extra_compile_args = ["-O3", "-Wall", "-std=c++20", "-flto"]
-                ext.extra_link_args = ["-flto"]
+                ext.extra_compile_args = [
+                    "-O3",
+                    "-Wall",
+                    "-std=c++20",
+                    "-flto",
+                    "-pthread",
+                ]
+                ext.extra_link_args = ["-flto", "-pthread"]
         super().build_extensions()
 
 
@@ -31,14 +37,23 @@ module = Extension(
     sources=[
         "src/vldt_module.cpp",
         "src/data_model.cpp",
+        "src/error_handling.cpp",
         "src/init_globals.cpp",
+        "src/stats.cpp",
+        "src/conversion/batch_utils.cpp",
+        "src/conversion/columnar.cpp",
         "src/conversion/dict_utils.cpp",
+        "src/conversion/json_lines.cpp",
+        "src/conversion/json_parse.cpp",
         "src/conversion/json_utils.cpp",
+        "src/conversion/msgpack_utils.cpp",
         "src/conversion/rapidjson_to_pyobject.cpp",
         "src/schema/schema.cpp",
         "src/schema/deserializer.cpp",
         "src/validation/validation.cpp",
+        "src/validation/validation_builtins.cpp",
         "src/validation/validation_containers.cpp",
+        "src/validation/validation_native.cpp",
         "src/validation/validation_primitives.cpp",
         "src/validation/validation_validators.cpp",
     ],
@@ -0,0 +1,327 @@
+#include "batch_utils.hpp"
+#include "conversion/json_parse.hpp"
+#include "conversion/rapidjson_to_pyobject.hpp"
+#include "data_model.hpp"
+#include "error_handling.hpp"
+#include "init_globals.hpp"
+#include "schema/schema.hpp"
+#include <Python.h>
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <string>
+
+/**
+ * @brief Resolve the schema and construction path for a model class.
+ *
+ * @param cls The model class.
+ * @param ctx The context to fill.
+ * @return 0 on success, -1 on failure.
+ */
+int init_batch_context(PyObject *cls, BatchContext *ctx) {
+  if (!PyType_Check(cls)) {
+    PyErr_SetString(PyExc_TypeError, "Expected a model class");
+    return -1;
+  }
+  ctx->schema = get_schema_cached(cls);
+  if (!ctx->schema) {
+    return -1;
+  }
+  ctx->cls = cls;
+  ctx->type = reinterpret_cast<PyTypeObject *>(cls);
+  ctx->native_init = DataModel_supports_native_init(ctx->type);
+  return 0;
+}
+
+/**
+ * @brief Record the pending exception as the errors of one record.
+ *
+ * Validation failures (TypeError and ValueError) are added under the record
+ * index; ValidationError records and structured error JSON are nested with
+ * the index as prefix. Any other
+ * exception is left pending.
+ *
+ * @param collector The batch error collector.
+ * @param index The record index.
+ * @return 0 if the error was recorded, -1 if it must be propagated.
+ */
+int record_batch_error(ErrorCollector *collector, Py_ssize_t index) {
+  if (!PyErr_ExceptionMatches(PyExc_TypeError) &&
+      !PyErr_ExceptionMatches(PyExc_ValueError)) {
+    return -1;
+  }
+  PyObject *exc_type = nullptr, *exc_value = nullptr, *exc_tb = nullptr;
+  PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+  std::string key = std::to_string(index);
+  const std::vector<ErrorRecord> *records = validation_error_records(exc_value);
+  if (records) {
+    collector->merge(key, *records);
+    Py_XDECREF(exc_type);
+    Py_XDECREF(exc_value);
+    Py_XDECREF(exc_tb);
+    return 0;
+  }
+  PyObject *exc_str = exc_value ? PyObject_Str(exc_value) : nullptr;
+  const char *message = exc_str ? PyUnicode_AsUTF8(exc_str) : nullptr;
+  if (!message) {
+    PyErr_Clear();
+    message = "Unknown error";
+  }
+  if (message[0] == '{') {
+    collector->add_suberror(key, message);
+  } else {
+    collector->add_error(key, message);
+  }
+  Py_XDECREF(exc_str);
+  Py_XDECREF(exc_type);
+  Py_XDECREF(exc_value);
+  Py_XDECREF(exc_tb);
+  return 0;
+}
+
+/**
+ * @brief Build one instance from a JSON object of a batch.
+ *
+ * @param ctx The batch context.
+ * @param item The rapidjson element.
+ * @return A new instance, or nullptr on error.
+ */
+PyObject *batch_build_from_native(const BatchContext &ctx,
+                                  const rapidjson::Value &item) {
+  if (!item.IsObject()) {
+    PyErr_SetString(PyExc_TypeError, "Expected a JSON object");
+    return nullptr;
+  }
+  if (ctx.native_init) {
+    PyObject *instance = DataModel_alloc(ctx.type, ctx.schema);
+    if (instance &&
+        DataModel_init_native_with_schema(instance, item, ctx.schema) != 0) {
+      Py_CLEAR(instance);
+    }
+    return instance;
+  }
+  PyObject *dict_obj = rapidjson_to_kwds(item, ctx.schema);
+  if (!dict_obj) {
+    return nullptr;
+  }
+  PyObject *instance = PyObject_Call(ctx.cls, empty_tuple, dict_obj);
+  Py_DECREF(dict_obj);
+  return instance;
+}
+
+/**
+ * @brief Build one instance from a dict of the batch.
+ *
+ * @param ctx The batch context.
+ * @param item The input dictionary.
+ * @return A new instance, or nullptr on error.
+ */
+static PyObject *build_from_dict(const BatchContext &ctx, PyObject *item) {
+  if (!PyDict_Check(item)) {
+    PyErr_Format(PyExc_TypeError, "Expected type dict, got %s",
+                 Py_TYPE(item)->tp_name);
+    return nullptr;
+  }
+  if (ctx.native_init) {
+    PyObject *instance = DataModel_alloc(ctx.type, ctx.schema);
+    if (instance &&
+        DataModel_init_with_schema(instance, item, ctx.schema) != 0) {
+      Py_CLEAR(instance);
+    }
+    return instance;
+  }
+  return PyObject_Call(ctx.cls, empty_tuple, item);
+}
+
+/**
+ * @brief Build all records of a batch into a list.
+ *
+ * @param count The number of records.
+ * @param fail_fast Stop at the first invalid record.
+ * @param build Callable building the instance for a given index.
+ * @return A new list of instances, or nullptr on error.
+ */
+template <typename Build>
+static PyObject *run_batch(Py_ssize_t count, bool fail_fast, Build build) {
+  PyObject *result = PyList_New(count);
+  if (!result) {
+    return nullptr;
+  }
+  ErrorCollector collector;
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject *instance = build(i);
+    if (!instance) {
+      if (record_batch_error(&collector, i) != 0) {
+        Py_DECREF(result);
+        return nullptr;
+      }
+      if (fail_fast) {
+        break;
+      }
+      continue;
+    }
+    PyList_SET_ITEM(result, i, instance);
+  }
+  if (collector.has_errors()) {
+    Py_DECREF(result);
+    collector.raise();
+    return nullptr;
+  }
+  return result;
+}
+
+static const char *batch_kwlist[] = {"data", "fail_fast", nullptr};
+
+static const char *from_json_many_kwlist[] = {"data", "fail_fast", "workers",
+                                              nullptr};
+
+/**
+ * @brief Parse a JSON array and build one instance per element.
+ *
+ * @param cls The model class.
+ * @param json_str JSON text, kept alive and unresizable by the caller.
+ * @param json_length Length of the JSON text in bytes.
+ * @param fail_fast Stop at the first invalid record.
+ * @param workers Number of parse workers, or 0 for one per core.
+ * @return A new list of instances, or nullptr on error.
+ */
+static PyObject *from_json_many_impl(PyObject *cls, const char *json_str,
+                                     size_t json_length, bool fail_fast,
+                                     Py_ssize_t workers) {
+  if (json_length == 0) {
+    PyErr_SetString(PyExc_ValueError, "Empty JSON string");
+    return nullptr;
+  }
+
+  BatchContext ctx;
+  if (init_batch_context(cls, &ctx) != 0) {
+    return nullptr;
+  }
+
+  if (workers != 1) {
+    ParsedJsonArray parsed;
+    if (parse_json_array_parallel(json_str, json_length, workers, &parsed)) {
+      return run_batch(static_cast<Py_ssize_t>(parsed.items.size()),
+                       fail_fast, [&](Py_ssize_t i) -> PyObject * {
+                         return batch_build_from_native(ctx,
+                                                        *parsed.items[i]);
+                       });
+    }
+  }
+
+  rapidjson::Document doc;
+  parse_json_document(doc, json_str, json_length);
+  if (doc.HasParseError()) {
+    PyErr_Format(PyExc_ValueError, "rapidjson parse error: %s (at offset %u)",
+                 rapidjson::GetParseError_En(doc.GetParseError()),
+                 static_cast<unsigned>(doc.GetErrorOffset()));
+    return nullptr;
+  }
+  if (!doc.IsArray()) {
+    PyErr_SetString(PyExc_TypeError, "JSON root must be an array");
+    return nullptr;
+  }
+
+  return run_batch(
+      static_cast<Py_ssize_t>(doc.Size()), fail_fast,
+      [&](Py_ssize_t i) -> PyObject * {
+        return batch_build_from_native(
+            ctx, doc[static_cast<rapidjson::SizeType>(i)]);
+      });
+}
+
+extern "C" {
+
+/**
+ * @brief Create a list of DataModel instances from a JSON array.
+ */
+PyObject *batch_utils_from_json_many(PyObject *cls, PyObject *args,
+                                     PyObject *kwds) {
+  PyObject *data = nullptr;
+  int fail_fast = 1;
+  Py_ssize_t workers = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|$pn:from_json_many",
+                                   const_cast<char **>(from_json_many_kwlist),
+                                   &data, &fail_fast, &workers)) {
+    return nullptr;
+  }
+  if (workers < 0) {
+    PyErr_SetString(PyExc_ValueError, "workers must be 0 or positive");
+    return nullptr;
+  }
+
+  if (PyUnicode_Check(data)) {
+    Py_ssize_t json_length = 0;
+    const char *json_str = PyUnicode_AsUTF8AndSize(data, &json_length);
+    if (!json_str) {
+      return nullptr;
+    }
+    return from_json_many_impl(cls, json_str,
+                               static_cast<size_t>(json_length), fail_fast,
+                               workers);
+  }
+  if (PyBytes_Check(data)) {
+    return from_json_many_impl(cls, PyBytes_AS_STRING(data),
+                               static_cast<size_t>(PyBytes_GET_SIZE(data)),
+                               fail_fast, workers);
+  }
+  if (!PyObject_CheckBuffer(data)) {
+    PyErr_SetString(PyExc_TypeError,
+                    "Argument must be a str or a bytes-like object");
+    return nullptr;
+  }
+  // The export keeps a bytearray from being resized while the GIL is
+  // released for parsing.
+  Py_buffer view;
+  if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) != 0) {
+    return nullptr;
+  }
+  PyObject *result =
+      from_json_many_impl(cls, static_cast<const char *>(view.buf),
+                          static_cast<size_t>(view.len), fail_fast, workers);
+  PyBuffer_Release(&view);
+  return result;
+}
+
+/**
+ * @brief Create a list of DataModel instances from a sequence of dicts.
+ */
+PyObject *batch_utils_validate_many(PyObject *cls, PyObject *args,
+                                    PyObject *kwds) {
+  PyObject *data = nullptr;
+  int fail_fast = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|$p:validate_many",
+                                   const_cast<char **>(batch_kwlist), &data,
+                                   &fail_fast)) {
+    return nullptr;
+  }
+  if (!PyList_Check(data) && !PyTuple_Check(data)) {
+    PyErr_SetString(PyExc_TypeError, "Argument must be a list or tuple");
+    return nullptr;
+  }
+
+  BatchContext ctx;
+  if (init_batch_context(cls, &ctx) != 0) {
+    return nullptr;
+  }
+
+  // Hold a reference in case a validator mutates the input list.
+  Py_INCREF(data);
+  PyObject *result =
+      run_batch(PySequence_Fast_GET_SIZE(data), fail_fast,
+                [&](Py_ssize_t i) -> PyObject * {
+                  if (i >= PySequence_Fast_GET_SIZE(data)) {
+                    PyErr_SetString(PyExc_RuntimeError,
+                                    "Input sequence changed size");
+                    return nullptr;
+                  }
+                  PyObject *item = PySequence_Fast_GET_ITEM(data, i);
+                  Py_INCREF(item);
+                  PyObject *instance = build_from_dict(ctx, item);
+                  Py_DECREF(item);
+                  return instance;
+                });
+  Py_DECREF(data);
+  return result;
+}
+
+} // extern "C"
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Python.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create a list of DataModel instances from a JSON array.
+ *
+ * Accepts a JSON array (str or a bytes-like object) whose elements are
+ * objects, plus optional keyword-only fail_fast (default True) and workers
+ * (default 1) arguments. The schema is resolved and the document parsed once
+ * for the whole batch, with the GIL released for large inputs; with more
+ * than one worker (0 for one per core) large arrays are parsed in parallel
+ * before the instances are built. Failures are reported per record index in
+ * a single ValidationError; with fail_fast the first invalid record stops
+ * the batch, otherwise every record is validated.
+ *
+ * @param cls The Python type object for the DataModel.
+ * @param args Positional arguments (the JSON array).
+ * @param kwds Keyword arguments (fail_fast, workers).
+ * @return A new list of instances on success, or NULL on error.
+ */
+PyObject *batch_utils_from_json_many(PyObject *cls, PyObject *args,
+                                     PyObject *kwds);
+
+/**
+ * @brief Create a list of DataModel instances from a sequence of dicts.
+ *
+ * Accepts a list or tuple of dictionaries, plus an optional keyword-only
+ * fail_fast flag (default True). Errors are reported per record index as in
+ * batch_utils_from_json_many.
+ *
+ * @param cls The Python type object for the DataModel.
+ * @param args Positional arguments (the sequence of dicts).
+ * @param kwds Keyword arguments (fail_fast).
+ * @return A new list of instances on success, or NULL on error.
+ */
+PyObject *batch_utils_validate_many(PyObject *cls, PyObject *args,
+                                    PyObject *kwds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+#include "error_handling.hpp"
+#include "schema/schema.hpp"
+#include <rapidjson/document.h>
+
+/**
+ * @brief Per-batch state resolved once before the records are processed.
+ */
+struct BatchContext {
+  PyObject *cls;       // The model class (borrowed).
+  PyTypeObject *type;  // The model class as a type object.
+  SchemaCache *schema; // The compiled schema of the class.
+  bool native_init;    // Whether instances can be built without calling cls.
+};
+
+/**
+ * @brief Resolve the schema and construction path for a model class.
+ *
+ * @param cls The model class.
+ * @param ctx The context to fill.
+ * @return 0 on success, -1 on failure.
+ */
+int init_batch_context(PyObject *cls, BatchContext *ctx);
+
+/**
+ * @brief Record the pending exception as the errors of one record.
+ *
+ * Validation failures (TypeError, including ValidationError, and
+ * ValueError) are added under the record index; the errors of a
+ * ValidationError, or structured error JSON, are nested with the index as
+ * prefix. Any other exception is left pending.
+ *
+ * @param collector The batch error collector.
+ * @param index The record index.
+ * @return 0 if the error was recorded, -1 if it must be propagated.
+ */
+int record_batch_error(ErrorCollector *collector, Py_ssize_t index);
+
+/**
+ * @brief Build one instance from a JSON object of a batch.
+ *
+ * @param ctx The batch context.
+ * @param item The rapidjson element.
+ * @return A new instance, or nullptr on error.
+ */
+PyObject *batch_build_from_native(const BatchContext &ctx,
+                                  const rapidjson::Value &item);
+#endif // __cplusplus
@@ -0,0 +1,576 @@
+#include "columnar.hpp"
+#include "conversion/dict_utils.hpp"
+#include "data_model.hpp"
+#include "schema/schema.hpp"
+#include <Python.h>
+#include <new>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_NULLABLE 2
+
+// Structures of the Arrow C Data Interface, as given by its specification.
+struct ArrowSchema {
+  const char *format;
+  const char *name;
+  const char *metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema **children;
+  struct ArrowSchema *dictionary;
+  void (*release)(struct ArrowSchema *);
+  void *private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void **buffers;
+  struct ArrowArray **children;
+  struct ArrowArray *dictionary;
+  void (*release)(struct ArrowArray *);
+  void *private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+/**
+ * @brief One step from a model to one of its fields.
+ */
+struct ColumnHop {
+  PyTypeObject *type;  // The model class declaring the field.
+  SchemaCache *schema; // Its schema.
+  Py_ssize_t index;    // The index of the field.
+};
+
+/**
+ * @brief A column: the fields followed from the exported model to a value.
+ */
+struct Column {
+  std::string name;            // Dotted path of the field names.
+  std::vector<ColumnHop> hops; // One step per nesting level.
+  TypeSchema *type_schema;     // The schema of the last field.
+};
+
+/**
+ * @brief Return the model a field holds, if it is flattened into columns.
+ *
+ * @param ts The TypeSchema of the field.
+ * @return The TypeSchema of the model for Model and Optional[Model] fields,
+ * nullptr for any other field.
+ */
+static TypeSchema *flattened_model(TypeSchema *ts) {
+  if (ts->op == OP_OPTIONAL) {
+    ts = ts->optional_target;
+  }
+  return ts->op == OP_MODEL && PyType_Check(ts->expected_type) ? ts : nullptr;
+}
+
+/**
+ * @brief Append the columns of a model's fields to a plan.
+ *
+ * @param type The model class.
+ * @param schema Its schema.
+ * @param prefix Column name prefix, empty at the top level.
+ * @param hops The steps leading to the model; restored on return.
+ * @param columns The plan receiving the columns.
+ * @return 0 on success, -1 with an exception set on failure.
+ */
+static int plan_columns(PyTypeObject *type, SchemaCache *schema,
+                        const std::string &prefix,
+                        std::vector<ColumnHop> &hops,
+                        std::vector<Column> *columns) {
+  for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+    FieldSchema *fs = &schema->fields[i];
+    hops.push_back({type, schema, i});
+    std::string name = prefix + fs->field_name_c;
+    TypeSchema *model = flattened_model(fs->type_schema);
+    PyTypeObject *model_type =
+        model ? reinterpret_cast<PyTypeObject *>(model->expected_type)
+              : nullptr;
+    for (const ColumnHop &hop : hops) {
+      if (hop.type == model_type) {
+        model_type = nullptr; // Recursive model: kept as one column.
+        break;
+      }
+    }
+    if (model_type) {
+      SchemaCache *nested = get_schema_cached((PyObject *)model_type);
+      if (!nested ||
+          plan_columns(model_type, nested, name + ".", hops, columns) != 0) {
+        return -1;
+      }
+    } else {
+      columns->push_back({name, hops, fs->type_schema});
+    }
+    hops.pop_back();
+  }
+  return 0;
+}
+
+/**
+ * @brief Check the instances of an export and plan its columns.
+ *
+ * Pending fields of lazy instances are validated here.
+ *
+ * @param cls The model class.
+ * @param instances The instances to export.
+ * @param columns Receives the columns.
+ * @return New reference to the instances as a list or tuple, or nullptr
+ * with an exception set.
+ */
+static PyObject *prepare_export(PyObject *cls, PyObject *instances,
+                                std::vector<Column> *columns) {
+  if (!PyType_Check(cls)) {
+    PyErr_SetString(PyExc_TypeError, "Expected a model class");
+    return nullptr;
+  }
+  SchemaCache *schema = get_schema_cached(cls);
+  if (!schema) {
+    return nullptr;
+  }
+  PyObject *items =
+      PySequence_Fast(instances, "Expected a sequence of model instances");
+  if (!items) {
+    return nullptr;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(items);
+  PyObject **item_array = PySequence_Fast_ITEMS(items);
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject *item = item_array[i];
+    if (!PyObject_TypeCheck(item, (PyTypeObject *)cls)) {
+      PyErr_Format(PyExc_TypeError, "Expected instances of %s, got %s",
+                   ((PyTypeObject *)cls)->tp_name, Py_TYPE(item)->tp_name);
+      Py_DECREF(items);
+      return nullptr;
+    }
+    if (DataModel_validate_pending(item) < 0) {
+      Py_DECREF(items);
+      return nullptr;
+    }
+  }
+  std::vector<ColumnHop> hops;
+  if (plan_columns((PyTypeObject *)cls, schema, std::string(), hops,
+                   columns) != 0) {
+    Py_DECREF(items);
+    return nullptr;
+  }
+  return items;
+}
+
+/**
+ * @brief Read the value of a column for one instance.
+ *
+ * Instances of subclasses find the field by name in their own schema.
+ *
+ * @param item The exported instance.
+ * @param column The column.
+ * @return Borrowed value, Py_None if the field or an enclosing model is
+ * missing, or nullptr with an exception set.
+ */
+static PyObject *column_value(PyObject *item, const Column &column) {
+  PyObject *current = item;
+  for (size_t depth = 0; depth < column.hops.size(); depth++) {
+    const ColumnHop &hop = column.hops[depth];
+    if (!PyObject_TypeCheck(current, &DataModelType)) {
+      return Py_None;
+    }
+    if (depth > 0 && DataModel_validate_pending(current) < 0) {
+      return nullptr;
+    }
+    Py_ssize_t index = hop.index;
+    if (Py_TYPE(current) != hop.type) {
+      SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(current));
+      if (!schema) {
+        return nullptr;
+      }
+      index =
+          lookup_field_index(schema, hop.schema->fields[hop.index].field_name);
+    }
+    PyObject *value = index >= 0 && index < DataModel_num_slots(current)
+                          ? DataModel_slots(current)[index]
+                          : nullptr;
+    current = value ? value : Py_None;
+  }
+  return current;
+}
+
+/**
+ * @brief Buffers of one exported Arrow column.
+ */
+struct ArrowColumnArray {
+  std::vector<uint8_t> validity; // Bit set for non-null values.
+  std::vector<uint8_t> values;   // int64, float64 or the boolean bitmap.
+  std::vector<int32_t> offsets;  // utf8: start of each value in chars.
+  std::string chars;             // utf8: the concatenated values.
+  const void *buffers[3];
+};
+
+/**
+ * @brief Children of the exported Arrow struct array.
+ */
+struct ArrowBatchArray {
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray *> child_pointers;
+  const void *buffers[1] = {nullptr};
+};
+
+/**
+ * @brief Name of one exported Arrow column.
+ */
+struct ArrowColumnSchema {
+  std::string name;
+};
+
+/**
+ * @brief Children of the exported Arrow struct schema.
+ */
+struct ArrowBatchSchema {
+  std::vector<ArrowSchema> children;
+  std::vector<ArrowSchema *> child_pointers;
+};
+
+static void release_column_array(ArrowArray *array) {
+  delete static_cast<ArrowColumnArray *>(array->private_data);
+  array->release = nullptr;
+}
+
+static void release_batch_array(ArrowArray *array) {
+  auto data = static_cast<ArrowBatchArray *>(array->private_data);
+  for (ArrowArray &child : data->children) {
+    if (child.release) {
+      child.release(&child);
+    }
+  }
+  delete data;
+  array->release = nullptr;
+}
+
+static void release_column_schema(ArrowSchema *schema) {
+  delete static_cast<ArrowColumnSchema *>(schema->private_data);
+  schema->release = nullptr;
+}
+
+static void release_batch_schema(ArrowSchema *schema) {
+  auto data = static_cast<ArrowBatchSchema *>(schema->private_data);
+  for (ArrowSchema &child : data->children) {
+    if (child.release) {
+      child.release(&child);
+    }
+  }
+  delete data;
+  schema->release = nullptr;
+}
+
+static void release_schema_capsule(PyObject *capsule) {
+  auto schema = static_cast<ArrowSchema *>(
+      PyCapsule_GetPointer(capsule, "arrow_schema"));
+  if (schema) {
+    if (schema->release) {
+      schema->release(schema);
+    }
+    delete schema;
+  }
+}
+
+static void release_array_capsule(PyObject *capsule) {
+  auto array =
+      static_cast<ArrowArray *>(PyCapsule_GetPointer(capsule, "arrow_array"));
+  if (array) {
+    if (array->release) {
+      array->release(array);
+    }
+    delete array;
+  }
+}
+
+/**
+ * @brief Return the Arrow format of a column, if it is exported.
+ *
+ * @param ts The TypeSchema of the column's field.
+ * @return The format string, or nullptr for non-primitive columns.
+ */
+static const char *arrow_format(TypeSchema *ts) {
+  if (ts->op == OP_OPTIONAL) {
+    ts = ts->optional_target;
+  }
+  switch (ts->op) {
+  case OP_INT:
+    return "l";
+  case OP_FLOAT:
+    return "g";
+  case OP_STR:
+    return "u";
+  case OP_BOOL:
+    return "b";
+  default:
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Convert the values of one column into Arrow buffers.
+ *
+ * @param items The exported instances.
+ * @param count Number of instances.
+ * @param column The column.
+ * @param format Its Arrow format.
+ * @param out Receives the child array.
+ * @return 0 on success, -1 with an exception set on failure.
+ */
+static int fill_arrow_column(PyObject *const *items, Py_ssize_t count,
+                             const Column &column, const char *format,
+                             ArrowArray *out) {
+  auto data = new (std::nothrow) ArrowColumnArray();
+  if (!data) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  // The buffers must not be null, even for an empty column.
+  size_t bitmap_size = static_cast<size_t>(count + 7) / 8 + 1;
+  data->validity.assign(bitmap_size, 0);
+  char kind = format[0];
+  if (kind == 'b') {
+    data->values.assign(bitmap_size, 0);
+  } else if (kind == 'u') {
+    data->offsets.reserve(static_cast<size_t>(count) + 1);
+    data->offsets.push_back(0);
+  } else {
+    data->values.resize(static_cast<size_t>(count) * 8 + 8);
+  }
+
+  int64_t null_count = 0;
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject *value = column_value(items[i], column);
+    if (!value) {
+      delete data;
+      return -1;
+    }
+    if (value == Py_None) {
+      null_count++;
+      if (kind == 'u') {
+        data->offsets.push_back(data->offsets.back());
+      }
+      continue;
+    }
+    data->validity[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+    if (kind == 'l') {
+      int64_t number = PyLong_AsLongLong(value);
+      if (number == -1 && PyErr_Occurred()) {
+        delete data;
+        return -1;
+      }
+      memcpy(&data->values[i * 8], &number, sizeof(number));
+    } else if (kind == 'g') {
+      double number = PyFloat_AsDouble(value);
+      if (number == -1.0 && PyErr_Occurred()) {
+        delete data;
+        return -1;
+      }
+      memcpy(&data->values[i * 8], &number, sizeof(number));
+    } else if (kind == 'b') {
+      int truth = PyObject_IsTrue(value);
+      if (truth < 0) {
+        delete data;
+        return -1;
+      }
+      if (truth) {
+        data->values[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+      }
+    } else {
+      Py_ssize_t length = 0;
+      const char *text = PyUnicode_AsUTF8AndSize(value, &length);
+      if (!text) {
+        delete data;
+        return -1;
+      }
+      if (data->chars.size() + static_cast<size_t>(length) > INT32_MAX) {
+        PyErr_Format(PyExc_OverflowError,
+                     "Column '%s' holds more than 2 GiB of text",
+                     column.name.c_str());
+        delete data;
+        return -1;
+      }
+      data->chars.append(text, static_cast<size_t>(length));
+      data->offsets.push_back(static_cast<int32_t>(data->chars.size()));
+    }
+  }
+
+  data->buffers[0] = null_count ? data->validity.data() : nullptr;
+  if (kind == 'u') {
+    data->buffers[1] = data->offsets.data();
+    data->buffers[2] = data->chars.data();
+  } else {
+    data->buffers[1] = data->values.data();
+  }
+  out->length = count;
+  out->null_count = null_count;
+  out->offset = 0;
+  out->n_buffers = kind == 'u' ? 3 : 2;
+  out->n_children = 0;
+  out->buffers = data->buffers;
+  out->children = nullptr;
+  out->dictionary = nullptr;
+  out->release = release_column_array;
+  out->private_data = data;
+  return 0;
+}
+
+extern "C" {
+
+/**
+ * @brief Export a sequence of instances as a dict of columns.
+ */
+PyObject *columnar_to_columns(PyObject *cls, PyObject *instances) {
+  std::vector<Column> columns;
+  PyObject *items = prepare_export(cls, instances, &columns);
+  if (!items) {
+    return nullptr;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(items);
+  PyObject **item_array = PySequence_Fast_ITEMS(items);
+  PyObject *result = PyDict_New();
+  if (!result) {
+    Py_DECREF(items);
+    return nullptr;
+  }
+  for (const Column &column : columns) {
+    PyObject *dict_serializer = column.hops.back().schema->dict_serializer;
+    PyObject *values = PyList_New(count);
+    if (!values) {
+      Py_DECREF(result);
+      Py_DECREF(items);
+      return nullptr;
+    }
+    for (Py_ssize_t i = 0; i < count; i++) {
+      PyObject *value = column_value(item_array[i], column);
+      PyObject *converted =
+          value ? convert_to_dict(value, dict_serializer) : nullptr;
+      if (!converted) {
+        Py_DECREF(values);
+        Py_DECREF(result);
+        Py_DECREF(items);
+        return nullptr;
+      }
+      PyList_SET_ITEM(values, i, converted);
+    }
+    int status = PyDict_SetItemString(result, column.name.c_str(), values);
+    Py_DECREF(values);
+    if (status != 0) {
+      Py_DECREF(result);
+      Py_DECREF(items);
+      return nullptr;
+    }
+  }
+  Py_DECREF(items);
+  return result;
+}
+
+/**
+ * @brief Export the primitive columns of instances as Arrow C Data arrays.
+ */
+PyObject *columnar_to_arrow(PyObject *cls, PyObject *instances) {
+  std::vector<Column> planned;
+  PyObject *items = prepare_export(cls, instances, &planned);
+  if (!items) {
+    return nullptr;
+  }
+  std::vector<const Column *> columns;
+  std::vector<const char *> formats;
+  for (const Column &column : planned) {
+    if (const char *format = arrow_format(column.type_schema)) {
+      columns.push_back(&column);
+      formats.push_back(format);
+    }
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(items);
+  size_t num_columns = columns.size();
+
+  auto array = new (std::nothrow) ArrowArray();
+  auto array_data = new (std::nothrow) ArrowBatchArray();
+  auto schema = new (std::nothrow) ArrowSchema();
+  auto schema_data = new (std::nothrow) ArrowBatchSchema();
+  if (!array || !array_data || !schema || !schema_data) {
+    delete array;
+    delete array_data;
+    delete schema;
+    delete schema_data;
+    Py_DECREF(items);
+    return PyErr_NoMemory();
+  }
+  // Children start zeroed, so a partial export releases only those filled.
+  array_data->children.resize(num_columns);
+  schema_data->children.resize(num_columns);
+  for (size_t c = 0; c < num_columns; c++) {
+    array_data->child_pointers.push_back(&array_data->children[c]);
+    schema_data->child_pointers.push_back(&schema_data->children[c]);
+  }
+  array->length = count;
+  array->n_buffers = 1;
+  array->n_children = static_cast<int64_t>(num_columns);
+  array->buffers = array_data->buffers;
+  array->children = array_data->child_pointers.data();
+  array->release = release_batch_array;
+  array->private_data = array_data;
+  schema->format = "+s";
+  schema->name = "";
+  schema->n_children = static_cast<int64_t>(num_columns);
+  schema->children = schema_data->child_pointers.data();
+  schema->release = release_batch_schema;
+  schema->private_data = schema_data;
+
+  int status = 0;
+  for (size_t c = 0; c < num_columns && status == 0; c++) {
+    auto column_schema = new (std::nothrow) ArrowColumnSchema();
+    if (!column_schema) {
+      PyErr_NoMemory();
+      status = -1;
+      break;
+    }
+    column_schema->name = columns[c]->name;
+    ArrowSchema &child = schema_data->children[c];
+    child.format = formats[c];
+    child.name = column_schema->name.c_str();
+    child.flags = ARROW_FLAG_NULLABLE;
+    child.release = release_column_schema;
+    child.private_data = column_schema;
+    status = fill_arrow_column(PySequence_Fast_ITEMS(items), count,
+                               *columns[c], formats[c],
+                               &array_data->children[c]);
+  }
+  Py_DECREF(items);
+
+  PyObject *schema_capsule =
+      status == 0
+          ? PyCapsule_New(schema, "arrow_schema", release_schema_capsule)
+          : nullptr;
+  if (!schema_capsule) {
+    release_batch_schema(schema);
+    release_batch_array(array);
+    delete schema;
+    delete array;
+    return nullptr;
+  }
+  PyObject *array_capsule =
+      PyCapsule_New(array, "arrow_array", release_array_capsule);
+  if (!array_capsule) {
+    Py_DECREF(schema_capsule);
+    release_batch_array(array);
+    delete array;
+    return nullptr;
+  }
+  PyObject *result = PyTuple_Pack(2, schema_capsule, array_capsule);
+  Py_DECREF(schema_capsule);
+  Py_DECREF(array_capsule);
+  return result;
+}
+
+} // extern "C"
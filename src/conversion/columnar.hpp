@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Python.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Export a sequence of instances as a dict of columns.
+ *
+ * Each field becomes one list holding the to_dict() form of its value for
+ * every instance, in order. Fields holding a model (or an optional model)
+ * are flattened into one column per nested field, named with dotted paths
+ * such as "address.city"; a missing nested model gives None in each of its
+ * columns. A model nested in itself is not flattened again.
+ *
+ * @param cls The model class.
+ * @param instances A list or tuple of instances of cls.
+ * @return A new dict mapping column names to lists, or NULL on error.
+ */
+PyObject *columnar_to_columns(PyObject *cls, PyObject *instances);
+
+/**
+ * @brief Export the primitive columns of instances as Arrow C Data arrays.
+ *
+ * Columns are laid out as by columnar_to_columns, but only those of
+ * int, float, str and bool fields (or optional ones) are exported, as
+ * int64, float64, utf8 and boolean arrays with None as null. The columns
+ * are children of a struct array, returned as the ("arrow_schema",
+ * "arrow_array") capsule pair of the Arrow PyCapsule interface.
+ *
+ * @param cls The model class.
+ * @param instances A list or tuple of instances of cls.
+ * @return A new tuple of two capsules, or NULL on error.
+ */
+PyObject *columnar_to_arrow(PyObject *cls, PyObject *instances);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,22 +5,6 @@
 #include <stdlib.h>
 #include <string>
 
-extern PyObject *schema_key;
-extern PyObject *get_schema_cached(PyObject *cls);
-
-/**
- * @brief Convert a PyObject to its dictionary representation.
- *
- * This function attempts a custom conversion via dict_serializer first.
- * If no custom conversion applies, it dispatches conversion based on the type.
- *
- * @param value The PyObject to convert.
- * @param dict_serializer A dictionary mapping types to custom conversion
- * functions.
- * @return New reference to a PyObject representing the dictionary conversion,
- * or nullptr on error.
- */
-PyObject *convert_to_dict(PyObject *value, PyObject *dict_serializer);
 
 /**
  * @brief Checks if a PyObject is of a basic immutable type.
@@ -201,14 +185,10 @@ static PyObject *convert_set(PyObject *set_obj, PyObject *dict_serializer) {
  * @return New dictionary representing the DataModel, or nullptr on error.
  */
 static PyObject *convert_datamodel(PyObject *value) {
-  PyTypeObject *type_ptr = Py_TYPE(value);
-  PyObject *capsule = get_schema_cached((PyObject *)type_ptr);
-  if (!capsule) {
+  if (DataModel_validate_pending(value) < 0) {
     return nullptr;
   }
-  SchemaCache *schema =
-      (SchemaCache *)PyCapsule_GetPointer(capsule, "vldt.SchemaCache");
-  Py_DECREF(capsule);
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(value));
   if (!schema) {
     return nullptr;
   }
@@ -220,12 +200,11 @@ static PyObject *convert_datamodel(PyObject *value) {
   DataModelObject *bm = (DataModelObject *)value;
   for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
     FieldSchema *fs = &schema->fields[i];
-    std::string field_key(fs->field_name_c);
-    auto it = bm->instance_data->fields.find(field_key);
-    if (it == bm->instance_data->fields.end()) {
+    PyObject *field_value =
+        i < DataModel_num_slots(value) ? bm->slots[i] : nullptr;
+    if (!field_value) {
       continue;
     }
-    PyObject *field_value = it->second;
     PyObject *conv_value = convert_to_dict(field_value, dict_serializer);
     if (!conv_value) {
       Py_DECREF(result_dict);
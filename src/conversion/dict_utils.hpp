@@ -23,3 +23,18 @@ PyObject *dict_utils_to_dict(PyObject *self, PyObject *unused);
  * @return PyObject* The new DataModel instance, or nullptr on error.
  */
 PyObject *dict_utils_from_dict(PyObject *cls, PyObject *args);
+
+/**
+ * @brief Convert a value to the form it takes in to_dict output.
+ *
+ * Models become dicts and containers are converted element-wise; a
+ * serializer registered in dict_serializer for the value's type is applied
+ * first.
+ *
+ * @param value The value to convert.
+ * @param dict_serializer Dict mapping types to conversion functions, or
+ * NULL.
+ * @return PyObject* New reference to the converted value, or nullptr on
+ * error.
+ */
+PyObject *convert_to_dict(PyObject *value, PyObject *dict_serializer);
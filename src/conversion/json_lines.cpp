@@ -0,0 +1,560 @@
+#include "json_lines.hpp"
+#include "batch_utils.hpp"
+#include "error_handling.hpp"
+#include "json_parse.hpp"
+#include <Python.h>
+#include <cstring>
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <string>
+#include <vector>
+
+// Bytes requested from a file object per read call.
+static const Py_ssize_t kReadChunkSize = 1 << 20;
+// Size of the first block of the per-iterator parse arena.
+static const size_t kArenaChunkSize = 64 * 1024;
+
+/**
+ * @brief C++ state of a JSON-lines iterator.
+ *
+ * The document parses into a memory pool that is cleared before every line,
+ * so one arena is reused for the whole input.
+ */
+struct JsonLinesState {
+  std::vector<char> chunk; // Unconsumed input read from a file object.
+  rapidjson::MemoryPoolAllocator<> pool;
+  rapidjson::Document doc;
+
+  JsonLinesState() : pool(kArenaChunkSize), doc(&pool) {}
+};
+
+/**
+ * @brief JSON-lines iterator object.
+ *
+ * Input comes either from a buffer (data/size, scanned in place) or from a
+ * reader object whose chunks are accumulated in state->chunk.
+ */
+typedef struct {
+  PyObject_HEAD BatchContext ctx;
+  PyObject *cls;        // Strong reference keeping ctx.schema alive.
+  PyObject *reader;     // File object read in chunks, or nullptr.
+  PyObject *owned_file; // File opened for a path argument, or nullptr.
+  PyObject *mapping;    // Memory map of owned_file, or nullptr.
+  Py_buffer view;
+  int has_view;
+  Py_ssize_t pos;     // Offset of the next unread byte.
+  Py_ssize_t size;    // Number of valid input bytes.
+  Py_ssize_t line_no; // Number of the last line read (1-based).
+  int eof;
+  int skip_invalid;
+  PyObject *errors; // List of (line, message) tuples for skipped lines.
+  JsonLinesState *state;
+} JsonLinesIterObject;
+
+/**
+ * @brief Call close() on an object, ignoring failures.
+ *
+ * @param obj The object to close.
+ */
+static void close_quietly(PyObject *obj) {
+  PyObject *result = PyObject_CallMethod(obj, "close", nullptr);
+  if (!result) {
+    PyErr_Clear();
+  }
+  Py_XDECREF(result);
+}
+
+/**
+ * @brief Release the input source of the iterator.
+ *
+ * The buffer view is released before the memory map and the file it was
+ * created from are closed. Any pending exception is preserved.
+ *
+ * @param self The iterator.
+ */
+static void release_source(JsonLinesIterObject *self) {
+  PyObject *exc_type = nullptr, *exc_value = nullptr, *exc_tb = nullptr;
+  PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+  if (self->has_view) {
+    PyBuffer_Release(&self->view);
+    self->has_view = 0;
+  }
+  if (self->mapping) {
+    close_quietly(self->mapping);
+    Py_CLEAR(self->mapping);
+  }
+  if (self->owned_file) {
+    close_quietly(self->owned_file);
+    Py_CLEAR(self->owned_file);
+  }
+  Py_CLEAR(self->reader);
+  self->pos = self->size = 0;
+  self->eof = 1;
+  if (self->state) {
+    self->state->chunk.clear();
+    self->state->chunk.shrink_to_fit();
+  }
+  PyErr_Restore(exc_type, exc_value, exc_tb);
+}
+
+/**
+ * @brief Open a path argument, memory-mapping the file when possible.
+ *
+ * Files that cannot be mapped (empty files, pipes) are read in chunks.
+ *
+ * @param self The iterator.
+ * @param path The path (str or os.PathLike).
+ * @return 0 on success, -1 on failure.
+ */
+static int open_path(JsonLinesIterObject *self, PyObject *path) {
+  PyObject *io_module = PyImport_ImportModule("io");
+  if (!io_module) {
+    return -1;
+  }
+  self->owned_file = PyObject_CallMethod(io_module, "open", "Os", path, "rb");
+  Py_DECREF(io_module);
+  if (!self->owned_file) {
+    return -1;
+  }
+
+  PyObject *mmap_module = PyImport_ImportModule("mmap");
+  PyObject *fileno =
+      mmap_module ? PyObject_CallMethod(self->owned_file, "fileno", nullptr)
+                  : nullptr;
+  if (fileno) {
+    PyObject *mmap_type = PyObject_GetAttrString(mmap_module, "mmap");
+    PyObject *access = PyObject_GetAttrString(mmap_module, "ACCESS_READ");
+    PyObject *map_args = Py_BuildValue("(Oi)", fileno, 0);
+    PyObject *map_kwds =
+        access ? Py_BuildValue("{s:O}", "access", access) : nullptr;
+    if (mmap_type && map_args && map_kwds) {
+      self->mapping = PyObject_Call(mmap_type, map_args, map_kwds);
+    }
+    Py_XDECREF(map_kwds);
+    Py_XDECREF(map_args);
+    Py_XDECREF(access);
+    Py_XDECREF(mmap_type);
+    Py_DECREF(fileno);
+  }
+  Py_XDECREF(mmap_module);
+
+  if (self->mapping &&
+      PyObject_GetBuffer(self->mapping, &self->view, PyBUF_SIMPLE) == 0) {
+    self->has_view = 1;
+    self->size = self->view.len;
+    self->eof = 1;
+    return 0;
+  }
+  PyErr_Clear();
+  Py_CLEAR(self->mapping);
+  Py_INCREF(self->owned_file);
+  self->reader = self->owned_file;
+  return 0;
+}
+
+/**
+ * @brief Append the next chunk of the reader to the input buffer.
+ *
+ * Consumed bytes are dropped first, so the buffer only holds the current
+ * partial line plus one chunk.
+ *
+ * @param self The iterator.
+ * @return 0 on success, -1 on failure.
+ */
+static int read_chunk(JsonLinesIterObject *self) {
+  std::vector<char> &chunk = self->state->chunk;
+  chunk.erase(chunk.begin(), chunk.begin() + self->pos);
+  self->pos = 0;
+
+  PyObject *data = PyObject_CallMethod(self->reader, "read", "n",
+                                       kReadChunkSize);
+  if (!data) {
+    return -1;
+  }
+  const char *bytes = nullptr;
+  Py_ssize_t length = 0;
+  if (PyBytes_Check(data)) {
+    bytes = PyBytes_AS_STRING(data);
+    length = PyBytes_GET_SIZE(data);
+  } else if (PyByteArray_Check(data)) {
+    bytes = PyByteArray_AS_STRING(data);
+    length = PyByteArray_GET_SIZE(data);
+  } else if (PyUnicode_Check(data)) {
+    bytes = PyUnicode_AsUTF8AndSize(data, &length);
+  } else {
+    PyErr_Format(PyExc_TypeError, "read() returned %s, expected bytes or str",
+                 Py_TYPE(data)->tp_name);
+  }
+  if (!bytes) {
+    Py_DECREF(data);
+    return -1;
+  }
+  if (length == 0) {
+    self->eof = 1;
+  } else {
+    chunk.insert(chunk.end(), bytes, bytes + length);
+  }
+  self->size = static_cast<Py_ssize_t>(chunk.size());
+  Py_DECREF(data);
+  return 0;
+}
+
+/**
+ * @brief Find the next line of input.
+ *
+ * @param self The iterator.
+ * @param line Receives a pointer to the line (valid until the next call).
+ * @param length Receives the line length, excluding the newline.
+ * @return 1 if a line was found, 0 at end of input, -1 on error.
+ */
+static int next_line(JsonLinesIterObject *self, const char **line,
+                     Py_ssize_t *length) {
+  for (;;) {
+    const char *base = self->reader
+                           ? self->state->chunk.data()
+                           : static_cast<const char *>(self->view.buf);
+    Py_ssize_t avail = self->size - self->pos;
+    const char *start = base + self->pos;
+    const char *newline =
+        avail > 0 ? static_cast<const char *>(std::memchr(start, '\n', avail))
+                  : nullptr;
+    if (newline) {
+      *line = start;
+      *length = newline - start;
+      self->pos += *length + 1;
+      return 1;
+    }
+    if (self->eof) {
+      if (avail > 0) {
+        *line = start;
+        *length = avail;
+        self->pos = self->size;
+        return 1;
+      }
+      return 0;
+    }
+    if (read_chunk(self) != 0) {
+      return -1;
+    }
+  }
+}
+
+/**
+ * @brief Check whether a line holds only whitespace.
+ *
+ * @param line The line.
+ * @param length The line length.
+ * @return true if the line is blank.
+ */
+static bool is_blank(const char *line, Py_ssize_t length) {
+  for (Py_ssize_t i = 0; i < length; i++) {
+    char c = line[i];
+    if (c != ' ' && c != '\t' && c != '\r') {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Parse one line and build the model instance.
+ *
+ * @param self The iterator.
+ * @param line The line.
+ * @param length The line length.
+ * @param parse_failed Set to true if the line is not valid JSON.
+ * @return A new instance, or nullptr on error.
+ */
+static PyObject *parse_line(JsonLinesIterObject *self, const char *line,
+                            Py_ssize_t length, bool *parse_failed) {
+  JsonLinesState *state = self->state;
+  state->doc.SetNull();
+  state->pool.Clear();
+  parse_json_text(state->doc, line, static_cast<size_t>(length));
+  if (state->doc.HasParseError()) {
+    *parse_failed = true;
+    PyErr_Format(PyExc_ValueError,
+                 "rapidjson parse error: %s (at line %zd, offset %u)",
+                 rapidjson::GetParseError_En(state->doc.GetParseError()),
+                 self->line_no,
+                 static_cast<unsigned>(state->doc.GetErrorOffset()));
+    return nullptr;
+  }
+  return batch_build_from_native(self->ctx, state->doc);
+}
+
+/**
+ * @brief Handle the failure of the current line.
+ *
+ * Without skip_invalid, validation errors are re-raised as a TypeError keyed
+ * by line number and parse errors propagate unchanged. With skip_invalid,
+ * the error is appended to the errors list and cleared.
+ *
+ * @param self The iterator.
+ * @param parse_failed Whether the line failed to parse.
+ * @return 0 if iteration may continue, -1 if the error must propagate.
+ */
+static int handle_line_error(JsonLinesIterObject *self, bool parse_failed) {
+  if (!PyErr_ExceptionMatches(PyExc_TypeError) &&
+      !PyErr_ExceptionMatches(PyExc_ValueError)) {
+    return -1;
+  }
+  if (!self->skip_invalid) {
+    if (parse_failed) {
+      return -1;
+    }
+    ErrorCollector collector;
+    if (record_batch_error(&collector, self->line_no) != 0) {
+      return -1;
+    }
+    collector.raise();
+    return -1;
+  }
+
+  PyObject *exc_type = nullptr, *exc_value = nullptr, *exc_tb = nullptr;
+  PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+  PyObject *message = exc_value ? PyObject_Str(exc_value) : nullptr;
+  Py_XDECREF(exc_type);
+  Py_XDECREF(exc_value);
+  Py_XDECREF(exc_tb);
+  if (!message) {
+    return -1;
+  }
+  PyObject *entry = Py_BuildValue("(nN)", self->line_no, message);
+  if (!entry || PyList_Append(self->errors, entry) != 0) {
+    Py_XDECREF(entry);
+    return -1;
+  }
+  Py_DECREF(entry);
+  return 0;
+}
+
+/**
+ * @brief JsonLinesIterator.__next__ implementation.
+ *
+ * @param obj The iterator.
+ * @return The next model instance, or nullptr at the end or on error.
+ */
+static PyObject *JsonLinesIter_next(PyObject *obj) {
+  JsonLinesIterObject *self = reinterpret_cast<JsonLinesIterObject *>(obj);
+  if (!self->state) {
+    return nullptr;
+  }
+  for (;;) {
+    const char *line = nullptr;
+    Py_ssize_t length = 0;
+    int found = next_line(self, &line, &length);
+    if (found <= 0) {
+      release_source(self);
+      return nullptr;
+    }
+    self->line_no++;
+    if (is_blank(line, length)) {
+      continue;
+    }
+    bool parse_failed = false;
+    PyObject *instance = parse_line(self, line, length, &parse_failed);
+    if (instance) {
+      return instance;
+    }
+    if (handle_line_error(self, parse_failed) != 0) {
+      return nullptr;
+    }
+  }
+}
+
+/**
+ * @brief JsonLinesIterator.__dealloc__ implementation.
+ *
+ * @param obj The iterator.
+ */
+static void JsonLinesIter_dealloc(PyObject *obj) {
+  JsonLinesIterObject *self = reinterpret_cast<JsonLinesIterObject *>(obj);
+  release_source(self);
+  delete self->state;
+  Py_XDECREF(self->errors);
+  Py_XDECREF(self->cls);
+  Py_TYPE(obj)->tp_free(obj);
+}
+
+/**
+ * @brief JsonLinesIterator.close implementation.
+ *
+ * Releases the source early; the iterator is exhausted afterwards.
+ *
+ * @param obj The iterator.
+ * @return None.
+ */
+static PyObject *JsonLinesIter_close(PyObject *obj,
+                                     PyObject *Py_UNUSED(ignored)) {
+  release_source(reinterpret_cast<JsonLinesIterObject *>(obj));
+  Py_RETURN_NONE;
+}
+
+/**
+ * @brief Getter for the list of skipped lines.
+ *
+ * @param obj The iterator.
+ * @param closure Unused.
+ * @return New reference to the errors list.
+ */
+static PyObject *JsonLinesIter_get_errors(PyObject *obj, void *closure) {
+  PyObject *errors = reinterpret_cast<JsonLinesIterObject *>(obj)->errors;
+  Py_INCREF(errors);
+  return errors;
+}
+
+/**
+ * @brief Getter for the number of the last line read.
+ *
+ * @param obj The iterator.
+ * @param closure Unused.
+ * @return The line number as an int.
+ */
+static PyObject *JsonLinesIter_get_line(PyObject *obj, void *closure) {
+  return PyLong_FromSsize_t(
+      reinterpret_cast<JsonLinesIterObject *>(obj)->line_no);
+}
+
+static PyMethodDef JsonLinesIter_methods[] = {
+    {"close", (PyCFunction)JsonLinesIter_close, METH_NOARGS,
+     "Release the underlying source."},
+    {nullptr, nullptr, 0, nullptr}};
+
+static PyGetSetDef JsonLinesIter_getset[] = {
+    {"errors", JsonLinesIter_get_errors, nullptr,
+     "List of (line, message) tuples for skipped lines.", nullptr},
+    {"line", JsonLinesIter_get_line, nullptr, "Number of the last line read.",
+     nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+PyTypeObject JsonLinesIterType = {
+    .ob_base = {.ob_base = {.ob_refcnt = 1, .ob_type = &PyType_Type},
+                .ob_size = 0},
+    .tp_name = "vldt._vldt.JsonLinesIterator",
+    .tp_basicsize = sizeof(JsonLinesIterObject),
+    .tp_itemsize = 0,
+    .tp_dealloc = JsonLinesIter_dealloc,
+    .tp_vectorcall_offset = 0,
+    .tp_getattr = nullptr,
+    .tp_setattr = nullptr,
+    .tp_as_async = nullptr,
+    .tp_repr = nullptr,
+    .tp_as_number = nullptr,
+    .tp_as_sequence = nullptr,
+    .tp_as_mapping = nullptr,
+    .tp_hash = nullptr,
+    .tp_call = nullptr,
+    .tp_str = nullptr,
+    .tp_getattro = nullptr,
+    .tp_setattro = nullptr,
+    .tp_as_buffer = nullptr,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Iterator over the models of a JSON-lines source",
+    .tp_traverse = nullptr,
+    .tp_clear = nullptr,
+    .tp_richcompare = nullptr,
+    .tp_weaklistoffset = 0,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = JsonLinesIter_next,
+    .tp_methods = JsonLinesIter_methods,
+    .tp_members = nullptr,
+    .tp_getset = JsonLinesIter_getset,
+    .tp_base = nullptr,
+    .tp_dict = nullptr,
+    .tp_descr_get = nullptr,
+    .tp_descr_set = nullptr,
+    .tp_dictoffset = 0,
+    .tp_init = nullptr,
+    .tp_alloc = nullptr,
+    .tp_new = nullptr,
+    .tp_free = nullptr,
+    .tp_is_gc = nullptr,
+    .tp_bases = nullptr,
+    .tp_mro = nullptr,
+    .tp_cache = nullptr,
+    .tp_subclasses = nullptr,
+    .tp_weaklist = nullptr,
+    .tp_del = nullptr,
+    .tp_version_tag = 0,
+    .tp_finalize = nullptr};
+
+static const char *json_lines_kwlist[] = {"source", "skip_invalid", nullptr};
+
+extern "C" {
+
+/**
+ * @brief Iterate over the models stored in a JSON-lines source.
+ */
+PyObject *json_lines_iter(PyObject *cls, PyObject *args, PyObject *kwds) {
+  PyObject *source = nullptr;
+  int skip_invalid = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|$p:iter_json_lines",
+                                   const_cast<char **>(json_lines_kwlist),
+                                   &source, &skip_invalid)) {
+    return nullptr;
+  }
+
+  JsonLinesIterObject *self =
+      PyObject_New(JsonLinesIterObject, &JsonLinesIterType);
+  if (!self) {
+    return nullptr;
+  }
+  self->cls = nullptr;
+  self->reader = nullptr;
+  self->owned_file = nullptr;
+  self->mapping = nullptr;
+  self->has_view = 0;
+  self->pos = 0;
+  self->size = 0;
+  self->line_no = 0;
+  self->eof = 0;
+  self->skip_invalid = skip_invalid;
+  self->errors = nullptr;
+  self->state = nullptr;
+  PyObject *result = reinterpret_cast<PyObject *>(self);
+
+  if (init_batch_context(cls, &self->ctx) != 0) {
+    Py_DECREF(result);
+    return nullptr;
+  }
+  Py_INCREF(cls);
+  self->cls = cls;
+  self->errors = PyList_New(0);
+  self->state = new (std::nothrow) JsonLinesState();
+  if (!self->errors || !self->state) {
+    if (!PyErr_Occurred()) {
+      PyErr_NoMemory();
+    }
+    Py_DECREF(result);
+    return nullptr;
+  }
+
+  int status = 0;
+  if (PyUnicode_Check(source) ||
+      (!PyBytes_Check(source) &&
+       PyObject_HasAttrString(source, "__fspath__"))) {
+    status = open_path(self, source);
+  } else if (PyObject_CheckBuffer(source)) {
+    status = PyObject_GetBuffer(source, &self->view, PyBUF_SIMPLE);
+    if (status == 0) {
+      self->has_view = 1;
+      self->size = self->view.len;
+      self->eof = 1;
+    }
+  } else if (PyObject_HasAttrString(source, "read")) {
+    Py_INCREF(source);
+    self->reader = source;
+  } else {
+    PyErr_SetString(PyExc_TypeError,
+                    "source must be a path, a file object or a buffer");
+    status = -1;
+  }
+  if (status != 0) {
+    Py_DECREF(result);
+    return nullptr;
+  }
+  return result;
+}
+
+} // extern "C"
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Python.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Iterate over the models stored in a JSON-lines source.
+ *
+ * Accepts a path (str or os.PathLike), a binary or text file object, or any
+ * object supporting the buffer protocol, plus an optional keyword-only
+ * skip_invalid flag (default False). Paths are memory-mapped when possible
+ * and read in large chunks otherwise; file objects are read in chunks and
+ * buffers are scanned in place. Each line is parsed into one reused arena, so
+ * memory use does not grow with the input size.
+ *
+ * Invalid lines raise by default: validation failures as a TypeError keyed by
+ * line number, parse errors as a ValueError. With skip_invalid they are
+ * skipped and recorded as (line, message) tuples in the iterator's errors
+ * list.
+ *
+ * @param cls The Python type object for the DataModel.
+ * @param args Positional arguments (the source).
+ * @param kwds Keyword arguments (skip_invalid).
+ * @return A new iterator yielding model instances, or NULL on error.
+ */
+PyObject *json_lines_iter(PyObject *cls, PyObject *args, PyObject *kwds);
+
+/**
+ * The type of the iterator returned by json_lines_iter.
+ */
+extern PyTypeObject JsonLinesIterType;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,248 @@
+#include "json_parse.hpp"
+#include <string.h>
+#include <system_error>
+#include <thread>
+
+/**
+ * @brief Location of one array element in the JSON text.
+ */
+struct JsonSpan {
+  size_t offset;
+  size_t length;
+};
+
+/**
+ * @brief rapidjson input stream returning NUL bytes as a control character.
+ *
+ * Only the real end of the text reads as NUL, so rapidjson fails at a NUL
+ * byte (as an unexpected character, or an invalid one within a string)
+ * instead of taking it for the end of the input.
+ */
+class NulRejectingStream {
+public:
+  typedef char Ch;
+
+  NulRejectingStream(const char *json, size_t length)
+      : begin_(json), pos_(json), end_(json + length) {}
+
+  Ch Peek() const { return pos_ == end_ ? '\0' : *pos_ ? *pos_ : '\x01'; }
+  Ch Take() {
+    Ch c = Peek();
+    if (pos_ != end_) {
+      pos_++;
+    }
+    return c;
+  }
+  size_t Tell() const { return static_cast<size_t>(pos_ - begin_); }
+
+  // Output is only used by in-situ parsing.
+  Ch *PutBegin() { return nullptr; }
+  void Put(Ch) {}
+  void Flush() {}
+  size_t PutEnd(Ch *) { return 0; }
+
+private:
+  const char *begin_;
+  const char *pos_;
+  const char *end_;
+};
+
+/**
+ * @brief Return the position of the first non-whitespace byte.
+ *
+ * @param json The JSON text.
+ * @param length Length of the text.
+ * @param pos Position to start from.
+ * @return The position, or length if only whitespace remains.
+ */
+static size_t skip_whitespace(const char *json, size_t length, size_t pos) {
+  while (pos < length && (json[pos] == ' ' || json[pos] == '\n' ||
+                          json[pos] == '\r' || json[pos] == '\t')) {
+    pos++;
+  }
+  return pos;
+}
+
+/**
+ * @brief Find the elements of a top-level JSON array.
+ *
+ * Only strings and bracket depth are tracked, which is enough to find the
+ * top-level commas; the elements themselves are checked when each is
+ * parsed, so an array whose elements all parse is well-formed.
+ *
+ * @param json The JSON text.
+ * @param length Length of the text.
+ * @param spans Receives the element locations.
+ * @return true if the text looks like a single array, false otherwise.
+ */
+static bool split_json_array(const char *json, size_t length,
+                             std::vector<JsonSpan> *spans) {
+  size_t pos = skip_whitespace(json, length, 0);
+  if (pos == length || json[pos] != '[') {
+    return false;
+  }
+  pos = skip_whitespace(json, length, pos + 1);
+  if (pos < length && json[pos] == ']') {
+    return skip_whitespace(json, length, pos + 1) == length;
+  }
+  size_t start = pos;
+  size_t depth = 0;
+  while (pos < length) {
+    char c = json[pos];
+    if (c == '"') {
+      pos++;
+      while (pos < length && json[pos] != '"') {
+        pos += json[pos] == '\\' ? 2 : 1;
+      }
+      if (pos >= length) {
+        return false;
+      }
+    } else if (c == '{' || c == '[') {
+      depth++;
+    } else if (c == '}' || (c == ']' && depth > 0)) {
+      if (depth == 0) {
+        return false;
+      }
+      depth--;
+    } else if (depth == 0 && (c == ',' || c == ']')) {
+      spans->push_back({start, pos - start});
+      if (c == ']') {
+        return skip_whitespace(json, length, pos + 1) == length;
+      }
+      start = pos + 1;
+    }
+    pos++;
+  }
+  return false;
+}
+
+/**
+ * @brief Parse a run of array elements into an array document.
+ *
+ * @param json The JSON text.
+ * @param spans The elements to parse.
+ * @param count Number of elements.
+ * @param arena The document receiving the elements.
+ * @return true on success, false if an element does not parse.
+ */
+static bool parse_spans(const char *json, const JsonSpan *spans, size_t count,
+                        rapidjson::Document *arena) {
+  rapidjson::Document::AllocatorType &allocator = arena->GetAllocator();
+  arena->SetArray();
+  arena->Reserve(static_cast<rapidjson::SizeType>(count), allocator);
+  rapidjson::Document element(&allocator);
+  for (size_t i = 0; i < count; i++) {
+    parse_json_text(element, json + spans[i].offset, spans[i].length);
+    if (element.HasParseError()) {
+      return false;
+    }
+    arena->PushBack(element.Move(), allocator);
+  }
+  return true;
+}
+
+/**
+ * @brief Parse JSON text of a known length into a document.
+ */
+void parse_json_text(rapidjson::Document &doc, const char *json,
+                     size_t length) {
+  // Scanning for a NUL costs far less than parsing, so text without one
+  // keeps rapidjson's own stream.
+  if (!memchr(json, '\0', length)) {
+    doc.Parse(json, length);
+    return;
+  }
+  NulRejectingStream stream(json, length);
+  doc.ParseStream(stream);
+}
+
+/**
+ * @brief Parse JSON text into a document, releasing the GIL when it is large.
+ */
+void parse_json_document(rapidjson::Document &doc, const char *json,
+                         size_t length) {
+  if (length < kReleaseGilBytes) {
+    parse_json_text(doc, json, length);
+    return;
+  }
+  PyThreadState *thread_state = PyEval_SaveThread();
+  parse_json_text(doc, json, length);
+  PyEval_RestoreThread(thread_state);
+}
+
+/**
+ * @brief Parse the elements of a JSON array across worker threads.
+ */
+bool parse_json_array_parallel(const char *json, size_t length,
+                               Py_ssize_t workers, ParsedJsonArray *out) {
+  if (workers == 0) {
+    workers = static_cast<Py_ssize_t>(std::thread::hardware_concurrency());
+  }
+  Py_ssize_t size_limit =
+      static_cast<Py_ssize_t>(length / kParallelParseMinBytes);
+  if (workers > size_limit) {
+    workers = size_limit;
+  }
+  if (workers < 2) {
+    return false;
+  }
+
+  std::vector<JsonSpan> spans;
+  std::vector<size_t> bounds;
+  std::unique_ptr<unsigned char[]> parsed;
+  PyThreadState *thread_state = PyEval_SaveThread();
+  bool ok = split_json_array(json, length, &spans) && !spans.empty();
+  if (ok) {
+    // Cut the elements into runs of about the same amount of text.
+    if (static_cast<size_t>(workers) > spans.size()) {
+      workers = static_cast<Py_ssize_t>(spans.size());
+    }
+    size_t target = length / static_cast<size_t>(workers);
+    size_t consumed = 0;
+    bounds.push_back(0);
+    for (size_t i = 0; i < spans.size(); i++) {
+      consumed += spans[i].length + 1;
+      if (consumed >= target * bounds.size() && i + 1 < spans.size() &&
+          bounds.size() < static_cast<size_t>(workers)) {
+        bounds.push_back(i + 1);
+      }
+    }
+    bounds.push_back(spans.size());
+    workers = static_cast<Py_ssize_t>(bounds.size() - 1);
+    out->arenas.reset(new rapidjson::Document[workers]);
+    parsed.reset(new unsigned char[workers]);
+
+    auto run = [&](Py_ssize_t w) {
+      parsed[w] = parse_spans(json, spans.data() + bounds[w],
+                              bounds[w + 1] - bounds[w], &out->arenas[w]);
+    };
+    std::vector<std::thread> threads;
+    for (Py_ssize_t w = 1; w < workers; w++) {
+      try {
+        threads.emplace_back(run, w);
+      } catch (const std::system_error &) {
+        run(w);
+      }
+    }
+    run(0);
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    for (Py_ssize_t w = 0; w < workers; w++) {
+      ok = ok && parsed[w];
+    }
+  }
+  PyEval_RestoreThread(thread_state);
+
+  if (!ok) {
+    out->arenas.reset();
+    return false;
+  }
+  out->items.reserve(spans.size());
+  for (Py_ssize_t w = 0; w < workers; w++) {
+    for (const rapidjson::Value &item : out->arenas[w].GetArray()) {
+      out->items.push_back(&item);
+    }
+  }
+  return true;
+}
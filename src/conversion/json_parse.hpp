@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Python.h>
+#include <memory>
+#include <rapidjson/document.h>
+#include <vector>
+
+// Documents at least this large are parsed with the GIL released.
+constexpr size_t kReleaseGilBytes = 16 * 1024;
+
+// Least amount of text given to each worker of a parallel parse.
+constexpr size_t kParallelParseMinBytes = 64 * 1024;
+
+/**
+ * @brief Parse JSON text of a known length into a document.
+ *
+ * rapidjson reads a NUL byte as the end of the input, which would drop the
+ * rest of the text unnoticed. Text containing one is parsed so that the NUL
+ * is rejected like any other control character, failing at its offset.
+ *
+ * @param doc The document to parse into.
+ * @param json JSON text (not necessarily NUL-terminated).
+ * @param length Length of the JSON text in bytes.
+ */
+void parse_json_text(rapidjson::Document &doc, const char *json,
+                     size_t length);
+
+/**
+ * @brief Parse JSON text into a document, releasing the GIL when it is large.
+ *
+ * Documents of at least kReleaseGilBytes are parsed with the GIL released
+ * so other threads can run meanwhile. The caller must keep the text alive
+ * and unresizable for the call: str and bytes objects are immutable, other
+ * bytes-like objects must be held through a buffer export.
+ *
+ * @param doc The document to parse into.
+ * @param json JSON text (not necessarily NUL-terminated).
+ * @param length Length of the JSON text in bytes.
+ */
+void parse_json_document(rapidjson::Document &doc, const char *json,
+                         size_t length);
+
+/**
+ * @brief Elements of a JSON array parsed by several worker threads.
+ */
+struct ParsedJsonArray {
+  std::unique_ptr<rapidjson::Document[]> arenas; // One array per worker.
+  std::vector<const rapidjson::Value *> items;   // Elements in input order.
+};
+
+/**
+ * @brief Parse the elements of a JSON array across worker threads.
+ *
+ * The text is split at the top-level commas of the array and each worker
+ * parses a contiguous run of elements into its own document, all with the
+ * GIL released. Only the parse runs in parallel: building and validating
+ * the instances needs the GIL and is left to the caller. The number of
+ * workers is capped so each gets at least kParallelParseMinBytes of text.
+ *
+ * @param json JSON text, kept alive as for parse_json_document.
+ * @param length Length of the JSON text in bytes.
+ * @param workers The requested number of workers, or 0 for one per core.
+ * @param out Receives the parsed elements.
+ * @return true if the array was parsed; false (with no exception set) if a
+ * single worker would do or the text is not a well-formed array, in which
+ * case the caller parses it with parse_json_document to get the error.
+ */
+bool parse_json_array_parallel(const char *json, size_t length,
+                               Py_ssize_t workers, ParsedJsonArray *out);
@@ -1,70 +1,332 @@
 #include "json_utils.hpp"
+#include "conversion/json_parse.hpp"
 #include "conversion/rapidjson_to_pyobject.hpp"
 #include "data_model.hpp"
 #include "init_globals.hpp"
 #include "schema/schema.hpp"
+#include "validation_builtins.hpp"
 #include <Python.h>
 #include <atomic>
 #include <chrono>
-#include <cstring>
 #include <iostream>
+#include <memory>
+#include <new>
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
+#include <string.h>
 #include <unordered_map>
-#include <vector>
 
-// Forward declaration.
-static bool
-write_json_value(PyObject *value, PyObject *json_serializer,
-                 rapidjson::Writer<rapidjson::StringBuffer> &writer);
+/**
+ * @brief Destination of the chunks written by to_json_into.
+ *
+ * An int is a file descriptor, written through os.write so the GIL is
+ * released while writing. A bytearray is appended to. An object with a
+ * write method, or a callable, is called with each chunk as bytes; a
+ * smaller byte count returned by it is taken as a partial write. Any other
+ * writable buffer is filled from its start.
+ */
+class JsonChunkSink {
+public:
+  JsonChunkSink() = default;
+  JsonChunkSink(const JsonChunkSink &) = delete;
+  JsonChunkSink &operator=(const JsonChunkSink &) = delete;
+
+  ~JsonChunkSink() {
+    if (has_view_) {
+      PyBuffer_Release(&view_);
+    }
+    Py_XDECREF(target_);
+  }
+
+  /**
+   * @brief Resolve how to write to a target object.
+   *
+   * @param target The file descriptor, writer or buffer.
+   * @return 0 on success, -1 with TypeError set if the target is not usable.
+   */
+  int open(PyObject *target) {
+    if (PyLong_Check(target) && !PyBool_Check(target)) {
+      fd_ = PyObject_AsFileDescriptor(target);
+      if (fd_ < 0) {
+        return -1;
+      }
+      PyObject *os_module = PyImport_ImportModule("os");
+      if (!os_module) {
+        return -1;
+      }
+      target_ = PyObject_GetAttrString(os_module, "write");
+      Py_DECREF(os_module);
+      kind_ = SINK_FD;
+      return target_ ? 0 : -1;
+    }
+    if (PyByteArray_Check(target)) {
+      kind_ = SINK_BYTEARRAY;
+      target_ = Py_NewRef(target);
+      return 0;
+    }
+    target_ = PyObject_GetAttrString(target, "write");
+    if (target_ || !PyErr_ExceptionMatches(PyExc_AttributeError)) {
+      kind_ = SINK_CALL;
+      return target_ ? 0 : -1;
+    }
+    PyErr_Clear();
+    if (PyCallable_Check(target)) {
+      kind_ = SINK_CALL;
+      target_ = Py_NewRef(target);
+      return 0;
+    }
+    if (PyObject_CheckBuffer(target) &&
+        PyObject_GetBuffer(target, &view_, PyBUF_WRITABLE) == 0) {
+      kind_ = SINK_BUFFER;
+      has_view_ = true;
+      return 0;
+    }
+    PyErr_Clear();
+    PyErr_SetString(PyExc_TypeError,
+                    "Output must be a file descriptor, a writable buffer, or "
+                    "an object with a write method or a callable");
+    return -1;
+  }
+
+  /**
+   * @brief Write one chunk.
+   *
+   * @param data The chunk.
+   * @param length Length of the chunk in bytes.
+   * @return true on success, false with an exception set.
+   */
+  bool write(const char *data, size_t length) {
+    if (kind_ == SINK_BYTEARRAY) {
+      Py_ssize_t size = PyByteArray_GET_SIZE(target_);
+      if (PyByteArray_Resize(target_,
+                             size + static_cast<Py_ssize_t>(length)) < 0) {
+        return false;
+      }
+      memcpy(PyByteArray_AS_STRING(target_) + size, data, length);
+      written_ += static_cast<Py_ssize_t>(length);
+      return true;
+    }
+    if (kind_ == SINK_BUFFER) {
+      if (static_cast<size_t>(view_.len - written_) < length) {
+        PyErr_SetString(PyExc_ValueError, "Output buffer is too small");
+        return false;
+      }
+      memcpy(static_cast<char *>(view_.buf) + written_, data, length);
+      written_ += static_cast<Py_ssize_t>(length);
+      return true;
+    }
+    while (length > 0) {
+      PyObject *chunk =
+          PyBytes_FromStringAndSize(data, static_cast<Py_ssize_t>(length));
+      if (!chunk) {
+        return false;
+      }
+      PyObject *result = kind_ == SINK_FD
+                             ? PyObject_CallFunction(target_, "iO", fd_, chunk)
+                             : PyObject_CallOneArg(target_, chunk);
+      Py_DECREF(chunk);
+      if (!result) {
+        return false;
+      }
+      size_t done = length;
+      if (PyLong_Check(result)) {
+        Py_ssize_t count = PyLong_AsSsize_t(result);
+        if (count == 0) {
+          Py_DECREF(result);
+          PyErr_SetString(PyExc_OSError, "Output accepted no data");
+          return false;
+        }
+        if (count > 0 && static_cast<size_t>(count) < length) {
+          done = static_cast<size_t>(count);
+        }
+        PyErr_Clear();
+      }
+      Py_DECREF(result);
+      data += done;
+      length -= done;
+      written_ += static_cast<Py_ssize_t>(done);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Return the number of bytes written so far.
+   */
+  Py_ssize_t written() const { return written_; }
 
-// Global declarations.
-extern PyObject *schema_key;
-extern PyObject *get_schema_cached(PyObject *cls);
+private:
+  enum Kind { SINK_FD, SINK_BYTEARRAY, SINK_CALL, SINK_BUFFER };
+  Kind kind_ = SINK_CALL;
+  int fd_ = -1;
+  PyObject *target_ = nullptr; // The bytearray, or the function to call.
+  Py_buffer view_;
+  bool has_view_ = false;
+  Py_ssize_t written_ = 0;
+};
 
 /**
- * @brief Retrieve the cached schema from the type dictionary.
+ * @brief rapidjson output stream handing fixed-size chunks to a sink.
+ *
+ * Once the sink fails the stream drops further output, leaving the error
+ * set for the caller; write_json_value stops at its next value. The chunk
+ * buffer is allocated without throwing; callers check allocated() first.
  */
-static PyObject *get_cached_schema(PyTypeObject *type_ptr) {
-  PyObject *type_dict = type_ptr->tp_dict;
-  PyObject *capsule = nullptr;
-  if (type_dict && PyDict_Check(type_dict)) {
-    capsule = PyDict_GetItem(type_dict, schema_key);
-    if (capsule) {
-      Py_INCREF(capsule);
+class ChunkedJsonStream {
+public:
+  typedef char Ch;
+
+  ChunkedJsonStream(JsonChunkSink &sink, size_t chunk_size)
+      : sink_(sink), buffer_(new (std::nothrow) char[chunk_size]),
+        capacity_(chunk_size) {}
+  ChunkedJsonStream(const ChunkedJsonStream &) = delete;
+  ChunkedJsonStream &operator=(const ChunkedJsonStream &) = delete;
+
+  void Put(char c) {
+    if (size_ == capacity_) {
+      Flush();
     }
+    buffer_[size_++] = c;
   }
-  if (!capsule) {
-    capsule = get_schema_cached(reinterpret_cast<PyObject *>(type_ptr));
-    if (capsule && type_dict && PyDict_Check(type_dict)) {
-      PyDict_SetItem(type_dict, schema_key, capsule);
+
+  // Also called by the writer once the root value is complete.
+  void Flush() {
+    if (size_ > 0 && !failed_) {
+      failed_ = !sink_.write(buffer_.get(), size_);
     }
+    size_ = 0;
   }
-  return capsule;
+
+  bool failed() const { return failed_; }
+
+  /**
+   * @brief Return whether the chunk buffer could be allocated.
+   */
+  bool allocated() const { return buffer_ != nullptr; }
+
+private:
+  JsonChunkSink &sink_;
+  std::unique_ptr<char[]> buffer_;
+  size_t capacity_;
+  size_t size_ = 0;
+  bool failed_ = false;
+};
+
+/**
+ * @brief rapidjson writer over a ChunkedJsonStream.
+ */
+class ChunkedJsonWriter : public rapidjson::Writer<ChunkedJsonStream> {
+public:
+  explicit ChunkedJsonWriter(ChunkedJsonStream &stream)
+      : rapidjson::Writer<ChunkedJsonStream>(stream), stream_(stream) {}
+
+  bool failed() const { return stream_.failed(); }
+
+private:
+  ChunkedJsonStream &stream_;
+};
+
+/**
+ * @brief Check whether a writer can still take output.
+ *
+ * @return true unless the output stream has failed.
+ */
+static inline bool
+json_output_ok(rapidjson::Writer<rapidjson::StringBuffer> &) {
+  return true;
+}
+
+static inline bool json_output_ok(ChunkedJsonWriter &writer) {
+  return !writer.failed();
+}
+
+// Forward declaration.
+template <typename Writer>
+static bool write_json_value(PyObject *value, PyObject *json_serializer,
+                             Writer &writer);
+
+/**
+ * @brief Write a str object as a JSON string or object key.
+ *
+ * Compact ASCII strings are copied straight from their storage using the
+ * known length; other strings go through their cached UTF-8 form.
+ *
+ * @param str The str object.
+ * @param writer The rapidjson writer.
+ * @param is_key Whether to write an object key instead of a value.
+ * @return true on success, false on error.
+ */
+template <typename Writer>
+static inline bool write_json_string(PyObject *str, Writer &writer,
+                                     bool is_key) {
+  const char *data = nullptr;
+  Py_ssize_t length = 0;
+  if (PyUnicode_IS_COMPACT_ASCII(str)) {
+    data = static_cast<const char *>(PyUnicode_DATA(str));
+    length = PyUnicode_GET_LENGTH(str);
+  } else {
+    data = PyUnicode_AsUTF8AndSize(str, &length);
+    if (!data) {
+      return false;
+    }
+  }
+  auto size = static_cast<rapidjson::SizeType>(length);
+  if (is_key) {
+    writer.Key(data, size);
+  } else {
+    writer.String(data, size);
+  }
+  return true;
 }
 
 /**
  * @brief Recursively write a Python object as JSON using rapidjson.
  *
- * Applies custom conversion from json_serializer when appropriate.
+ * Applies custom conversion from json_serializer when appropriate. Stops at
+ * the first value written after the output stream has failed.
  */
-static bool
-write_json_value(PyObject *value, PyObject *json_serializer,
-                 rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+template <typename Writer>
+static bool write_json_value(PyObject *value, PyObject *json_serializer,
+                             Writer &writer) {
+  if (!json_output_ok(writer)) {
+    return false;
+  }
   if (PyObject_TypeCheck(value, &DataModelType)) {
+    if (DataModel_validate_pending(value) < 0) {
+      return false;
+    }
     auto bm = reinterpret_cast<DataModelObject *>(value);
+    SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(value));
+    if (!schema) {
+      return false;
+    }
     writer.StartObject();
-    for (auto &pair : bm->instance_data->fields) {
-      const std::string &field_name = pair.first;
-      PyObject *field_value = pair.second;
-      writer.Key(field_name.c_str(),
-                 static_cast<rapidjson::SizeType>(field_name.size()));
+    Py_ssize_t num_slots = DataModel_num_slots(value) < schema->num_fields
+                               ? DataModel_num_slots(value)
+                               : schema->num_fields;
+    for (Py_ssize_t i = 0; i < num_slots; i++) {
+      PyObject *field_value = bm->slots[i];
+      if (!field_value) {
+        continue;
+      }
+      if (!write_json_string(schema->fields[i].field_name, writer, true)) {
+        return false;
+      }
       if (!write_json_value(field_value, json_serializer, writer)) {
         return false;
       }
     }
+    if (bm->instance_data) {
+      for (auto &pair : bm->instance_data->fields) {
+        const std::string &field_name = pair.first;
+        writer.Key(field_name.c_str(),
+                   static_cast<rapidjson::SizeType>(field_name.size()));
+        if (!write_json_value(pair.second, json_serializer, writer)) {
+          return false;
+        }
+      }
+    }
     writer.EndObject();
     return true;
   } else if (PyList_Check(value)) {
@@ -84,18 +346,20 @@ write_json_value(PyObject *value, PyObject *json_serializer,
     PyObject *val = nullptr;
     Py_ssize_t pos = 0;
     while (PyDict_Next(value, &pos, &key, &val)) {
-      const char *key_str = nullptr;
+      bool key_written;
       if (PyUnicode_Check(key)) {
-        key_str = PyUnicode_AsUTF8(key);
+        key_written = write_json_string(key, writer, true);
       } else {
         PyObject *key_repr = PyObject_Str(key);
         if (!key_repr) {
           return false;
         }
-        key_str = PyUnicode_AsUTF8(key_repr);
+        key_written = write_json_string(key_repr, writer, true);
         Py_DECREF(key_repr);
       }
-      writer.Key(key_str);
+      if (!key_written) {
+        return false;
+      }
       if (!write_json_value(val, json_serializer, writer)) {
         return false;
       }
@@ -128,21 +392,38 @@ write_json_value(PyObject *value, PyObject *json_serializer,
       writer.Double(d);
       return true;
     } else if (PyUnicode_Check(value)) {
-      const char *s = PyUnicode_AsUTF8(value);
-      writer.String(s);
-      return true;
+      return write_json_string(value, writer, false);
     } else if (value == Py_None) {
       writer.Null();
       return true;
+    } else if (PyObject_TypeCheck(value, (PyTypeObject *)EnumType)) {
+      // Members are written as their values, which validate back to them.
+      static PyObject *value_name = PyUnicode_InternFromString("_value_");
+      PyObject *member_value =
+          value_name ? PyObject_GetAttr(value, value_name) : nullptr;
+      if (!member_value) {
+        return false;
+      }
+      bool success = write_json_value(member_value, json_serializer, writer);
+      Py_DECREF(member_value);
+      return success;
     } else {
+      char text[40];
+      Py_ssize_t length = format_builtin_value(value, text);
+      if (length < 0) {
+        return false;
+      }
+      if (length > 0) {
+        writer.String(text, static_cast<rapidjson::SizeType>(length));
+        return true;
+      }
       PyObject *str_obj = PyObject_Str(value);
       if (!str_obj) {
         return false;
       }
-      const char *s = PyUnicode_AsUTF8(str_obj);
-      writer.String(s);
+      bool success = write_json_string(str_obj, writer, false);
       Py_DECREF(str_obj);
-      return true;
+      return success;
     }
   }
 }
@@ -150,24 +431,30 @@ write_json_value(PyObject *value, PyObject *json_serializer,
 /**
  * @brief Create a DataModel instance from a JSON string.
  *
- * Parses the JSON string into a Python dictionary and then calls the class's
- * constructor directly using the dictionary as keyword arguments.
+ * Parses the JSON string and builds the instance straight from the rapidjson
+ * DOM via DataModel_init_from_native. Classes that override __new__ or
+ * __init__ in Python are instead called with the converted dictionary as
+ * keyword arguments.
+ *
+ * The input is parsed without modification, so it is read in a single pass
+ * and never copied. The document is shared with the instances of lazy models,
+ * which validate their fields from it on access.
  *
  * @param cls Python type.
- * @param json_str JSON string.
+ * @param json_str JSON text (not necessarily NUL-terminated).
+ * @param json_length Length of the JSON text in bytes.
  * @return New DataModel instance or nullptr on error.
  */
-static PyObject *json_utils_from_json_impl(PyObject *cls,
-                                           const char *json_str) {
-  if (!json_str || json_str[0] == '\0') {
+static PyObject *json_utils_from_json_impl(PyObject *cls, const char *json_str,
+                                           size_t json_length) {
+  if (!json_str || json_length == 0) {
     PyErr_SetString(PyExc_ValueError, "Empty JSON string");
     return nullptr;
   }
-  size_t json_length = std::strlen(json_str);
-  std::vector<char> buffer(json_str, json_str + json_length + 1);
 
-  rapidjson::Document doc;
-  doc.ParseInsitu(buffer.data());
+  auto document = std::make_shared<rapidjson::Document>();
+  rapidjson::Document &doc = *document;
+  parse_json_document(doc, json_str, json_length);
   if (doc.HasParseError()) {
     PyErr_Format(PyExc_ValueError, "rapidjson parse error: %s (at offset %u)",
                  rapidjson::GetParseError_En(doc.GetParseError()),
@@ -179,7 +466,25 @@ static PyObject *json_utils_from_json_impl(PyObject *cls,
     return nullptr;
   }
 
-  PyObject *dict_obj = rapidjson_to_pyobject(doc);
+  PyTypeObject *type = reinterpret_cast<PyTypeObject *>(cls);
+  if (PyType_Check(cls) && DataModel_supports_native_init(type)) {
+    PyObject *instance = type->tp_new(type, empty_tuple, nullptr);
+    if (!instance) {
+      return nullptr;
+    }
+    LazyDocumentScope scope(document);
+    if (DataModel_init_from_native(instance, doc) != 0) {
+      Py_DECREF(instance);
+      return nullptr;
+    }
+    return instance;
+  }
+
+  SchemaCache *schema = PyType_Check(cls) ? get_schema_cached(cls) : nullptr;
+  if (!schema) {
+    PyErr_Clear();
+  }
+  PyObject *dict_obj = rapidjson_to_kwds(doc, schema);
   if (!dict_obj) {
     return nullptr;
   }
@@ -194,18 +499,156 @@ static PyObject *json_utils_from_json_impl(PyObject *cls,
     return nullptr;
   }
   PyObject *instance = PyObject_Call(cls, empty_tuple, dict_obj);
-  Py_DECREF(empty_tuple);
   Py_DECREF(dict_obj);
 
   return instance;
 }
 
+// Largest output buffer kept alive between calls.
+static const size_t kMaxRetainedBufferSize = 1 << 20;
+
+/**
+ * @brief Output buffer reused by consecutive to_json calls on a thread.
+ */
+struct ReusableJsonBuffer {
+  rapidjson::StringBuffer buffer;
+  bool in_use = false;
+};
+
+static thread_local ReusableJsonBuffer reusable_json_buffer;
+
+/**
+ * @brief Scoped access to an output buffer.
+ *
+ * Borrows the thread's reusable buffer, or owns a fresh one when the
+ * reusable buffer is already taken by an enclosing call (e.g. a custom
+ * serializer calling to_json). On release the reusable buffer is cleared,
+ * keeping its capacity unless it grew unusually large.
+ */
+class JsonOutputBuffer {
+public:
+  JsonOutputBuffer() : reused_(!reusable_json_buffer.in_use) {
+    if (reused_) {
+      reusable_json_buffer.in_use = true;
+    }
+  }
+
+  ~JsonOutputBuffer() {
+    if (reused_) {
+      rapidjson::StringBuffer &sb = reusable_json_buffer.buffer;
+      bool oversized = sb.GetSize() > kMaxRetainedBufferSize;
+      sb.Clear();
+      if (oversized) {
+        sb.ShrinkToFit();
+      }
+      reusable_json_buffer.in_use = false;
+    }
+  }
+
+  JsonOutputBuffer(const JsonOutputBuffer &) = delete;
+  JsonOutputBuffer &operator=(const JsonOutputBuffer &) = delete;
+
+  rapidjson::StringBuffer &get() {
+    return reused_ ? reusable_json_buffer.buffer : local_;
+  }
+
+private:
+  bool reused_;
+  rapidjson::StringBuffer local_;
+};
+
+/**
+ * @brief Serialize a model and build the result from the output buffer.
+ *
+ * The buffer is pre-sized from the schema's size hint, which is then updated
+ * with the size of this output.
+ *
+ * @param self The DataModel instance.
+ * @param make_result Builds the Python result from (data, length).
+ * @return New reference to the result, or nullptr on error.
+ */
+static PyObject *serialize_model(PyObject *self,
+                                 PyObject *(*make_result)(const char *,
+                                                          Py_ssize_t)) {
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return nullptr;
+  }
+
+  // The hint is shared by threads serializing the class; a lost update
+  // only leaves it a little less accurate.
+  std::atomic_ref<size_t> size_hint(schema->json_size_hint);
+  size_t hint = size_hint.load(std::memory_order_relaxed);
+  JsonOutputBuffer output;
+  rapidjson::StringBuffer &sb = output.get();
+  if (hint > 0) {
+    sb.Reserve(hint + hint / 4);
+  }
+  rapidjson::Writer<rapidjson::StringBuffer> writer(sb);
+  if (!write_json_value(self, schema->json_serializer, writer)) {
+    if (PyErr_ExceptionMatches((PyObject *)&ValidationErrorType)) {
+      return nullptr;
+    }
+    PyErr_SetString(PyExc_RuntimeError, "Error converting object to JSON");
+    return nullptr;
+  }
+
+  size_t size = sb.GetSize();
+  size_hint.store(hint == 0 ? size : (hint * 7 + size) / 8,
+                  std::memory_order_relaxed);
+  return make_result(sb.GetString(), static_cast<Py_ssize_t>(size));
+}
+
+/**
+ * @brief Write a sequence of instances of a class as a JSON array.
+ *
+ * @param cls The model class.
+ * @param schema The compiled schema of cls.
+ * @param items The instances, as returned by PySequence_Fast.
+ * @param writer The rapidjson writer.
+ * @return true on success, false with an exception set.
+ */
+template <typename Writer>
+static bool write_json_instances(PyObject *cls, SchemaCache *schema,
+                                 PyObject *items, Writer &writer) {
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(items);
+  PyObject **item_array = PySequence_Fast_ITEMS(items);
+  writer.StartArray();
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject *item = item_array[i];
+    if (!PyObject_TypeCheck(item, (PyTypeObject *)cls)) {
+      if (json_output_ok(writer)) {
+        PyErr_Format(PyExc_TypeError, "Expected instances of %s, got %s",
+                     ((PyTypeObject *)cls)->tp_name, Py_TYPE(item)->tp_name);
+      }
+      return false;
+    }
+    if (!write_json_value(item, schema->json_serializer, writer)) {
+      if (json_output_ok(writer) &&
+          !PyErr_ExceptionMatches((PyObject *)&ValidationErrorType)) {
+        PyErr_SetString(PyExc_RuntimeError, "Error converting object to JSON");
+      }
+      return false;
+    }
+  }
+  writer.EndArray();
+  return json_output_ok(writer);
+}
+
+// Default number of bytes handed to the target of to_json_into at a time.
+static const Py_ssize_t kDefaultJsonChunkSize = 64 * 1024;
+
+static const char *to_json_into_kwlist[] = {"target", "chunk_size", nullptr};
+static const char *to_json_many_into_kwlist[] = {"instances", "target",
+                                                 "chunk_size", nullptr};
+
 extern "C" {
 
 /**
  * @brief Create a DataModel instance from a JSON string.
  *
- * Expects exactly one argument (a JSON string).
+ * Expects exactly one argument: a str, or any object supporting the buffer
+ * protocol (bytes, bytearray, memoryview, ...) holding UTF-8 JSON.
  */
 PyObject *json_utils_from_json(PyObject *cls, PyObject *const *args,
                                Py_ssize_t nargs) {
@@ -215,12 +658,33 @@ PyObject *json_utils_from_json(PyObject *cls, PyObject *const *args,
     return nullptr;
   }
   PyObject *json_obj = args[0];
-  if (!PyUnicode_Check(json_obj)) {
-    PyErr_SetString(PyExc_TypeError, "Argument must be a Unicode string");
+  if (PyUnicode_Check(json_obj)) {
+    Py_ssize_t json_length = 0;
+    const char *json_str = PyUnicode_AsUTF8AndSize(json_obj, &json_length);
+    if (!json_str) {
+      return nullptr;
+    }
+    return json_utils_from_json_impl(cls, json_str,
+                                     static_cast<size_t>(json_length));
+  }
+  if (PyBytes_Check(json_obj)) {
+    return json_utils_from_json_impl(
+        cls, PyBytes_AS_STRING(json_obj),
+        static_cast<size_t>(PyBytes_GET_SIZE(json_obj)));
+  }
+  if (!PyObject_CheckBuffer(json_obj)) {
+    PyErr_SetString(PyExc_TypeError,
+                    "Argument must be a str or a bytes-like object");
+    return nullptr;
+  }
+  Py_buffer view;
+  if (PyObject_GetBuffer(json_obj, &view, PyBUF_SIMPLE) != 0) {
     return nullptr;
   }
-  const char *json_str = PyUnicode_AsUTF8(json_obj);
-  return json_utils_from_json_impl(cls, json_str);
+  PyObject *instance = json_utils_from_json_impl(
+      cls, static_cast<const char *>(view.buf), static_cast<size_t>(view.len));
+  PyBuffer_Release(&view);
+  return instance;
 }
 
 /**
@@ -229,27 +693,160 @@ PyObject *json_utils_from_json(PyObject *cls, PyObject *const *args,
  * Applies a custom json_serializer and returns a Unicode string.
  */
 PyObject *json_utils_to_json(PyObject *self, PyObject *Py_UNUSED(ignored)) {
-  PyTypeObject *type_ptr = Py_TYPE(self);
-  PyObject *capsule = get_cached_schema(type_ptr);
-  if (!capsule) {
+  return serialize_model(self, PyUnicode_FromStringAndSize);
+}
+
+/**
+ * @brief Convert a DataModel instance to UTF-8 encoded JSON bytes.
+ *
+ * Same as json_utils_to_json, but the buffer is copied into a bytes object
+ * without decoding.
+ */
+PyObject *json_utils_to_json_bytes(PyObject *self,
+                                   PyObject *Py_UNUSED(ignored)) {
+  return serialize_model(self, PyBytes_FromStringAndSize);
+}
+
+/**
+ * @brief Convert a sequence of DataModel instances to a JSON array string.
+ *
+ * Every instance is written into the same output buffer, pre-sized from the
+ * schema's size hint.
+ */
+PyObject *json_utils_to_json_many(PyObject *cls, PyObject *instances) {
+  if (!PyType_Check(cls)) {
+    PyErr_SetString(PyExc_TypeError, "Expected a model class");
     return nullptr;
   }
-  SchemaCache *schema = reinterpret_cast<SchemaCache *>(
-      PyCapsule_GetPointer(capsule, "vldt.SchemaCache"));
-  Py_DECREF(capsule);
+  SchemaCache *schema = get_schema_cached(cls);
   if (!schema) {
     return nullptr;
   }
+  PyObject *items =
+      PySequence_Fast(instances, "Expected a sequence of model instances");
+  if (!items) {
+    return nullptr;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(items);
 
-  PyObject *json_serializer = schema->json_serializer;
-  rapidjson::StringBuffer sb;
+  JsonOutputBuffer output;
+  rapidjson::StringBuffer &sb = output.get();
+  size_t hint = std::atomic_ref<size_t>(schema->json_size_hint)
+                    .load(std::memory_order_relaxed);
+  if (hint > 0) {
+    sb.Reserve((hint + 1) * static_cast<size_t>(count) + 2);
+  }
   rapidjson::Writer<rapidjson::StringBuffer> writer(sb);
+  bool success = write_json_instances(cls, schema, items, writer);
+  Py_DECREF(items);
+  if (!success) {
+    return nullptr;
+  }
+  return PyUnicode_FromStringAndSize(sb.GetString(),
+                                     static_cast<Py_ssize_t>(sb.GetSize()));
+}
 
-  if (!write_json_value(self, json_serializer, writer)) {
-    PyErr_SetString(PyExc_RuntimeError, "Error converting object to JSON");
+/**
+ * @brief Stream a DataModel instance as JSON into an output target.
+ *
+ * Takes the target and an optional chunk_size; returns the number of bytes
+ * written.
+ */
+PyObject *json_utils_to_json_into(PyObject *self, PyObject *args,
+                                  PyObject *kwds) {
+  PyObject *target = nullptr;
+  Py_ssize_t chunk_size = kDefaultJsonChunkSize;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|n:to_json_into",
+                                   const_cast<char **>(to_json_into_kwlist),
+                                   &target, &chunk_size)) {
+    return nullptr;
+  }
+  if (chunk_size <= 0) {
+    PyErr_SetString(PyExc_ValueError, "chunk_size must be positive");
+    return nullptr;
+  }
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return nullptr;
+  }
+  JsonChunkSink sink;
+  if (sink.open(target) < 0) {
+    return nullptr;
+  }
+  ChunkedJsonStream stream(sink, static_cast<size_t>(chunk_size));
+  if (!stream.allocated()) {
+    return PyErr_NoMemory();
+  }
+  ChunkedJsonWriter writer(stream);
+  if (!write_json_value(self, schema->json_serializer, writer)) {
+    if (!writer.failed() &&
+        !PyErr_ExceptionMatches((PyObject *)&ValidationErrorType)) {
+      PyErr_SetString(PyExc_RuntimeError, "Error converting object to JSON");
+    }
+    return nullptr;
+  }
+  stream.Flush();
+  if (stream.failed()) {
+    return nullptr;
+  }
+  return PyLong_FromSsize_t(sink.written());
+}
+
+/**
+ * @brief Stream a sequence of DataModel instances as a JSON array.
+ *
+ * Takes the instances, the target and an optional chunk_size; returns the
+ * number of bytes written.
+ */
+PyObject *json_utils_to_json_many_into(PyObject *cls, PyObject *args,
+                                       PyObject *kwds) {
+  PyObject *instances = nullptr;
+  PyObject *target = nullptr;
+  Py_ssize_t chunk_size = kDefaultJsonChunkSize;
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "OO|n:to_json_many_into",
+          const_cast<char **>(to_json_many_into_kwlist), &instances, &target,
+          &chunk_size)) {
+    return nullptr;
+  }
+  if (chunk_size <= 0) {
+    PyErr_SetString(PyExc_ValueError, "chunk_size must be positive");
+    return nullptr;
+  }
+  if (!PyType_Check(cls)) {
+    PyErr_SetString(PyExc_TypeError, "Expected a model class");
+    return nullptr;
+  }
+  SchemaCache *schema = get_schema_cached(cls);
+  if (!schema) {
+    return nullptr;
+  }
+  PyObject *items =
+      PySequence_Fast(instances, "Expected a sequence of model instances");
+  if (!items) {
+    return nullptr;
+  }
+  JsonChunkSink sink;
+  if (sink.open(target) < 0) {
+    Py_DECREF(items);
+    return nullptr;
+  }
+  ChunkedJsonStream stream(sink, static_cast<size_t>(chunk_size));
+  if (!stream.allocated()) {
+    Py_DECREF(items);
+    return PyErr_NoMemory();
+  }
+  ChunkedJsonWriter writer(stream);
+  bool success = write_json_instances(cls, schema, items, writer);
+  Py_DECREF(items);
+  if (!success) {
+    return nullptr;
+  }
+  stream.Flush();
+  if (stream.failed()) {
     return nullptr;
   }
-  return PyUnicode_FromString(sb.GetString());
+  return PyLong_FromSsize_t(sink.written());
 }
 
 } // extern "C"
@@ -10,8 +10,9 @@ extern "C" {
  * @brief Create a DataModel instance from a JSON string.
  *
  * This function converts a JSON string into a new DataModel instance.
- * It expects exactly one argument (a JSON string) and returns the instance
- * or NULL on failure.
+ * It expects exactly one argument (a str or a bytes-like object such as
+ * bytes, bytearray or memoryview) and returns the instance or NULL on
+ * failure.
  *
  * @param cls The Python type object for the DataModel.
  * @param args Pointer to an array of Python objects (arguments).
@@ -34,6 +35,63 @@ PyObject *json_utils_from_json(PyObject *cls, PyObject *const *args,
  */
 PyObject *json_utils_to_json(PyObject *self, PyObject *Py_UNUSED(ignored));
 
+/**
+ * @brief Convert a DataModel instance to UTF-8 encoded JSON bytes.
+ *
+ * Produces the same JSON as json_utils_to_json, returned as a bytes object
+ * built directly from the output buffer.
+ *
+ * @param self The DataModel instance.
+ * @param Py_UNUSED(ignored) Unused parameter.
+ * @return A Python bytes object containing the JSON, or NULL on error.
+ */
+PyObject *json_utils_to_json_bytes(PyObject *self,
+                                   PyObject *Py_UNUSED(ignored));
+
+/**
+ * @brief Convert a sequence of DataModel instances to a JSON array string.
+ *
+ * Produces the same text as joining the to_json() output of each instance
+ * into an array, built in a single buffer with the json_serializer of cls.
+ *
+ * @param cls The model class.
+ * @param instances A list or tuple of instances of cls.
+ * @return PyObject* A new str holding the JSON array, or NULL on error.
+ */
+PyObject *json_utils_to_json_many(PyObject *cls, PyObject *instances);
+
+/**
+ * @brief Stream a DataModel instance as JSON into an output target.
+ *
+ * Produces the same JSON as json_utils_to_json without building it in
+ * memory: the output is handed to the target in chunks of chunk_size bytes
+ * (64 KiB by default) as it is written. The target is a file descriptor, a
+ * bytearray (appended to), an object with a write method or a callable
+ * (called with bytes), or a writable buffer (filled from its start).
+ *
+ * @param self The DataModel instance.
+ * @param args Positional arguments: the target and chunk_size.
+ * @param kwds Keyword arguments.
+ * @return PyObject* The number of bytes written, or NULL on error.
+ */
+PyObject *json_utils_to_json_into(PyObject *self, PyObject *args,
+                                  PyObject *kwds);
+
+/**
+ * @brief Stream a sequence of DataModel instances as a JSON array.
+ *
+ * Writes the array of json_utils_to_json_many to a target in chunks, as
+ * json_utils_to_json_into does.
+ *
+ * @param cls The model class.
+ * @param args Positional arguments: the instances, the target and
+ * chunk_size.
+ * @param kwds Keyword arguments.
+ * @return PyObject* The number of bytes written, or NULL on error.
+ */
+PyObject *json_utils_to_json_many_into(PyObject *cls, PyObject *args,
+                                       PyObject *kwds);
+
 #ifdef __cplusplus
 }
 #endif
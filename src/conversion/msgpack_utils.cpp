@@ -0,0 +1,1104 @@
+#include "msgpack_utils.hpp"
+#include "data_model.hpp"
+#include "error_handling.hpp"
+#include "init_globals.hpp"
+#include "schema/schema.hpp"
+#include "validation/validation.hpp"
+#include "validation_builtins.hpp"
+#include <Python.h>
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+/**
+ * @brief Output buffer with the msgpack encoders used by to_msgpack.
+ *
+ * Integers and headers are written in their shortest form. The header
+ * methods return false when the length does not fit in 32 bits.
+ */
+class MsgpackWriter {
+public:
+  void reserve(size_t size) { out_.reserve(size); }
+  const std::string &data() const { return out_; }
+
+  void nil() { out_.push_back('\xc0'); }
+  void boolean(bool value) { out_.push_back(value ? '\xc3' : '\xc2'); }
+
+  void integer(long long value) {
+    if (value >= 0) {
+      uinteger(static_cast<unsigned long long>(value));
+    } else if (value >= -32) {
+      out_.push_back(static_cast<char>(value));
+    } else if (value >= INT8_MIN) {
+      put(0xd0, static_cast<uint64_t>(value), 1);
+    } else if (value >= INT16_MIN) {
+      put(0xd1, static_cast<uint64_t>(value), 2);
+    } else if (value >= INT32_MIN) {
+      put(0xd2, static_cast<uint64_t>(value), 4);
+    } else {
+      put(0xd3, static_cast<uint64_t>(value), 8);
+    }
+  }
+
+  void uinteger(unsigned long long value) {
+    if (value < 0x80) {
+      out_.push_back(static_cast<char>(value));
+    } else if (value <= 0xff) {
+      put(0xcc, value, 1);
+    } else if (value <= 0xffff) {
+      put(0xcd, value, 2);
+    } else if (value <= 0xffffffff) {
+      put(0xce, value, 4);
+    } else {
+      put(0xcf, value, 8);
+    }
+  }
+
+  void float64(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put(0xcb, bits, 8);
+  }
+
+  bool str(const char *data, size_t length) {
+    if (length < 32) {
+      out_.push_back(static_cast<char>(0xa0 | length));
+    } else if (!header(length, 0xd9, 0xda, 0xdb)) {
+      return false;
+    }
+    out_.append(data, length);
+    return true;
+  }
+
+  bool bin(const char *data, size_t length) {
+    if (!header(length, 0xc4, 0xc5, 0xc6)) {
+      return false;
+    }
+    out_.append(data, length);
+    return true;
+  }
+
+  bool array(size_t count) {
+    if (count < 16) {
+      out_.push_back(static_cast<char>(0x90 | count));
+      return true;
+    }
+    return header(count, 0, 0xdc, 0xdd);
+  }
+
+  bool map(size_t count) {
+    if (count < 16) {
+      out_.push_back(static_cast<char>(0x80 | count));
+      return true;
+    }
+    return header(count, 0, 0xde, 0xdf);
+  }
+
+private:
+  void put(unsigned char tag, uint64_t value, int bytes) {
+    char buffer[9];
+    buffer[0] = static_cast<char>(tag);
+    for (int i = 0; i < bytes; i++) {
+      buffer[1 + i] = static_cast<char>(value >> (8 * (bytes - 1 - i)));
+    }
+    out_.append(buffer, static_cast<size_t>(bytes) + 1);
+  }
+
+  // Writes a length with the 8-bit (if tag8 is set), 16-bit or 32-bit tag.
+  bool header(size_t length, unsigned char tag8, unsigned char tag16,
+              unsigned char tag32) {
+    if (tag8 && length <= 0xff) {
+      put(tag8, length, 1);
+    } else if (length <= 0xffff) {
+      put(tag16, length, 2);
+    } else if (length <= 0xffffffff) {
+      put(tag32, length, 4);
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  std::string out_;
+};
+
+/**
+ * @brief Set the error for a value too large for a msgpack header.
+ *
+ * @return false, for use as the return value of a writer.
+ */
+static bool msgpack_too_large() {
+  PyErr_SetString(PyExc_OverflowError, "Value too large for msgpack");
+  return false;
+}
+
+/**
+ * @brief Write a str object as a msgpack string.
+ *
+ * @param str The str object.
+ * @param writer The output.
+ * @return true on success, false on error.
+ */
+static bool write_msgpack_string(PyObject *str, MsgpackWriter &writer) {
+  const char *data = nullptr;
+  Py_ssize_t length = 0;
+  if (PyUnicode_IS_COMPACT_ASCII(str)) {
+    data = static_cast<const char *>(PyUnicode_DATA(str));
+    length = PyUnicode_GET_LENGTH(str);
+  } else {
+    data = PyUnicode_AsUTF8AndSize(str, &length);
+    if (!data) {
+      return false;
+    }
+  }
+  return writer.str(data, static_cast<size_t>(length)) || msgpack_too_large();
+}
+
+// Forward declaration.
+static bool write_msgpack_value(PyObject *value, PyObject *json_serializer,
+                                MsgpackWriter &writer);
+
+/**
+ * @brief Write a model as a map of its set fields and extra attributes.
+ *
+ * @param value The DataModel instance.
+ * @param json_serializer The json_serializer of the outermost model.
+ * @param writer The output.
+ * @return true on success, false on error.
+ */
+static bool write_msgpack_model(PyObject *value, PyObject *json_serializer,
+                                MsgpackWriter &writer) {
+  if (DataModel_validate_pending(value) < 0) {
+    return false;
+  }
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(value));
+  if (!schema) {
+    return false;
+  }
+  auto model = reinterpret_cast<DataModelObject *>(value);
+  Py_ssize_t num_slots = DataModel_num_slots(value) < schema->num_fields
+                             ? DataModel_num_slots(value)
+                             : schema->num_fields;
+  size_t count = 0;
+  for (Py_ssize_t i = 0; i < num_slots; i++) {
+    count += model->slots[i] != nullptr;
+  }
+  if (model->instance_data) {
+    count += model->instance_data->fields.size();
+  }
+  if (!writer.map(count)) {
+    return msgpack_too_large();
+  }
+  for (Py_ssize_t i = 0; i < num_slots; i++) {
+    if (!model->slots[i]) {
+      continue;
+    }
+    if (!write_msgpack_string(schema->fields[i].field_name, writer) ||
+        !write_msgpack_value(model->slots[i], json_serializer, writer)) {
+      return false;
+    }
+  }
+  if (model->instance_data) {
+    for (auto &pair : model->instance_data->fields) {
+      if (!writer.str(pair.first.data(), pair.first.size()) ||
+          !write_msgpack_value(pair.second, json_serializer, writer)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Write a model, list, tuple, dict, set or frozenset.
+ *
+ * Tuples and sets are written as arrays; dict keys keep their own type.
+ *
+ * @param value The container.
+ * @param json_serializer The json_serializer of the outermost model.
+ * @param writer The output.
+ * @return true on success, false on error.
+ */
+static bool write_msgpack_container(PyObject *value, PyObject *json_serializer,
+                                    MsgpackWriter &writer) {
+  if (PyObject_TypeCheck(value, &DataModelType)) {
+    return write_msgpack_model(value, json_serializer, writer);
+  }
+  if (PyList_Check(value) || PyTuple_Check(value)) {
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(value);
+    PyObject **items = PySequence_Fast_ITEMS(value);
+    if (!writer.array(static_cast<size_t>(size))) {
+      return msgpack_too_large();
+    }
+    for (Py_ssize_t i = 0; i < size; i++) {
+      if (!write_msgpack_value(items[i], json_serializer, writer)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (PyDict_Check(value)) {
+    if (!writer.map(static_cast<size_t>(PyDict_GET_SIZE(value)))) {
+      return msgpack_too_large();
+    }
+    PyObject *key, *item;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(value, &pos, &key, &item)) {
+      if (!write_msgpack_value(key, json_serializer, writer) ||
+          !write_msgpack_value(item, json_serializer, writer)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (!writer.array(static_cast<size_t>(PySet_GET_SIZE(value)))) {
+    return msgpack_too_large();
+  }
+  PyObject *iterator = PyObject_GetIter(value);
+  if (!iterator) {
+    return false;
+  }
+  PyObject *item;
+  bool success = true;
+  while (success && (item = PyIter_Next(iterator)) != nullptr) {
+    success = write_msgpack_value(item, json_serializer, writer);
+    Py_DECREF(item);
+  }
+  Py_DECREF(iterator);
+  return success && !PyErr_Occurred();
+}
+
+/**
+ * @brief Recursively write a Python object as msgpack.
+ *
+ * Values msgpack has no type for are looked up in json_serializer, then
+ * written as their str() text, which validates back to the field's type.
+ */
+static bool write_msgpack_value(PyObject *value, PyObject *json_serializer,
+                                MsgpackWriter &writer) {
+  if (PyUnicode_Check(value)) {
+    return write_msgpack_string(value, writer);
+  }
+  if (PyBool_Check(value)) {
+    writer.boolean(value == Py_True);
+    return true;
+  }
+  if (PyLong_Check(value)) {
+    int overflow = 0;
+    long long int_value = PyLong_AsLongLongAndOverflow(value, &overflow);
+    if (overflow == 0) {
+      if (int_value == -1 && PyErr_Occurred()) {
+        return false;
+      }
+      writer.integer(int_value);
+      return true;
+    }
+    unsigned long long uint_value =
+        overflow > 0 ? PyLong_AsUnsignedLongLong(value) : 0;
+    if (overflow < 0 || PyErr_Occurred()) {
+      PyErr_Clear();
+      PyErr_SetString(PyExc_OverflowError, "int too large for msgpack");
+      return false;
+    }
+    writer.uinteger(uint_value);
+    return true;
+  }
+  if (PyFloat_Check(value)) {
+    writer.float64(PyFloat_AS_DOUBLE(value));
+    return true;
+  }
+  if (value == Py_None) {
+    writer.nil();
+    return true;
+  }
+  if (PyObject_TypeCheck(value, &DataModelType) || PyList_Check(value) ||
+      PyTuple_Check(value) || PyDict_Check(value) || PyAnySet_Check(value)) {
+    if (Py_EnterRecursiveCall(" while converting an object to msgpack")) {
+      return false;
+    }
+    bool success = write_msgpack_container(value, json_serializer, writer);
+    Py_LeaveRecursiveCall();
+    return success;
+  }
+  if (PyBytes_Check(value)) {
+    return writer.bin(PyBytes_AS_STRING(value),
+                      static_cast<size_t>(PyBytes_GET_SIZE(value))) ||
+           msgpack_too_large();
+  }
+  if (PyByteArray_Check(value)) {
+    return writer.bin(PyByteArray_AS_STRING(value),
+                      static_cast<size_t>(PyByteArray_GET_SIZE(value))) ||
+           msgpack_too_large();
+  }
+  if (PyObject_TypeCheck(value, (PyTypeObject *)EnumType)) {
+    static PyObject *value_name = PyUnicode_InternFromString("_value_");
+    PyObject *member_value =
+        value_name ? PyObject_GetAttr(value, value_name) : nullptr;
+    if (!member_value) {
+      return false;
+    }
+    bool success = write_msgpack_value(member_value, json_serializer, writer);
+    Py_DECREF(member_value);
+    return success;
+  }
+  char text[40];
+  Py_ssize_t length = format_builtin_value(value, text);
+  if (length < 0) {
+    return false;
+  }
+  if (length > 0) {
+    return writer.str(text, static_cast<size_t>(length));
+  }
+  if (json_serializer && PyDict_Check(json_serializer)) {
+    PyObject *conv_func =
+        PyDict_GetItem(json_serializer, (PyObject *)Py_TYPE(value));
+    if (conv_func && PyCallable_Check(conv_func)) {
+      PyObject *converted =
+          PyObject_CallFunctionObjArgs(conv_func, value, nullptr);
+      if (!converted) {
+        return false;
+      }
+      bool success = write_msgpack_value(converted, json_serializer, writer);
+      Py_DECREF(converted);
+      return success;
+    }
+  }
+  PyObject *str_obj = PyObject_Str(value);
+  if (!str_obj) {
+    return false;
+  }
+  bool success = write_msgpack_string(str_obj, writer);
+  Py_DECREF(str_obj);
+  return success;
+}
+
+/**
+ * @brief Kind of a msgpack value, as told by its header.
+ */
+enum MsgpackKind {
+  MP_NIL,
+  MP_BOOL,
+  MP_INT,  // Any integer that fits in int64.
+  MP_UINT, // Integers above INT64_MAX.
+  MP_FLOAT,
+  MP_STR,
+  MP_BIN,
+  MP_ARRAY,
+  MP_MAP
+};
+
+/**
+ * @brief A decoded msgpack header.
+ *
+ * Strings and binaries include their payload; the items of arrays and maps
+ * follow the header in the input.
+ */
+struct MsgpackToken {
+  MsgpackKind kind;
+  int64_t int_value; // MP_BOOL, MP_INT.
+  uint64_t uint_value; // MP_UINT.
+  double float_value;  // MP_FLOAT.
+  const char *bytes;   // MP_STR, MP_BIN: the payload.
+  size_t length;       // Payload bytes, array items or map pairs.
+};
+
+/**
+ * @brief Position in the msgpack input.
+ */
+struct MsgpackReader {
+  const unsigned char *data;
+  size_t size;
+  size_t pos;
+};
+
+/**
+ * @brief Read a big-endian unsigned number of the given width.
+ *
+ * @param reader The input.
+ * @param bytes Width of the number: 1, 2, 4 or 8.
+ * @param out Receives the number.
+ * @return true on success, false with ValueError set if the input ends.
+ */
+static bool read_msgpack_uint(MsgpackReader *reader, int bytes,
+                              uint64_t *out) {
+  if (reader->size - reader->pos < static_cast<size_t>(bytes)) {
+    PyErr_Format(PyExc_ValueError, "Truncated msgpack data at offset %zu",
+                 reader->pos);
+    return false;
+  }
+  uint64_t value = 0;
+  for (int i = 0; i < bytes; i++) {
+    value = (value << 8) | reader->data[reader->pos++];
+  }
+  *out = value;
+  return true;
+}
+
+/**
+ * @brief Read the header of the next value, and its payload for strings.
+ *
+ * Array and map lengths are checked against the remaining input, so a
+ * corrupt length cannot cause a large allocation.
+ *
+ * @param reader The input.
+ * @param token Receives the header.
+ * @return true on success, false with ValueError set otherwise.
+ */
+static bool read_msgpack_token(MsgpackReader *reader, MsgpackToken *token) {
+  if (reader->pos >= reader->size) {
+    PyErr_Format(PyExc_ValueError, "Truncated msgpack data at offset %zu",
+                 reader->pos);
+    return false;
+  }
+  size_t start = reader->pos;
+  unsigned char tag = reader->data[reader->pos++];
+  uint64_t number = 0;
+  int width = 0;
+  token->length = 0;
+  if (tag <= 0x7f || tag >= 0xe0) {
+    token->kind = MP_INT;
+    token->int_value = tag <= 0x7f ? tag : static_cast<signed char>(tag);
+    return true;
+  }
+  if ((tag & 0xe0) == 0xa0) {
+    token->kind = MP_STR;
+    token->length = tag & 0x1f;
+  } else if ((tag & 0xf0) == 0x90) {
+    token->kind = MP_ARRAY;
+    token->length = tag & 0x0f;
+  } else if ((tag & 0xf0) == 0x80) {
+    token->kind = MP_MAP;
+    token->length = tag & 0x0f;
+  } else {
+    switch (tag) {
+    case 0xc0:
+      token->kind = MP_NIL;
+      return true;
+    case 0xc2:
+    case 0xc3:
+      token->kind = MP_BOOL;
+      token->int_value = tag == 0xc3;
+      return true;
+    case 0xc4:
+    case 0xc5:
+    case 0xc6:
+      token->kind = MP_BIN;
+      width = 1 << (tag - 0xc4);
+      break;
+    case 0xca:
+    case 0xcb: {
+      token->kind = MP_FLOAT;
+      if (!read_msgpack_uint(reader, tag == 0xca ? 4 : 8, &number)) {
+        return false;
+      }
+      if (tag == 0xca) {
+        uint32_t bits = static_cast<uint32_t>(number);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        token->float_value = value;
+      } else {
+        memcpy(&token->float_value, &number, sizeof(number));
+      }
+      return true;
+    }
+    case 0xcc:
+    case 0xcd:
+    case 0xce:
+    case 0xcf:
+      if (!read_msgpack_uint(reader, 1 << (tag - 0xcc), &number)) {
+        return false;
+      }
+      token->kind = number > INT64_MAX ? MP_UINT : MP_INT;
+      token->uint_value = number;
+      token->int_value = static_cast<int64_t>(number);
+      return true;
+    case 0xd0:
+    case 0xd1:
+    case 0xd2:
+    case 0xd3: {
+      int bytes = 1 << (tag - 0xd0);
+      if (!read_msgpack_uint(reader, bytes, &number)) {
+        return false;
+      }
+      // Sign-extend from the width of the number.
+      int shift = 64 - 8 * bytes;
+      token->kind = MP_INT;
+      token->int_value = static_cast<int64_t>(number << shift) >> shift;
+      return true;
+    }
+    case 0xd9:
+    case 0xda:
+    case 0xdb:
+      token->kind = MP_STR;
+      width = 1 << (tag - 0xd9);
+      break;
+    case 0xdc:
+    case 0xdd:
+      token->kind = MP_ARRAY;
+      width = tag == 0xdc ? 2 : 4;
+      break;
+    case 0xde:
+    case 0xdf:
+      token->kind = MP_MAP;
+      width = tag == 0xde ? 2 : 4;
+      break;
+    default:
+      PyErr_Format(PyExc_ValueError,
+                   "Unsupported msgpack type 0x%02x at offset %zu", tag, start);
+      return false;
+    }
+    if (!read_msgpack_uint(reader, width, &number)) {
+      return false;
+    }
+    token->length = static_cast<size_t>(number);
+  }
+
+  // Every array item takes at least one byte, every map pair two.
+  size_t remaining = reader->size - reader->pos;
+  if (token->length > remaining / (token->kind == MP_MAP ? 2 : 1)) {
+    PyErr_Format(PyExc_ValueError, "Truncated msgpack data at offset %zu",
+                 start);
+    return false;
+  }
+  if (token->kind == MP_STR || token->kind == MP_BIN) {
+    token->bytes = reinterpret_cast<const char *>(reader->data + reader->pos);
+    reader->pos += token->length;
+  }
+  return true;
+}
+
+// Forward declaration.
+static PyObject *read_msgpack_value(MsgpackReader *reader);
+
+/**
+ * @brief Build the Python value of a token.
+ *
+ * Arrays become lists and maps dicts, with their items read generically.
+ *
+ * @param reader The input, positioned after the header.
+ * @param token The header.
+ * @return New reference to the value, or nullptr on error.
+ */
+static PyObject *msgpack_token_value(MsgpackReader *reader,
+                                     const MsgpackToken &token) {
+  switch (token.kind) {
+  case MP_NIL:
+    Py_RETURN_NONE;
+  case MP_BOOL:
+    return PyBool_FromLong(static_cast<long>(token.int_value));
+  case MP_INT:
+    return PyLong_FromLongLong(token.int_value);
+  case MP_UINT:
+    return PyLong_FromUnsignedLongLong(token.uint_value);
+  case MP_FLOAT:
+    return PyFloat_FromDouble(token.float_value);
+  case MP_STR:
+    return PyUnicode_DecodeUTF8(token.bytes,
+                                static_cast<Py_ssize_t>(token.length), nullptr);
+  case MP_BIN:
+    return PyBytes_FromStringAndSize(token.bytes,
+                                     static_cast<Py_ssize_t>(token.length));
+  case MP_ARRAY:
+  case MP_MAP:
+    break;
+  }
+  if (Py_EnterRecursiveCall(" while reading msgpack data")) {
+    return nullptr;
+  }
+  PyObject *result;
+  if (token.kind == MP_ARRAY) {
+    result = PyList_New(static_cast<Py_ssize_t>(token.length));
+    for (size_t i = 0; result && i < token.length; i++) {
+      PyObject *item = read_msgpack_value(reader);
+      if (!item) {
+        Py_CLEAR(result);
+        break;
+      }
+      PyList_SET_ITEM(result, static_cast<Py_ssize_t>(i), item);
+    }
+  } else {
+    result = PyDict_New();
+    for (size_t i = 0; result && i < token.length; i++) {
+      PyObject *key = read_msgpack_value(reader);
+      PyObject *item = key ? read_msgpack_value(reader) : nullptr;
+      if (!item || PyDict_SetItem(result, key, item) < 0) {
+        Py_CLEAR(result);
+      }
+      Py_XDECREF(key);
+      Py_XDECREF(item);
+    }
+  }
+  Py_LeaveRecursiveCall();
+  return result;
+}
+
+/**
+ * @brief Read the next value without a schema.
+ *
+ * @param reader The input.
+ * @return New reference to the value, or nullptr on error.
+ */
+static PyObject *read_msgpack_value(MsgpackReader *reader) {
+  MsgpackToken token;
+  if (!read_msgpack_token(reader, &token)) {
+    return nullptr;
+  }
+  return msgpack_token_value(reader, token);
+}
+
+/**
+ * @brief State shared by the readers of one from_msgpack call.
+ */
+struct MsgpackLoad {
+  bool trusted;              // Store fields as read instead of validating.
+  ErrorCollector *collector; // Conversion errors of trusted loads.
+};
+
+// Forward declarations.
+static PyObject *read_msgpack_field(MsgpackReader *reader,
+                                    MsgpackToken &token, TypeSchema *ts,
+                                    MsgpackLoad *load,
+                                    Deserializers *deserializers,
+                                    const ErrorPath *path);
+static PyObject *read_msgpack_model(MsgpackReader *reader, size_t count,
+                                    PyTypeObject *type, MsgpackLoad *load,
+                                    const ErrorPath *path);
+
+/**
+ * @brief Read the next value for a field of the given type.
+ *
+ * @return New reference to the value; nullptr with an exception set on
+ * error, or without one if a trusted load recorded conversion errors. The
+ * value is consumed in both cases.
+ */
+static PyObject *read_msgpack_typed(MsgpackReader *reader, TypeSchema *ts,
+                                    MsgpackLoad *load,
+                                    Deserializers *deserializers,
+                                    const ErrorPath *path) {
+  MsgpackToken token;
+  if (!read_msgpack_token(reader, &token)) {
+    return nullptr;
+  }
+  return read_msgpack_field(reader, token, ts, load, deserializers, path);
+}
+
+/**
+ * @brief Read the items of an array for a list, tuple or set field.
+ *
+ * @param reader The input, positioned after the array header.
+ * @param count The number of items.
+ * @param ts The schema of the field (OP_LIST, OP_TUPLE or OP_SET).
+ * @param load The load state.
+ * @param deserializers The deserializers of the enclosing model.
+ * @param path Error path of the field.
+ * @return As for read_msgpack_typed.
+ */
+static PyObject *read_msgpack_sequence(MsgpackReader *reader, size_t count,
+                                       TypeSchema *ts, MsgpackLoad *load,
+                                       Deserializers *deserializers,
+                                       const ErrorPath *path) {
+  if (Py_EnterRecursiveCall(" while reading msgpack data")) {
+    return nullptr;
+  }
+  PyObject *items = PyList_New(static_cast<Py_ssize_t>(count));
+  bool failed = false;
+  bool typed = true;
+  for (size_t i = 0; items && i < count; i++) {
+    TypeSchema *item_ts = nullptr;
+    if (ts->op == OP_TUPLE) {
+      item_ts = static_cast<Py_ssize_t>(i) < ts->num_args ? ts->args[i]
+                                                           : nullptr;
+    } else if (ts->num_args == 1) {
+      item_ts = ts->args[0];
+    }
+    typed = typed && item_ts;
+    ErrorPath item_path(path, static_cast<Py_ssize_t>(i));
+    PyObject *item = item_ts ? read_msgpack_typed(reader, item_ts, load,
+                                                  deserializers, &item_path)
+                             : read_msgpack_value(reader);
+    if (!item) {
+      if (PyErr_Occurred()) {
+        Py_CLEAR(items);
+        break;
+      }
+      failed = true;
+      item = Py_NewRef(Py_None);
+    }
+    PyList_SET_ITEM(items, static_cast<Py_ssize_t>(i), item);
+  }
+  Py_LeaveRecursiveCall();
+  if (!items || failed) {
+    Py_XDECREF(items);
+    return nullptr;
+  }
+  PyObject *result = items;
+  if (ts->op == OP_TUPLE) {
+    result = PyList_AsTuple(items);
+    Py_DECREF(items);
+  } else if (ts->op == OP_SET) {
+    result = PySet_New(items);
+    Py_DECREF(items);
+  }
+  if (result && load->trusted &&
+      (!typed || (ts->op == OP_TUPLE &&
+                  ts->num_args != static_cast<Py_ssize_t>(count)))) {
+    PyObject *converted = validate_and_convert(result, ts, load->collector,
+                                               path, deserializers);
+    Py_DECREF(result);
+    result = converted;
+  }
+  return result;
+}
+
+/**
+ * @brief Read the pairs of a map for a dict field.
+ *
+ * @param reader The input, positioned after the map header.
+ * @param count The number of pairs.
+ * @param ts The schema of the field (OP_DICT with key and value types).
+ * @param load The load state.
+ * @param deserializers The deserializers of the enclosing model.
+ * @param path Error path of the field.
+ * @return As for read_msgpack_typed.
+ */
+static PyObject *read_msgpack_mapping(MsgpackReader *reader, size_t count,
+                                      TypeSchema *ts, MsgpackLoad *load,
+                                      Deserializers *deserializers,
+                                      const ErrorPath *path) {
+  if (Py_EnterRecursiveCall(" while reading msgpack data")) {
+    return nullptr;
+  }
+  PyObject *result = PyDict_New();
+  bool failed = false;
+  for (size_t i = 0; result && i < count; i++) {
+    PyObject *key = read_msgpack_value(reader);
+    if (key && load->trusted && !value_is_exact(key, ts->args[0])) {
+      ErrorPath key_path(path, key);
+      PyObject *converted = validate_and_convert(
+          key, ts->args[0], load->collector, &key_path, deserializers);
+      Py_SETREF(key, converted);
+    }
+    if (!key && PyErr_Occurred()) {
+      Py_CLEAR(result);
+      break;
+    }
+    ErrorPath item_path(path, key ? key : Py_None);
+    PyObject *item = read_msgpack_typed(reader, ts->args[1], load,
+                                        deserializers, &item_path);
+    if (item && key) {
+      if (PyDict_SetItem(result, key, item) < 0) {
+        Py_CLEAR(result);
+      }
+    } else if (PyErr_Occurred()) {
+      Py_CLEAR(result);
+    } else {
+      failed = true;
+    }
+    Py_XDECREF(key);
+    Py_XDECREF(item);
+  }
+  Py_LeaveRecursiveCall();
+  if (failed) {
+    Py_CLEAR(result);
+  }
+  return result;
+}
+
+/**
+ * @brief Read a value whose header has been read for a field of a type.
+ *
+ * Maps for model fields and arrays for list, tuple and set fields are read
+ * item by item with the schemas of their items; other values are read as
+ * is. Trusted loads convert the values not already of the exact type.
+ *
+ * @return As for read_msgpack_typed.
+ */
+static PyObject *read_msgpack_field(MsgpackReader *reader,
+                                    MsgpackToken &token, TypeSchema *ts,
+                                    MsgpackLoad *load,
+                                    Deserializers *deserializers,
+                                    const ErrorPath *path) {
+  if (ts->op == OP_OPTIONAL) {
+    if (token.kind == MP_NIL) {
+      Py_RETURN_NONE;
+    }
+    ts = ts->optional_target;
+  }
+  switch (ts->op) {
+  case OP_MODEL:
+    if (token.kind == MP_MAP) {
+      return read_msgpack_model(reader, token.length,
+                                (PyTypeObject *)ts->expected_type, load, path);
+    }
+    break;
+  case OP_LIST:
+  case OP_TUPLE:
+  case OP_SET:
+    if (token.kind == MP_ARRAY) {
+      return read_msgpack_sequence(reader, token.length, ts, load,
+                                   deserializers, path);
+    }
+    break;
+  case OP_DICT:
+    if (token.kind == MP_MAP && ts->num_args == 2) {
+      return read_msgpack_mapping(reader, token.length, ts, load,
+                                  deserializers, path);
+    }
+    break;
+  default:
+    break;
+  }
+  PyObject *value = msgpack_token_value(reader, token);
+  if (!value || !load->trusted || value_is_exact(value, ts)) {
+    return value;
+  }
+  PyObject *converted =
+      validate_and_convert(value, ts, load->collector, path, deserializers);
+  Py_DECREF(value);
+  return converted;
+}
+
+/**
+ * @brief Read the pairs of a map holding the fields of a model.
+ *
+ * Trusted loads store the values straight into the slots of a new instance,
+ * keeping unknown keys as extra attributes; fields missing from the map
+ * then get their defaults as in init, and missing required fields are
+ * recorded as errors. Other loads return the keyword dict to validate.
+ *
+ * @param reader The input, positioned after the map header.
+ * @param count The number of pairs.
+ * @param type The model class.
+ * @param load The load state.
+ * @param path Error path of the model, or nullptr at the top level.
+ * @return As for read_msgpack_typed.
+ */
+static PyObject *read_msgpack_model(MsgpackReader *reader, size_t count,
+                                    PyTypeObject *type, MsgpackLoad *load,
+                                    const ErrorPath *path) {
+  SchemaCache *schema = get_schema_cached((PyObject *)type);
+  if (!schema || Py_EnterRecursiveCall(" while reading msgpack data")) {
+    return nullptr;
+  }
+  PyObject *result =
+      load->trusted ? DataModel_alloc(type, schema) : PyDict_New();
+  bool failed = false;
+  for (size_t i = 0; result && i < count; i++) {
+    MsgpackToken key;
+    if (!read_msgpack_token(reader, &key)) {
+      Py_CLEAR(result);
+      break;
+    }
+    if (key.kind != MP_STR) {
+      PyErr_Format(PyExc_ValueError,
+                   "msgpack keys of %s must be strings (at offset %zu)",
+                   type->tp_name, reader->pos);
+      Py_CLEAR(result);
+      break;
+    }
+    Py_ssize_t index = FIELD_NOT_FOUND;
+    PyObject *name = nullptr;
+    if (schema->field_keys) {
+      const FieldKey *entry = lookup_field_key(schema, key.bytes, key.length);
+      if (entry) {
+        index = entry->field;
+        name = Py_NewRef(entry->key);
+      }
+    }
+    if (!name) {
+      name = PyUnicode_DecodeUTF8(key.bytes,
+                                  static_cast<Py_ssize_t>(key.length), nullptr);
+      if (!name) {
+        Py_CLEAR(result);
+        break;
+      }
+      if (!schema->field_keys) {
+        index = lookup_field_index(schema, name);
+      }
+    }
+
+    PyObject *value;
+    if (index >= 0) {
+      FieldSchema *fs = &schema->fields[index];
+      ErrorPath field_path(path, fs->field_name_c);
+      value = read_msgpack_typed(reader, fs->type_schema, load,
+                                 schema->deserializers, &field_path);
+    } else {
+      value = read_msgpack_value(reader);
+    }
+    if (!value) {
+      Py_DECREF(name);
+      if (PyErr_Occurred()) {
+        Py_CLEAR(result);
+        break;
+      }
+      if (load->trusted && index >= 0) {
+        // The instance is discarded; this only keeps the field from being
+        // reported as missing as well.
+        Py_XSETREF(DataModel_slots(result)[index], Py_NewRef(Py_None));
+      }
+      failed = true;
+      continue;
+    }
+
+    int status = 0;
+    if (!load->trusted) {
+      status = PyDict_SetItem(result, name, value);
+      Py_DECREF(value);
+    } else if (index >= 0) {
+      Py_XSETREF(DataModel_slots(result)[index], value);
+    } else {
+      const char *extra_name = PyUnicode_AsUTF8(name);
+      if (extra_name) {
+        status = DataModel_store_extra(result, extra_name, value);
+      } else {
+        Py_DECREF(value);
+        status = -1;
+      }
+    }
+    Py_DECREF(name);
+    if (status < 0) {
+      Py_CLEAR(result);
+    }
+  }
+  Py_LeaveRecursiveCall();
+  if (result && load->trusted) {
+    size_t initial_errors = load->collector->error_count();
+    if (DataModel_fill_missing_fields(result, schema, load->collector, path) <
+        0) {
+      Py_CLEAR(result);
+    }
+    failed = failed || load->collector->error_count() != initial_errors;
+  }
+  if (failed) {
+    Py_CLEAR(result);
+  }
+  return result;
+}
+
+/**
+ * @brief Create a model instance from msgpack data.
+ *
+ * @param cls The model class.
+ * @param data The msgpack input.
+ * @param size Length of the input in bytes.
+ * @param trusted Whether to store the fields without validating them.
+ * @return New instance, or nullptr on error.
+ */
+static PyObject *model_from_msgpack(PyObject *cls, const unsigned char *data,
+                                    size_t size, bool trusted) {
+  if (!PyType_Check(cls) ||
+      !PyType_IsSubtype((PyTypeObject *)cls, &DataModelType)) {
+    PyErr_SetString(PyExc_TypeError, "Expected a model class");
+    return nullptr;
+  }
+  PyTypeObject *type = reinterpret_cast<PyTypeObject *>(cls);
+  MsgpackReader reader = {data, size, 0};
+  MsgpackToken root;
+  if (!read_msgpack_token(&reader, &root)) {
+    return nullptr;
+  }
+  if (root.kind != MP_MAP) {
+    PyErr_SetString(PyExc_TypeError, "msgpack root must be a map");
+    return nullptr;
+  }
+
+  ErrorCollector collector;
+  MsgpackLoad load = {trusted, &collector};
+  PyObject *fields =
+      read_msgpack_model(&reader, root.length, type, &load, nullptr);
+  if (!fields) {
+    if (!PyErr_Occurred()) {
+      collector.raise();
+    }
+    return nullptr;
+  }
+  if (reader.pos != reader.size) {
+    Py_DECREF(fields);
+    PyErr_Format(PyExc_ValueError,
+                 "Unexpected data after the msgpack value at offset %zu",
+                 reader.pos);
+    return nullptr;
+  }
+  if (trusted) {
+    return fields;
+  }
+
+  PyObject *instance;
+  if (DataModel_supports_native_init(type)) {
+    SchemaCache *schema = get_schema_cached(cls);
+    instance = schema ? DataModel_alloc(type, schema) : nullptr;
+    if (instance && DataModel_init_with_schema(instance, fields, schema) != 0) {
+      Py_CLEAR(instance);
+    }
+  } else {
+    instance = PyObject_Call(cls, empty_tuple, fields);
+  }
+  Py_DECREF(fields);
+  return instance;
+}
+
+static const char *from_msgpack_kwlist[] = {"data", "trusted", nullptr};
+
+extern "C" {
+
+/**
+ * @brief Convert a DataModel instance to msgpack bytes.
+ *
+ * The output buffer is pre-sized from the schema's JSON size hint, which
+ * bounds the msgpack size of most models.
+ */
+PyObject *msgpack_utils_to_msgpack(PyObject *self,
+                                   PyObject *Py_UNUSED(ignored)) {
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return nullptr;
+  }
+  MsgpackWriter writer;
+  size_t hint = std::atomic_ref<size_t>(schema->json_size_hint)
+                    .load(std::memory_order_relaxed);
+  writer.reserve(hint > 0 ? hint : 256);
+  if (!write_msgpack_value(self, schema->json_serializer, writer)) {
+    return nullptr;
+  }
+  const std::string &out = writer.data();
+  return PyBytes_FromStringAndSize(out.data(),
+                                   static_cast<Py_ssize_t>(out.size()));
+}
+
+/**
+ * @brief Create a DataModel instance from msgpack bytes.
+ *
+ * The data may be bytes or any other object supporting the buffer protocol.
+ */
+PyObject *msgpack_utils_from_msgpack(PyObject *cls, PyObject *args,
+                                     PyObject *kwds) {
+  PyObject *data = nullptr;
+  int trusted = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|$p:from_msgpack",
+                                   const_cast<char **>(from_msgpack_kwlist),
+                                   &data, &trusted)) {
+    return nullptr;
+  }
+  if (PyBytes_Check(data)) {
+    return model_from_msgpack(
+        cls, reinterpret_cast<const unsigned char *>(PyBytes_AS_STRING(data)),
+        static_cast<size_t>(PyBytes_GET_SIZE(data)), trusted);
+  }
+  if (!PyObject_CheckBuffer(data)) {
+    PyErr_SetString(PyExc_TypeError, "Argument must be a bytes-like object");
+    return nullptr;
+  }
+  Py_buffer view;
+  if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) != 0) {
+    return nullptr;
+  }
+  PyObject *instance =
+      model_from_msgpack(cls, static_cast<const unsigned char *>(view.buf),
+                         static_cast<size_t>(view.len), trusted);
+  PyBuffer_Release(&view);
+  return instance;
+}
+
+} // extern "C"
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Python.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Convert a DataModel instance to msgpack bytes.
+ *
+ * Models are written as maps keyed by field name, like to_json, but ints,
+ * floats, bytes and containers keep their native msgpack types. Datetimes,
+ * UUIDs and other values msgpack has no type for are written as their str()
+ * text; values of other types go through the json_serializer of the model
+ * first.
+ *
+ * @param self The DataModel instance.
+ * @param Py_UNUSED(ignored) Unused parameter.
+ * @return A Python bytes object, or NULL on error.
+ */
+PyObject *msgpack_utils_to_msgpack(PyObject *self,
+                                   PyObject *Py_UNUSED(ignored));
+
+/**
+ * @brief Create a DataModel instance from msgpack bytes.
+ *
+ * Accepts the data as a bytes-like object and an optional keyword-only
+ * trusted flag. Values are read following the compiled schema, so arrays
+ * become the tuples and sets the fields expect. By default the instance is
+ * then validated as if built from a dict; with trusted=True the fields are
+ * stored as read, only converting the values that are not already of the
+ * field's exact type (datetimes, enums, ...), and validators are not run.
+ * Fields missing from the data get their defaults either way.
+ *
+ * @param cls The model class.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @return A new DataModel instance, or NULL on error.
+ */
+PyObject *msgpack_utils_from_msgpack(PyObject *cls, PyObject *args,
+                                     PyObject *kwds);
+
+#ifdef __cplusplus
+}
+#endif
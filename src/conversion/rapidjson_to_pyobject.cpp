@@ -5,6 +5,7 @@
 #include "rapidjson_to_pyobject.hpp"
 #include <Python.h>
 #include <rapidjson/document.h>
+#include <string.h>
 
 /**
  * @brief Converts a rapidjson::Value to a corresponding PyObject.
@@ -91,3 +92,58 @@ PyObject *rapidjson_to_pyobject(const rapidjson::Value &value) {
     return nullptr;
   }
 }
+
+/**
+ * @brief Converts a JSON object to the keyword dict of a model.
+ *
+ * @param value A JSON object.
+ * @param schema The compiled schema of the model, or nullptr.
+ * @return PyObject* A new reference on success, or nullptr on failure.
+ */
+PyObject *rapidjson_to_kwds(const rapidjson::Value &value,
+                            SchemaCache *schema) {
+  if (!value.IsObject() || !schema || !schema->field_keys) {
+    return rapidjson_to_pyobject(value);
+  }
+  PyObject *dict_obj = PyDict_New();
+  if (!dict_obj) {
+    return nullptr;
+  }
+  for (auto itr = value.MemberBegin(); itr != value.MemberEnd(); ++itr) {
+    const FieldKey *field_key = lookup_field_key(
+        schema, itr->name.GetString(), itr->name.GetStringLength());
+    PyObject *key_obj =
+        field_key ? Py_NewRef(field_key->key)
+                  : PyUnicode_FromStringAndSize(itr->name.GetString(),
+                                                itr->name.GetStringLength());
+    if (!key_obj) {
+      Py_DECREF(dict_obj);
+      return nullptr;
+    }
+    PyObject *val_obj = rapidjson_to_pyobject(itr->value);
+    if (!val_obj || PyDict_SetItem(dict_obj, key_obj, val_obj) < 0) {
+      Py_DECREF(key_obj);
+      Py_XDECREF(val_obj);
+      Py_DECREF(dict_obj);
+      return nullptr;
+    }
+    Py_DECREF(key_obj);
+    Py_DECREF(val_obj);
+  }
+  return dict_obj;
+}
+
+/**
+ * @brief Finds the last member of a JSON object with a given name.
+ */
+const rapidjson::Value *find_last_member(const rapidjson::Value &value,
+                                         const char *name, size_t len) {
+  const rapidjson::Value *found = nullptr;
+  for (auto itr = value.MemberBegin(); itr != value.MemberEnd(); ++itr) {
+    if (itr->name.GetStringLength() == len &&
+        memcmp(itr->name.GetString(), name, len) == 0) {
+      found = &itr->value;
+    }
+  }
+  return found;
+}
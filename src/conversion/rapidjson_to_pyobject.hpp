@@ -1,5 +1,6 @@
 #pragma once
 
+#include "schema/schema.hpp"
 #include <Python.h>
 #include <rapidjson/document.h>
 
@@ -10,3 +11,30 @@
  * @return PyObject* A new reference on success, or nullptr on failure.
  */
 PyObject *rapidjson_to_pyobject(const rapidjson::Value &value);
+
+/**
+ * @brief Converts a JSON object to the keyword dict of a model.
+ *
+ * Keys naming a field reuse the str of the field name or alias from the
+ * schema instead of allocating a new one.
+ *
+ * @param value A JSON object.
+ * @param schema The compiled schema of the model, or nullptr.
+ * @return PyObject* A new reference on success, or nullptr on failure.
+ */
+PyObject *rapidjson_to_kwds(const rapidjson::Value &value,
+                            SchemaCache *schema);
+
+/**
+ * @brief Finds the last member of a JSON object with a given name.
+ *
+ * rapidjson keeps repeated keys, and FindMember returns the first; the last
+ * one is the value json.loads and a dict would keep.
+ *
+ * @param value A JSON object.
+ * @param name The member name (not necessarily NUL-terminated).
+ * @param len Length of the name in bytes.
+ * @return Pointer to the member value, or nullptr if absent.
+ */
+const rapidjson::Value *find_last_member(const rapidjson::Value &value,
+                                         const char *name, size_t len);
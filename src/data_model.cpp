@@ -1,27 +1,43 @@
 #include <Python.h>
+#include <atomic>
 #include <functional>
+#include <rapidjson/error/en.h>
 #include <stdlib.h>
 #include <string.h>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "conversion/batch_utils.hpp"
+#include "conversion/columnar.hpp"
 #include "conversion/dict_utils.hpp"
+#include "conversion/json_parse.hpp"
+#include "conversion/json_lines.hpp"
 #include "conversion/json_utils.hpp"
+#include "conversion/msgpack_utils.hpp"
 #include "conversion/rapidjson_to_pyobject.hpp"
 #include "data_model.hpp"
 #include "error_handling.hpp"
 #include "init_globals.hpp"
 #include "schema/schema.hpp"
+#include "stats.hpp"
 #include "validation/validation.hpp"
+#include "validation/validation_native.hpp"
 #include "validation/validation_validators.hpp"
 
-PyObject *schema_key = nullptr;
+#if PY_VERSION_HEX < 0x030D0000
+// Per-object locks only exist, and are only needed, from Python 3.13.
+#define Py_BEGIN_CRITICAL_SECTION(op) {
+#define Py_END_CRITICAL_SECTION() }
+#endif
+
 static PyObject *field_prefix = nullptr;
 static PyObject *field_suffix = nullptr;
 PyObject *FieldType = nullptr;
 static PyObject *default_str = nullptr;
 static PyObject *default_factory_str = nullptr;
+static PyObject *restore_state_str = nullptr;
+static PyObject *copy_deepcopy = nullptr;
 
 /**
  * @brief Initialize globals for DataModel.
@@ -29,7 +45,6 @@ static PyObject *default_factory_str = nullptr;
  * @return int 0 on success, -1 on failure.
  */
 int init_data_model_globals(void) {
-  schema_key = PyUnicode_InternFromString("__vldt_schema__");
   field_prefix = PyUnicode_InternFromString("Field '");
   field_suffix = PyUnicode_InternFromString("': ");
 
@@ -47,75 +62,492 @@ int init_data_model_globals(void) {
     return -1;
   }
 
+  PyObject *copy_module = PyImport_ImportModule("copy");
+  if (!copy_module) {
+    return -1;
+  }
+  copy_deepcopy = PyObject_GetAttrString(copy_module, "deepcopy");
+  Py_DECREF(copy_module);
+  if (!copy_deepcopy) {
+    return -1;
+  }
+
   default_str = PyUnicode_InternFromString("default");
   default_factory_str = PyUnicode_InternFromString("default_factory");
+  restore_state_str = PyUnicode_InternFromString("_restore_state");
 
   return 0;
 }
 
 /**
- * @brief Check if expected_type is a ClassVar.
+ * @brief Store a field value in its slot.
  *
- * @param expected_type Python object representing the expected type.
- * @return int 1 if ClassVar, 0 otherwise.
+ * Releases any previously stored value in the same slot.
+ *
+ * @param self The model instance.
+ * @param index The field index.
+ * @param value The value to store (reference is stolen).
  */
-static int is_class_var(PyObject *expected_type) {
-  PyObject *origin = PyObject_GetAttrString(expected_type, "__origin__");
-  if (origin) {
-    int result = (origin == ClassVarType);
-    Py_DECREF(origin);
-    return result;
+static inline void store_field(PyObject *self, Py_ssize_t index,
+                               PyObject *value) {
+  PyObject **slot = &DataModel_slots(self)[index];
+  PyObject *old = *slot;
+  *slot = value;
+  Py_XDECREF(old);
+}
+
+/**
+ * @brief Return the overflow storage of an instance, allocating it.
+ *
+ * @param self The model instance.
+ * @return The storage, or nullptr with MemoryError set.
+ */
+static InstanceData *ensure_instance_data(PyObject *self) {
+  DataModelObject *bm_self = (DataModelObject *)self;
+  if (!bm_self->instance_data) {
+    bm_self->instance_data = new (std::nothrow) InstanceData();
+    if (!bm_self->instance_data) {
+      PyErr_NoMemory();
+    }
+  }
+  return bm_self->instance_data;
+}
+
+// Document that lazy models initialized from JSON may retain, if any.
+static thread_local const std::shared_ptr<rapidjson::Document>
+    *lazy_document = nullptr;
+
+LazyDocumentScope::LazyDocumentScope(
+    const std::shared_ptr<rapidjson::Document> &document)
+    : previous_(lazy_document) {
+  lazy_document = &document;
+}
+
+LazyDocumentScope::~LazyDocumentScope() { lazy_document = previous_; }
+
+/**
+ * @brief Release the raw input of a lazily validated instance.
+ *
+ * @param data The overflow storage of the instance, or nullptr.
+ */
+static void release_lazy_source(InstanceData *data) {
+  if (data && data->lazy) {
+    Py_XDECREF(data->lazy->kwds);
+    delete data->lazy;
+    data->lazy = nullptr;
+  }
+}
+
+/**
+ * @brief Make an instance lazy, keeping its input for later validation.
+ *
+ * Previously stored field values are dropped, so every field is pending.
+ *
+ * @param self The model instance.
+ * @param kwds The keyword dict, copied; or nullptr.
+ * @param native A JSON object of the active lazy document; or nullptr.
+ * @return int 0 on success, -1 on failure.
+ */
+static int retain_lazy_source(PyObject *self, PyObject *kwds,
+                              const rapidjson::Value *native) {
+  InstanceData *data = ensure_instance_data(self);
+  if (!data) {
+    return -1;
+  }
+  LazySource *lazy = new (std::nothrow) LazySource();
+  if (!lazy) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  if (kwds) {
+    lazy->kwds = PyDict_Copy(kwds);
+    if (!lazy->kwds) {
+      delete lazy;
+      return -1;
+    }
+  } else {
+    lazy->document = *lazy_document;
+    lazy->native = native;
+  }
+  release_lazy_source(data);
+  data->lazy = lazy;
+  PyObject **slots = DataModel_slots(self);
+  for (Py_ssize_t i = 0; i < DataModel_num_slots(self); i++) {
+    Py_CLEAR(slots[i]);
+  }
+  return 0;
+}
+
+/**
+ * @brief Store a non-annotated attribute in the overflow storage.
+ *
+ * The overflow map is allocated on first use.
+ *
+ * @param self The model instance.
+ * @param name The attribute name.
+ * @param value The value to store (reference is stolen).
+ * @return int 0 on success, -1 on failure.
+ */
+int DataModel_store_extra(PyObject *self, const char *name,
+                          PyObject *value) {
+  InstanceData *data = ensure_instance_data(self);
+  if (!data) {
+    Py_DECREF(value);
+    return -1;
+  }
+  auto &fields = data->fields;
+  auto it = fields.find(name);
+  if (it != fields.end()) {
+    Py_XDECREF(it->second);
+    it->second = value;
+  } else {
+    fields[name] = value;
+  }
+  return 0;
+}
+
+/**
+ * @brief Copy the builtin list, dict and set containers of a default value.
+ *
+ * Validation passes valid containers through unchanged, so mutable defaults
+ * are copied explicitly to keep instances from sharing them. Other objects
+ * are shared, as they were when validation rebuilt the containers.
+ *
+ * @param value The default value.
+ * @return New reference to the copy (or to value itself), nullptr on error.
+ */
+static PyObject *copy_mutable_default(PyObject *value) {
+  if (PyList_CheckExact(value)) {
+    Py_ssize_t size = PyList_GET_SIZE(value);
+    PyObject *copy = PyList_New(size);
+    for (Py_ssize_t i = 0; copy && i < size; i++) {
+      PyObject *item = copy_mutable_default(PyList_GET_ITEM(value, i));
+      if (!item) {
+        Py_CLEAR(copy);
+        break;
+      }
+      PyList_SET_ITEM(copy, i, item);
+    }
+    return copy;
+  }
+  if (PyDict_CheckExact(value)) {
+    PyObject *copy = PyDict_New();
+    PyObject *key, *item;
+    Py_ssize_t pos = 0;
+    while (copy && PyDict_Next(value, &pos, &key, &item)) {
+      PyObject *item_copy = copy_mutable_default(item);
+      if (!item_copy || PyDict_SetItem(copy, key, item_copy) < 0) {
+        Py_CLEAR(copy);
+      }
+      Py_XDECREF(item_copy);
+    }
+    return copy;
+  }
+  if (PySet_CheckExact(value)) {
+    return PySet_New(value);
+  }
+  Py_INCREF(value);
+  return value;
+}
+
+/**
+ * @brief Resolve the value of a field that is absent from the input.
+ *
+ * Falls back to default_factory, default_value, or None (for optional
+ * fields), recording an error when none of them applies.
+ *
+ * @param fs The field schema.
+ * @param collector The error collector.
+ * @param field_path The error path of the field.
+ * @return New reference to the value, or nullptr if an error was recorded.
+ */
+static PyObject *resolve_missing_field(FieldSchema *fs,
+                                       ErrorCollector *collector,
+                                       const ErrorPath *field_path) {
+  if (fs->default_factory != Py_None && PyCallable_Check(fs->default_factory)) {
+    PyObject *value =
+        PyObject_CallFunctionObjArgs(fs->default_factory, nullptr);
+    if (!value) {
+      PyErr_Clear();
+      collector->add_code(field_path, ERR_DEFAULT_FACTORY);
+    }
+    return value;
+  }
+  if (fs->default_value != VLDTUndefined) {
+    return copy_mutable_default(fs->default_value);
+  }
+  if (fs->type_schema->is_optional) {
+    Py_RETURN_NONE;
+  }
+  collector->add_code(field_path, ERR_MISSING);
+  return nullptr;
+}
+
+int DataModel_fill_missing_fields(PyObject *self, SchemaCache *schema,
+                                  ErrorCollector *collector,
+                                  const ErrorPath *prefix) {
+  PyObject **slots = DataModel_slots(self);
+  for (Py_ssize_t i = 0;
+       i < schema->num_fields && i < DataModel_num_slots(self); i++) {
+    if (!slots[i]) {
+      FieldSchema *fs = &schema->fields[i];
+      ErrorPath field_path(prefix, fs->field_name_c);
+      slots[i] = resolve_missing_field(fs, collector, &field_path);
+      if (!slots[i] && PyErr_Occurred()) {
+        return -1;
+      }
+    }
   }
-  PyErr_Clear();
   return 0;
 }
 
 /**
  * @brief DataModel.__new__ implementation.
  *
+ * Allocates one slot per schema field; the schema is compiled on the first
+ * instantiation of the class.
+ *
  * @param type Python type.
  * @param args Arguments.
  * @param kwds Keyword arguments.
  * @return PyObject* New instance.
  */
 PyObject *DataModel_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+  SchemaCache *schema = get_schema_cached((PyObject *)type);
+  if (!schema) {
+    return nullptr;
+  }
+  return DataModel_alloc(type, schema);
+}
+
+/**
+ * @brief Allocate a new instance with its slot array.
+ *
+ * @param type Python type.
+ * @param num_slots The number of field slots.
+ * @return PyObject* New instance with every slot unset, or nullptr.
+ */
+static PyObject *alloc_instance(PyTypeObject *type, Py_ssize_t num_slots) {
+  PyObject **slots = nullptr;
+  if (num_slots > 0) {
+    slots = (PyObject **)PyMem_Calloc(num_slots, sizeof(PyObject *));
+    if (!slots) {
+      return PyErr_NoMemory();
+    }
+  }
   DataModelObject *self = (DataModelObject *)type->tp_alloc(type, 0);
+  if (!self) {
+    PyMem_Free(slots);
+    return nullptr;
+  }
+  self->instance_data = nullptr;
+  self->weakreflist = nullptr;
+  self->num_slots = num_slots;
+  self->slots = slots;
+  return (PyObject *)self;
+}
+
+/**
+ * @brief Allocate an uninitialized instance for a known schema.
+ *
+ * @param type Python type.
+ * @param schema The compiled schema of the type.
+ * @return PyObject* New instance.
+ */
+PyObject *DataModel_alloc(PyTypeObject *type, SchemaCache *schema) {
+  DataModelObject *self = (DataModelObject *)schema->free_instances;
+  if (self && Py_TYPE(self) == type) {
+    // Recycled instances are linked through instance_data.
+    schema->free_instances = (PyObject *)self->instance_data;
+    schema->free_count--;
+    schema->instances_reused++;
+    self->instance_data = nullptr;
+    PyObject_Init((PyObject *)self, type);
+    if (PyType_IS_GC(type)) {
+      PyObject_GC_Track(self);
+    }
+    return (PyObject *)self;
+  }
+  self = (DataModelObject *)alloc_instance(type, schema->num_fields);
   if (self) {
-    self->instance_data = new InstanceData();
+#ifdef Py_GIL_DISABLED
+    std::atomic_ref<Py_ssize_t>(schema->instances_created)
+        .fetch_add(1, std::memory_order_relaxed);
+#else
+    schema->instances_created++;
+#endif
   }
   return (PyObject *)self;
 }
 
+/**
+ * @brief Keep the memory of a deallocated instance for reuse.
+ *
+ * Only instances allocated by PyType_GenericAlloc for the schema of their
+ * class are kept, with their slot array, up to the limit of the class.
+ * Recycled instances hold no reference to their class; the class frees them
+ * with its schema.
+ *
+ * @param self The instance, with its fields already released.
+ * @return true if the instance was recycled, false if it must be freed.
+ */
+static bool recycle_instance(PyObject *self) {
+#ifdef Py_GIL_DISABLED
+  (void)self;
+  return false;
+#else
+  PyTypeObject *type = Py_TYPE(self);
+  if (!PyObject_TypeCheck((PyObject *)type, &ModelMetaType) ||
+      type->tp_alloc != PyType_GenericAlloc) {
+    return false;
+  }
+  SchemaCache *schema = ((ModelTypeObject *)type)->schema;
+  if (!schema || schema->free_count >= schema->free_limit ||
+      DataModel_num_slots(self) != schema->num_fields) {
+    return false;
+  }
+  if (PyType_IS_GC(type) ? PyObject_GC_IsTracked(self) ||
+                               type->tp_free != PyObject_GC_Del
+                         : type->tp_free != PyObject_Free) {
+    return false;
+  }
+  DataModelObject *bm_self = (DataModelObject *)self;
+  bm_self->instance_data = (InstanceData *)schema->free_instances;
+  schema->free_instances = self;
+  schema->free_count++;
+  return true;
+#endif
+}
+
+/**
+ * @brief Free the recycled instances kept by a schema.
+ *
+ * @param schema The schema of a model class.
+ */
+void DataModel_clear_freelist(SchemaCache *schema) {
+  PyObject *self = schema->free_instances;
+  while (self) {
+    PyObject *next = (PyObject *)((DataModelObject *)self)->instance_data;
+    PyMem_Free(((DataModelObject *)self)->slots);
+    Py_TYPE(self)->tp_free(self);
+    self = next;
+  }
+  schema->free_instances = nullptr;
+  schema->free_count = 0;
+}
+
+/**
+ * @brief vldt.freelist_stats implementation.
+ *
+ * @param module The extension module.
+ * @param cls A DataModel subclass.
+ * @return PyObject* Dict of freelist counters.
+ */
+PyObject *DataModel_freelist_stats(PyObject *Py_UNUSED(module), PyObject *cls) {
+  if (!PyType_Check(cls) ||
+      !PyType_IsSubtype((PyTypeObject *)cls, &DataModelType)) {
+    PyErr_SetString(PyExc_TypeError, "Expected a DataModel subclass");
+    return nullptr;
+  }
+  SchemaCache *schema = get_schema_cached(cls);
+  if (!schema) {
+    return nullptr;
+  }
+  return Py_BuildValue("{s:n,s:n,s:n,s:n}", "size", schema->free_count,
+                       "limit", schema->free_limit, "reused",
+                       schema->instances_reused, "created",
+                       schema->instances_created);
+}
+
 /**
  * @brief DataModel.__dealloc__ implementation.
  *
+ * The memory of the instance is kept on the freelist of its class when
+ * there is room, and freed otherwise.
+ *
  * @param self Python object.
  */
 void DataModel_dealloc(PyObject *self) {
   DataModelObject *bm_self = (DataModelObject *)self;
-  for (auto &pair : bm_self->instance_data->fields) {
-    Py_XDECREF(pair.second);
+  if (bm_self->weakreflist) {
+    PyObject_ClearWeakRefs(self);
+  }
+  PyObject **slots = bm_self->slots;
+  for (Py_ssize_t i = 0; i < DataModel_num_slots(self); i++) {
+    Py_CLEAR(slots[i]);
+  }
+  if (bm_self->instance_data) {
+    for (auto &pair : bm_self->instance_data->fields) {
+      Py_XDECREF(pair.second);
+    }
+    release_lazy_source(bm_self->instance_data);
+    delete bm_self->instance_data;
+    bm_self->instance_data = nullptr;
+  }
+  if (!recycle_instance(self)) {
+    PyMem_Free(slots);
+    Py_TYPE(self)->tp_free(self);
   }
-  delete bm_self->instance_data;
-  Py_TYPE(self)->tp_free(self);
 }
 
+static PyObject *load_lazy_field(PyObject *self, SchemaCache *schema,
+                                 Py_ssize_t index);
+
 /**
  * @brief DataModel.__getattro__ implementation.
  *
+ * Declared fields are read from their slot via the schema's field index;
+ * pending fields of a lazy instance are validated on this first read. Other
+ * attributes come from the overflow storage or the generic lookup. Slots and
+ * the overflow storage are read under the lock of the instance, which only
+ * exists in free-threaded builds.
+ *
  * @param self Python object.
  * @param name Attribute name.
  * @return PyObject* Attribute value.
  */
 PyObject *DataModel_getattro(PyObject *self, PyObject *name) {
   DataModelObject *bm_self = (DataModelObject *)self;
-  InstanceData *data = bm_self->instance_data;
 
-  const char *attr_name = PyUnicode_AsUTF8(name);
-  auto it = data->fields.find(attr_name);
-  if (it != data->fields.end()) {
-    Py_INCREF(it->second);
-    return it->second;
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (schema) {
+    Py_ssize_t index = lookup_field_index(schema, name);
+    if (index >= 0 && index < DataModel_num_slots(self)) {
+      PyObject *value;
+      bool pending = false;
+      Py_BEGIN_CRITICAL_SECTION(self);
+      value = bm_self->slots[index];
+      if (value) {
+        Py_INCREF(value);
+      } else if (bm_self->instance_data && bm_self->instance_data->lazy) {
+        pending = true;
+        value = load_lazy_field(self, schema, index);
+      }
+      Py_END_CRITICAL_SECTION();
+      if (value || pending) {
+        return value;
+      }
+    }
+  }
+  PyErr_Clear();
+
+  if (bm_self->instance_data) {
+    const char *attr_name = PyUnicode_AsUTF8(name);
+    if (!attr_name) {
+      return nullptr;
+    }
+    PyObject *extra = nullptr;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    auto &fields = bm_self->instance_data->fields;
+    auto it = fields.find(attr_name);
+    if (it != fields.end()) {
+      extra = it->second;
+      Py_INCREF(extra);
+    }
+    Py_END_CRITICAL_SECTION();
+    if (extra) {
+      return extra;
+    }
   }
   return PyObject_GenericGetAttr(self, name);
 }
@@ -139,103 +571,109 @@ PyObject *DataModel_getattro(PyObject *self, PyObject *name) {
  * @return int 0 on success, -1 on failure.
  */
 int DataModel_init(PyObject *self, PyObject *args, PyObject *kwds) {
-  DataModelObject *bm_self = (DataModelObject *)self;
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return -1;
+  }
+  return DataModel_init_with_schema(self, kwds, schema);
+}
+
+/**
+ * @brief Find the keyword argument holding a field's value.
+ *
+ * Aliases are checked first, then the field name itself.
+ *
+ * @param kwds Keyword arguments, or nullptr.
+ * @param fs The field schema.
+ * @return Borrowed reference to the value, or nullptr if absent.
+ */
+static PyObject *find_kwds_value(PyObject *kwds, FieldSchema *fs) {
+  if (!kwds || !PyDict_Check(kwds)) {
+    return nullptr;
+  }
+  if (fs->alias && PyList_Check(fs->alias)) {
+    Py_ssize_t n_alias = PyList_Size(fs->alias);
+    for (Py_ssize_t j = 0; j < n_alias; j++) {
+      PyObject *value = PyDict_GetItem(kwds, PyList_GetItem(fs->alias, j));
+      if (value) {
+        return value;
+      }
+    }
+  }
+  return PyDict_GetItem(kwds, fs->field_name);
+}
 
+/**
+ * @brief Validate keyword arguments into the fields of an instance.
+ *
+ * Runs model BEFORE validators, the field loop (passing each input value
+ * through its field BEFORE validators) and, when no field failed, AFTER
+ * validators. Field errors are recorded in the given collector under
+ * prefix-qualified paths instead of being raised. Instances of lazy models
+ * only keep a copy of the arguments.
+ *
+ * @param self Python object.
+ * @param kwds Keyword arguments.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The error collector receiving field errors.
+ * @param prefix Error path of the instance, or nullptr at the top level.
+ * @return int 0 on success, 1 if field errors were recorded, -1 if a Python
+ * exception is set.
+ */
+static int init_fields_from_kwds(PyObject *self, PyObject *kwds,
+                                 SchemaCache *schema, ErrorCollector *collector,
+                                 const ErrorPath *prefix) {
   PyObject *cls = (PyObject *)Py_TYPE(self);
-  PyObject *capsule = get_schema_cached(cls);
-  if (!capsule) {
-    PyErr_SetString(PyExc_TypeError, "Could not compile model schema");
+  if (DataModel_num_slots(self) != schema->num_fields) {
+    PyErr_SetString(PyExc_TypeError,
+                    "Model instance does not match its schema");
     return -1;
   }
-  SchemaCache *schema =
-      (SchemaCache *)PyCapsule_GetPointer(capsule, "vldt.SchemaCache");
-  Py_DECREF(capsule);
-  if (!schema) {
-    PyErr_SetString(PyExc_TypeError, "Schema capsule is invalid");
-    return -1;
+
+  if (schema->lazy && kwds && PyDict_Check(kwds)) {
+    return retain_lazy_source(self, kwds, nullptr);
   }
 
   if (run_model_before_validators(schema, cls, &kwds) != 0) {
     return -1;
   }
-  if (run_field_before_validators(schema, cls, &kwds) != 0) {
-    return -1;
-  }
 
-  InstanceData *data = bm_self->instance_data;
-  ErrorCollector collector;
+  size_t initial_errors = collector->error_count();
   for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
     FieldSchema *fs = &schema->fields[i];
-    const char *field_path = fs->field_name_c;
-    PyObject *value = nullptr;
-
-    if (kwds && PyDict_Check(kwds)) {
-      if (fs->alias && PyList_Check(fs->alias)) {
-        Py_ssize_t n_alias = PyList_Size(fs->alias);
-        for (Py_ssize_t j = 0; j < n_alias; j++) {
-          PyObject *alias_key = PyList_GetItem(fs->alias, j);
-          value = PyDict_GetItem(kwds, alias_key);
-          if (value) {
-            Py_INCREF(value);
-            break;
-          }
-        }
-      }
+    ErrorPath field_path(prefix, fs->field_name_c);
+    PyObject *value = find_kwds_value(kwds, fs);
+    if (value) {
+      value = fs->before_validators.count
+                  ? run_field_before_validators(fs, cls, value)
+                  : Py_NewRef(value);
       if (!value) {
-        value = PyDict_GetItem(kwds, fs->field_name);
-        if (value) {
-          Py_INCREF(value);
-        }
+        return -1;
       }
     }
 
     if (!value) {
-      if (fs->default_factory != Py_None &&
-          PyCallable_Check(fs->default_factory)) {
-        value = PyObject_CallFunctionObjArgs(fs->default_factory, nullptr);
-        if (!value) {
-          collector.add_error(
-              field_path,
-              "Missing required field and default factory call failed");
-          continue;
-        }
-      } else if (fs->default_value != VLDTUndefined) {
-        value = fs->default_value;
-        Py_INCREF(value);
-      } else if (fs->type_schema->is_optional) {
-        Py_INCREF(Py_None);
-        value = Py_None;
-      } else {
-        collector.add_error(field_path, "Missing required field");
+      value = resolve_missing_field(fs, collector, &field_path);
+      if (!value) {
+        stats_count_field_failure(i);
         continue;
       }
     }
 
     PyObject *new_value = validate_and_convert(
-        value, fs->type_schema, &collector, field_path, schema->deserializers);
+        value, fs->type_schema, collector, &field_path, schema->deserializers);
     if (!new_value) {
-      auto &fields = data->fields;
-      if (fields.find(field_path) != fields.end()) {
-        Py_XDECREF(fields[field_path]);
-      }
-      Py_INCREF(value);
-      fields[field_path] = value;
+      stats_count_field_failure(i);
+      store_field(self, i, value);
       continue;
     } else {
       Py_DECREF(value);
-      value = new_value;
-      auto &fields = data->fields;
-      if (fields.find(field_path) != fields.end()) {
-        Py_XDECREF(fields[field_path]);
-      }
-      fields[field_path] = value;
+      store_field(self, i, new_value);
     }
   }
 
-  if (collector.has_errors()) {
-    std::string err_json = collector.to_json();
-    PyErr_SetString(PyExc_TypeError, err_json.c_str());
-    return -1;
+  if (collector->error_count() != initial_errors) {
+    return 1;
   }
 
   if (run_field_after_validators(schema, cls, self) != 0) {
@@ -248,137 +686,1401 @@ int DataModel_init(PyObject *self, PyObject *args, PyObject *kwds) {
 }
 
 /**
- * @brief DataModel.__setattro__ implementation.
+ * @brief Initialize an instance from keyword arguments with a known schema.
  *
  * @param self Python object.
- * @param name Attribute name.
- * @param value Attribute value.
+ * @param kwds Keyword arguments.
+ * @param schema The compiled schema of the instance's class.
  * @return int 0 on success, -1 on failure.
  */
-int DataModel_setattro(PyObject *self, PyObject *name, PyObject *value) {
-  DataModelObject *bm_self = (DataModelObject *)self;
-  InstanceData *data = bm_self->instance_data;
-
-  // Retrieve the cached schema for the model
-  PyObject *capsule = get_schema_cached((PyObject *)Py_TYPE(self));
-  if (!capsule) {
-    PyErr_SetString(PyExc_TypeError, "Could not retrieve model schema");
+int DataModel_init_with_schema(PyObject *self, PyObject *kwds,
+                               SchemaCache *schema) {
+  ErrorCollector collector;
+  ModelStatsScope stats_scope(schema, self);
+  int result = stats_scope.record(
+      init_fields_from_kwds(self, kwds, schema, &collector, nullptr));
+  if (result == 1) {
+    collector.raise();
     return -1;
   }
-  SchemaCache *schema =
-      (SchemaCache *)PyCapsule_GetPointer(capsule, "vldt.SchemaCache");
-  Py_DECREF(capsule);
-
-  // Use the instance annotations cached in the schema.
-  // (Ensure that schema->instance_annotations was set during schema
-  // compilation.)
-  PyObject *annotations = schema->instance_annotations;
-  Py_INCREF(annotations);
-
-  if (annotations && PyDict_Contains(annotations, name)) {
-    PyObject *expected_type = PyDict_GetItemWithError(annotations, name);
-    if (expected_type) {
-      if (is_class_var(expected_type)) {
-        PyErr_SetString(PyExc_AttributeError, "Cannot set ClassVar attribute");
-        Py_DECREF(annotations);
-        return -1;
-      } else {
-        // Compile a TypeSchema from the expected type
-        TypeSchema *ts = compile_type_schema(expected_type);
-        if (!ts) {
-          Py_DECREF(annotations);
-          return -1;
-        }
-        const char *attr_name = PyUnicode_AsUTF8(name);
-        ErrorCollector collector;
-        PyObject *converted = validate_and_convert(
-            value, ts, &collector, attr_name, schema->deserializers);
-        free_type_schema(ts);
-        if (!converted) {
-          if (collector.has_errors()) {
-            std::string err_json = collector.to_json();
-            PyErr_SetString(PyExc_TypeError, err_json.c_str());
-          } else {
-            PyErr_Format(PyExc_TypeError, "Invalid value for attribute %R",
-                         name);
-          }
-          Py_DECREF(annotations);
-          return -1;
-        }
-        // Use the converted value for assignment
-        value = converted;
-      }
-    }
-    // Update the instance data with the new value
-    const char *attr_name = PyUnicode_AsUTF8(name);
-    auto &fields = data->fields;
-    if (fields.find(attr_name) != fields.end()) {
-      Py_XDECREF(fields[attr_name]);
-    }
-    fields[attr_name] = value;
-    Py_DECREF(annotations);
-    return 0;
-  } else {
-    // If the attribute is not defined in the annotations, assign it directly
-    const char *attr_name = PyUnicode_AsUTF8(name);
-    auto &fields = data->fields;
-    if (fields.find(attr_name) != fields.end()) {
-      Py_XDECREF(fields[attr_name]);
-    }
-    Py_INCREF(value);
-    fields[attr_name] = value;
-    Py_DECREF(annotations);
-    return 0;
-  }
+  return result;
 }
 
 /**
- * @brief DataModel.__deepcopy__ implementation.
+ * @brief Initialize a nested instance from keyword arguments.
  *
  * @param self Python object.
- * @param args Arguments.
- * @return PyObject* Deep copied object.
+ * @param kwds Keyword arguments.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The collector of the enclosing validation.
+ * @param prefix Error path of the nested instance.
+ * @return int 0 on success, 1 if errors were recorded, -1 on exception.
  */
-static PyObject *DataModel_deepcopy(PyObject *self, PyObject *args) {
-  PyObject *memo;
-  if (!PyArg_ParseTuple(args, "O", &memo)) {
-    return nullptr;
-  }
+int DataModel_init_nested(PyObject *self, PyObject *kwds, SchemaCache *schema,
+                          ErrorCollector *collector,
+                          const ErrorPath *prefix) {
+  ModelStatsScope stats_scope(schema, self);
+  return stats_scope.record(
+      init_fields_from_kwds(self, kwds, schema, collector, prefix));
+}
 
-  PyTypeObject *type = Py_TYPE(self);
-  PyObject *new_obj = type->tp_alloc(type, 0);
-  if (!new_obj) {
-    return nullptr;
-  }
+/**
+ * @brief Check whether a model class can be initialized from a native value.
+ *
+ * @param type Python type.
+ * @return int 1 if the native initialization path applies, 0 otherwise.
+ */
+int DataModel_supports_native_init(PyTypeObject *type) {
+  return type->tp_new == DataModel_new && type->tp_init == DataModel_init;
+}
 
-  DataModelObject *src = (DataModelObject *)self;
-  DataModelObject *dst = (DataModelObject *)new_obj;
-  dst->instance_data = new InstanceData();
-
-  for (const auto &pair : src->instance_data->fields) {
-    PyObject *copied_field = nullptr;
-    PyObject *deepcopy_func =
-        PyObject_GetAttrString(pair.second, "__deepcopy__");
-    if (deepcopy_func == nullptr) {
-      if (PyErr_ExceptionMatches(PyExc_AttributeError)) {
+/**
+ * @brief Find the JSON member holding a field's value.
+ *
+ * Aliases are checked first, then the field name itself, matching the lookup
+ * order of DataModel_init; of repeated keys the last one wins, as in a dict.
+ *
+ * @param native The rapidjson object.
+ * @param fs The field schema.
+ * @return Pointer to the member value, or nullptr if absent.
+ */
+static const rapidjson::Value *
+find_native_member(const rapidjson::Value &native, FieldSchema *fs) {
+  Py_ssize_t len = 0;
+  const char *name = nullptr;
+  if (fs->alias && PyList_Check(fs->alias)) {
+    Py_ssize_t n_alias = PyList_GET_SIZE(fs->alias);
+    for (Py_ssize_t j = 0; j < n_alias; j++) {
+      PyObject *alias_key = PyList_GET_ITEM(fs->alias, j);
+      if (!PyUnicode_Check(alias_key)) {
+        continue;
+      }
+      name = PyUnicode_AsUTF8AndSize(alias_key, &len);
+      if (!name) {
         PyErr_Clear();
-        Py_INCREF(pair.second);
-        copied_field = pair.second;
-      } else {
-        Py_DECREF(new_obj);
-        return nullptr;
+        continue;
       }
-    } else {
-      copied_field = PyObject_CallFunctionObjArgs(deepcopy_func, memo, nullptr);
-      Py_DECREF(deepcopy_func);
-      if (copied_field == nullptr) {
-        Py_DECREF(new_obj);
-        return nullptr;
+      const rapidjson::Value *member =
+          find_last_member(native, name, static_cast<size_t>(len));
+      if (member) {
+        return member;
       }
     }
-    dst->instance_data->fields[pair.first] = copied_field;
   }
-  return new_obj;
+  name = PyUnicode_AsUTF8AndSize(fs->field_name, &len);
+  if (!name) {
+    PyErr_Clear();
+    return nullptr;
+  }
+  return find_last_member(native, name, static_cast<size_t>(len));
+}
+
+// Models with up to this many fields bind JSON members on the stack.
+static const Py_ssize_t kStackBoundFields = 32;
+
+/**
+ * @brief Find the JSON members holding the values of all fields.
+ *
+ * Walks the members of the object once, resolving each key through the key
+ * table of the schema, so no str is created for a key. When a field is named
+ * by several members, the one an alias lookup would find first wins, and of
+ * repeated keys the last one, as in the keyword dict of DataModel_init.
+ *
+ * @param native The rapidjson object.
+ * @param schema The compiled schema of the model.
+ * @param members Output: the member of each field, or nullptr if absent.
+ * @param priorities Scratch space of schema->num_fields entries.
+ */
+static void bind_native_members(const rapidjson::Value &native,
+                                SchemaCache *schema,
+                                const rapidjson::Value **members,
+                                Py_ssize_t *priorities) {
+  for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+    members[i] = nullptr;
+  }
+  if (!schema->field_keys) {
+    for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+      members[i] = find_native_member(native, &schema->fields[i]);
+    }
+    return;
+  }
+  for (auto itr = native.MemberBegin(); itr != native.MemberEnd(); ++itr) {
+    const FieldKey *key = lookup_field_key(schema, itr->name.GetString(),
+                                           itr->name.GetStringLength());
+    if (key &&
+        (!members[key->field] || key->priority <= priorities[key->field])) {
+      members[key->field] = &itr->value;
+      priorities[key->field] = key->priority;
+    }
+  }
+}
+
+/**
+ * @brief Validate the value of a field from its JSON member.
+ *
+ * A member with field BEFORE validators is converted to a Python value for
+ * them, then validated from that value.
+ *
+ * @param cls The model class.
+ * @param member The member holding the value, or nullptr if absent.
+ * @param fs The field schema.
+ * @param schema The compiled schema of the model.
+ * @param collector The error collector.
+ * @param field_path The error path of the field.
+ * @return New reference to the value, or nullptr on error.
+ */
+static PyObject *validate_native_field(PyObject *cls,
+                                       const rapidjson::Value *member,
+                                       FieldSchema *fs, SchemaCache *schema,
+                                       ErrorCollector *collector,
+                                       const ErrorPath *field_path) {
+  PyObject *value = nullptr;
+  if (member && fs->before_validators.count == 0) {
+    return validate_native_value(*member, fs->type_schema, collector,
+                                 field_path, schema->deserializers);
+  } else if (member) {
+    PyObject *raw = rapidjson_to_pyobject(*member);
+    if (!raw) {
+      return nullptr;
+    }
+    value = run_field_before_validators(fs, cls, raw);
+    Py_DECREF(raw);
+  } else {
+    value = resolve_missing_field(fs, collector, field_path);
+  }
+  if (!value) {
+    return nullptr;
+  }
+  PyObject *new_value = validate_and_convert(
+      value, fs->type_schema, collector, field_path, schema->deserializers);
+  Py_DECREF(value);
+  return new_value;
+}
+
+/**
+ * @brief Validate a pending field of a lazy instance from its raw input.
+ *
+ * @param self The model instance.
+ * @param schema The compiled schema of the instance's class.
+ * @param index The field index.
+ * @param collector The error collector receiving field errors.
+ * @param prefix Error path of the instance, or nullptr at the top level.
+ * @return int 0 on success, 1 if errors were recorded, -1 on exception.
+ */
+static int validate_lazy_field(PyObject *self, SchemaCache *schema,
+                               Py_ssize_t index, ErrorCollector *collector,
+                               const ErrorPath *prefix) {
+  LazySource *lazy = ((DataModelObject *)self)->instance_data->lazy;
+  FieldSchema *fs = &schema->fields[index];
+  ErrorPath field_path(prefix, fs->field_name_c);
+  size_t initial_errors = collector->error_count();
+  PyObject *new_value = nullptr;
+  if (lazy->native) {
+    // Nested lazy models may keep referring to the same document.
+    std::shared_ptr<rapidjson::Document> document = lazy->document;
+    LazyDocumentScope scope(document);
+    new_value = validate_native_field((PyObject *)Py_TYPE(self),
+                                      find_native_member(*lazy->native, fs),
+                                      fs, schema, collector, &field_path);
+  } else {
+    PyObject *value = find_kwds_value(lazy->kwds, fs);
+    Py_XINCREF(value);
+    if (!value) {
+      value = resolve_missing_field(fs, collector, &field_path);
+    }
+    if (value) {
+      new_value = validate_and_convert(value, fs->type_schema, collector,
+                                       &field_path, schema->deserializers);
+      Py_DECREF(value);
+    }
+  }
+  if (new_value) {
+    store_field(self, index, new_value);
+    return 0;
+  }
+  if (collector->error_count() != initial_errors) {
+    return 1;
+  }
+  if (!PyErr_Occurred()) {
+    PyErr_Format(PyExc_TypeError, "Invalid value for field '%s'",
+                 fs->field_name_c);
+  }
+  return -1;
+}
+
+/**
+ * @brief Validate and return a pending field of a lazy instance.
+ *
+ * @param self The model instance.
+ * @param schema The compiled schema of the instance's class.
+ * @param index The field index.
+ * @return New reference to the value, or nullptr with ValidationError (or
+ * another exception) set.
+ */
+static PyObject *load_lazy_field(PyObject *self, SchemaCache *schema,
+                                 Py_ssize_t index) {
+  ErrorCollector collector;
+  int result = validate_lazy_field(self, schema, index, &collector, nullptr);
+  if (result != 0) {
+    if (result == 1) {
+      collector.raise();
+    }
+    return nullptr;
+  }
+  PyObject *value = DataModel_slots(self)[index];
+  Py_INCREF(value);
+  return value;
+}
+
+/**
+ * @brief Validate every pending field of a lazy instance, under its lock.
+ *
+ * The raw input is released once all fields are valid.
+ *
+ * @param self The model instance; the caller holds its lock.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The error collector receiving field errors.
+ * @param prefix Error path of the instance, or nullptr at the top level.
+ * @return int 0 on success or recorded errors, -1 on exception.
+ */
+static int validate_pending_fields_locked(PyObject *self, SchemaCache *schema,
+                                          ErrorCollector *collector,
+                                          const ErrorPath *prefix) {
+  InstanceData *data = ((DataModelObject *)self)->instance_data;
+  if (!data || !data->lazy) {
+    return 0;
+  }
+  PyObject **slots = DataModel_slots(self);
+  size_t initial_errors = collector->error_count();
+  for (Py_ssize_t i = 0;
+       i < schema->num_fields && i < DataModel_num_slots(self); i++) {
+    if (!slots[i] &&
+        validate_lazy_field(self, schema, i, collector, prefix) < 0) {
+      return -1;
+    }
+  }
+  if (collector->error_count() == initial_errors) {
+    release_lazy_source(data);
+  }
+  return 0;
+}
+
+/**
+ * @brief Validate every pending field of a lazy instance.
+ *
+ * Takes the lock of the instance, as getattro does to load one field, so
+ * no other thread reads the raw input while it is released.
+ *
+ * @param self The model instance.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The error collector receiving field errors.
+ * @param prefix Error path of the instance, or nullptr at the top level.
+ * @return int 0 on success or recorded errors, -1 on exception.
+ */
+static int validate_pending_fields(PyObject *self, SchemaCache *schema,
+                                   ErrorCollector *collector,
+                                   const ErrorPath *prefix) {
+  int result;
+  Py_BEGIN_CRITICAL_SECTION(self);
+  result = validate_pending_fields_locked(self, schema, collector, prefix);
+  Py_END_CRITICAL_SECTION();
+  return result;
+}
+
+/**
+ * @brief Validate the pending fields of a lazy instance.
+ *
+ * The instance is checked for pending fields under its lock.
+ *
+ * @param self The model instance.
+ * @return int 0 on success, -1 on failure.
+ */
+int DataModel_validate_pending(PyObject *self) {
+  ErrorCollector collector;
+  int result = 0;
+  Py_BEGIN_CRITICAL_SECTION(self);
+  InstanceData *data = ((DataModelObject *)self)->instance_data;
+  if (data && data->lazy) {
+    SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+    result = schema ? validate_pending_fields_locked(self, schema, &collector,
+                                                     nullptr)
+                    : -1;
+  }
+  Py_END_CRITICAL_SECTION();
+  if (result < 0) {
+    return -1;
+  }
+  if (collector.has_errors()) {
+    collector.raise();
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Initialize a DataModel instance from a native JSON object.
+ *
+ * Each field is validated straight from the rapidjson DOM, so only the final
+ * Python values are created. When the model has BEFORE validators, which
+ * operate on the keyword dict, the object is converted to a dict and the
+ * regular DataModel_init path is used instead.
+ *
+ * @param self Python object.
+ * @param native The rapidjson DOM element representing the JSON object.
+ * @return int 0 on success, -1 on failure.
+ */
+int DataModel_init_from_native(PyObject *self, const rapidjson::Value &native) {
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return -1;
+  }
+  return DataModel_init_native_with_schema(self, native, schema);
+}
+
+/**
+ * @brief Validate a native JSON object into the fields of an instance.
+ *
+ * Native counterpart of init_fields_from_kwds. The members are bound to the
+ * fields in one pass over the object. When the model has model BEFORE
+ * validators, which operate on the keyword dict, the object is converted to
+ * a dict and validated through init_fields_from_kwds instead. Instances of
+ * lazy models keep the object when a LazyDocumentScope owns it.
+ *
+ * @param self Python object.
+ * @param native The rapidjson DOM element representing the JSON object.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The error collector receiving field errors.
+ * @param prefix Error path of the instance, or nullptr at the top level.
+ * @return int 0 on success, 1 if field errors were recorded, -1 if a Python
+ * exception is set.
+ */
+static int init_fields_from_native(PyObject *self,
+                                   const rapidjson::Value &native,
+                                   SchemaCache *schema,
+                                   ErrorCollector *collector,
+                                   const ErrorPath *prefix) {
+  if (!native.IsObject()) {
+    PyErr_SetString(PyExc_TypeError, "JSON root must be an object");
+    return -1;
+  }
+  PyObject *cls = (PyObject *)Py_TYPE(self);
+  if (DataModel_num_slots(self) != schema->num_fields) {
+    PyErr_SetString(PyExc_TypeError,
+                    "Model instance does not match its schema");
+    return -1;
+  }
+
+  if (schema->has_model_before) {
+    PyObject *kwds = rapidjson_to_kwds(native, schema);
+    if (!kwds) {
+      return -1;
+    }
+    int result = init_fields_from_kwds(self, kwds, schema, collector, prefix);
+    Py_DECREF(kwds);
+    return result;
+  }
+
+  if (schema->lazy && lazy_document && *lazy_document) {
+    return retain_lazy_source(self, nullptr, &native);
+  }
+
+  const rapidjson::Value *stack_members[kStackBoundFields];
+  Py_ssize_t stack_priorities[kStackBoundFields];
+  std::vector<const rapidjson::Value *> heap_members;
+  std::vector<Py_ssize_t> heap_priorities;
+  const rapidjson::Value **members = stack_members;
+  Py_ssize_t *priorities = stack_priorities;
+  if (schema->num_fields > kStackBoundFields) {
+    heap_members.resize(schema->num_fields);
+    heap_priorities.resize(schema->num_fields);
+    members = heap_members.data();
+    priorities = heap_priorities.data();
+  }
+  bind_native_members(native, schema, members, priorities);
+
+  size_t initial_errors = collector->error_count();
+  for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+    FieldSchema *fs = &schema->fields[i];
+    ErrorPath field_path(prefix, fs->field_name_c);
+    PyObject *new_value = validate_native_field(cls, members[i], fs, schema,
+                                                collector, &field_path);
+    if (new_value) {
+      store_field(self, i, new_value);
+    } else if (PyErr_Occurred()) {
+      return -1;
+    } else {
+      stats_count_field_failure(i);
+    }
+  }
+
+  if (collector->error_count() != initial_errors) {
+    return 1;
+  }
+
+  if (run_field_after_validators(schema, cls, self) != 0) {
+    return -1;
+  }
+  if (run_model_after_validators(schema, cls, self) != 0) {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Initialize an instance from a native JSON object with a known
+ * schema.
+ *
+ * @param self Python object.
+ * @param native The rapidjson DOM element representing the JSON object.
+ * @param schema The compiled schema of the instance's class.
+ * @return int 0 on success, -1 on failure.
+ */
+int DataModel_init_native_with_schema(PyObject *self,
+                                      const rapidjson::Value &native,
+                                      SchemaCache *schema) {
+  ErrorCollector collector;
+  ModelStatsScope stats_scope(schema, self);
+  int result = stats_scope.record(
+      init_fields_from_native(self, native, schema, &collector, nullptr));
+  if (result == 1) {
+    collector.raise();
+    return -1;
+  }
+  return result;
+}
+
+/**
+ * @brief Initialize a nested instance from a native JSON object.
+ *
+ * @param self Python object.
+ * @param native The rapidjson DOM element representing the JSON object.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The collector of the enclosing validation.
+ * @param prefix Error path of the nested instance.
+ * @return int 0 on success, 1 if errors were recorded, -1 on exception.
+ */
+int DataModel_init_native_nested(PyObject *self, const rapidjson::Value &native,
+                                 SchemaCache *schema, ErrorCollector *collector,
+                                 const ErrorPath *prefix) {
+  ModelStatsScope stats_scope(schema, self);
+  return stats_scope.record(
+      init_fields_from_native(self, native, schema, collector, prefix));
+}
+
+/**
+ * @brief DataModel.__setattro__ implementation.
+ *
+ * Declared fields are validated against the TypeSchema compiled with the
+ * model, found through the schema's field index; ClassVar annotations are
+ * rejected. Other attributes are stored without validation. Stores take the
+ * lock of the instance, as in DataModel_getattro.
+ *
+ * @param self Python object.
+ * @param name Attribute name.
+ * @param value Attribute value, or nullptr to delete the attribute.
+ * @return int 0 on success, -1 on failure.
+ */
+int DataModel_setattro(PyObject *self, PyObject *name, PyObject *value) {
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return -1;
+  }
+
+  Py_ssize_t index = lookup_field_index(schema, name);
+  if (index == FIELD_CLASS_VAR) {
+    PyErr_SetString(PyExc_AttributeError, "Cannot set ClassVar attribute");
+    return -1;
+  }
+  const char *attr_name = PyUnicode_AsUTF8(name);
+  if (!attr_name) {
+    return -1;
+  }
+
+  if (!value) {
+    PyObject *removed = nullptr;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    InstanceData *data = ((DataModelObject *)self)->instance_data;
+    if (index == FIELD_NOT_FOUND && data) {
+      auto it = data->fields.find(attr_name);
+      if (it != data->fields.end()) {
+        removed = it->second;
+        data->fields.erase(it);
+      }
+    }
+    Py_END_CRITICAL_SECTION();
+    if (removed) {
+      Py_DECREF(removed);
+      return 0;
+    }
+    PyErr_Format(PyExc_AttributeError, "Cannot delete attribute %R", name);
+    return -1;
+  }
+
+  if (index >= 0 && index < DataModel_num_slots(self)) {
+    FieldSchema *fs = &schema->fields[index];
+    ErrorCollector collector;
+    ErrorPath field_path(nullptr, fs->field_name_c);
+    PyObject *converted =
+        validate_and_convert(value, fs->type_schema, &collector, &field_path,
+                             schema->deserializers);
+    if (!converted) {
+      if (collector.has_errors()) {
+        collector.raise();
+      } else {
+        PyErr_Format(PyExc_TypeError, "Invalid value for attribute %R", name);
+      }
+      return -1;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    store_field(self, index, converted);
+    Py_END_CRITICAL_SECTION();
+    return 0;
+  }
+
+  // If the attribute is not a declared field, assign it directly
+  int status;
+  Py_INCREF(value);
+  Py_BEGIN_CRITICAL_SECTION(self);
+  status = DataModel_store_extra(self, attr_name, value);
+  Py_END_CRITICAL_SECTION();
+  return status;
+}
+
+/**
+ * @brief Check whether a value is immutable, so copies may share it.
+ *
+ * Covers None and exact bools, ints, floats, strs and bytes, and exact
+ * tuples holding only such values.
+ *
+ * @param value The value to check.
+ * @return true if the value can be shared by a deep copy.
+ */
+static inline bool is_immutable_value(PyObject *value) {
+  auto is_atomic = [](PyObject *item) {
+    return item == Py_None || PyBool_Check(item) || PyLong_CheckExact(item) ||
+           PyFloat_CheckExact(item) || PyUnicode_CheckExact(item) ||
+           PyBytes_CheckExact(item);
+  };
+  if (is_atomic(value)) {
+    return true;
+  }
+  if (!PyTuple_CheckExact(value)) {
+    return false;
+  }
+  for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(value); i++) {
+    if (!is_atomic(PyTuple_GET_ITEM(value, i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Deep copy a single attribute value.
+ *
+ * Immutable values are shared with the copy; others go through
+ * copy.deepcopy with the memo.
+ *
+ * @param value The value to copy.
+ * @param memo The deepcopy memo dictionary.
+ * @return New reference to the copy, or nullptr on error.
+ */
+static PyObject *deepcopy_value(PyObject *value, PyObject *memo) {
+  if (is_immutable_value(value)) {
+    return Py_NewRef(value);
+  }
+  return PyObject_CallFunctionObjArgs(copy_deepcopy, value, memo, nullptr);
+}
+
+/**
+ * @brief Copy an instance, sharing or deep copying its values.
+ *
+ * The field and extra attribute references are taken together, then each
+ * value of the copy is replaced by its deep copy if a memo is given. The
+ * copy is recorded in the memo first, so values referring back to the
+ * instance refer to the copy.
+ *
+ * @param self The instance, without pending fields.
+ * @param schema The compiled schema of its class.
+ * @param memo The deepcopy memo dict, or nullptr for a shallow copy.
+ * @return New reference to the copy, or nullptr on error.
+ */
+static PyObject *copy_instance(PyObject *self, SchemaCache *schema,
+                               PyObject *memo) {
+  PyTypeObject *type = Py_TYPE(self);
+  PyObject *new_obj = DataModel_num_slots(self) == schema->num_fields
+                          ? DataModel_alloc(type, schema)
+                          : alloc_instance(type, DataModel_num_slots(self));
+  if (!new_obj) {
+    return nullptr;
+  }
+  DataModelObject *src = (DataModelObject *)self;
+  DataModelObject *dst = (DataModelObject *)new_obj;
+
+  int status = 0;
+  Py_BEGIN_CRITICAL_SECTION(self);
+  for (Py_ssize_t i = 0; i < DataModel_num_slots(self); i++) {
+    dst->slots[i] = Py_XNewRef(src->slots[i]);
+  }
+  if (src->instance_data) {
+    for (const auto &pair : src->instance_data->fields) {
+      status = DataModel_store_extra(new_obj, pair.first.c_str(),
+                                     Py_NewRef(pair.second));
+      if (status < 0) {
+        break;
+      }
+    }
+  }
+  Py_END_CRITICAL_SECTION();
+  if (status < 0 || !memo) {
+    if (status < 0) {
+      Py_CLEAR(new_obj);
+    }
+    return new_obj;
+  }
+
+  PyObject *self_id = PyLong_FromVoidPtr(self);
+  if (!self_id || PyDict_SetItem(memo, self_id, new_obj) < 0) {
+    Py_XDECREF(self_id);
+    Py_DECREF(new_obj);
+    return nullptr;
+  }
+  Py_DECREF(self_id);
+  for (Py_ssize_t i = 0; i < DataModel_num_slots(new_obj); i++) {
+    if (dst->slots[i]) {
+      PyObject *copied_field = deepcopy_value(dst->slots[i], memo);
+      if (!copied_field) {
+        Py_DECREF(new_obj);
+        return nullptr;
+      }
+      Py_SETREF(dst->slots[i], copied_field);
+    }
+  }
+  if (dst->instance_data) {
+    for (auto &pair : dst->instance_data->fields) {
+      PyObject *copied_field = deepcopy_value(pair.second, memo);
+      if (!copied_field) {
+        Py_DECREF(new_obj);
+        return nullptr;
+      }
+      Py_SETREF(pair.second, copied_field);
+    }
+  }
+  return new_obj;
+}
+
+/**
+ * @brief DataModel.__deepcopy__ implementation.
+ *
+ * @param self Python object.
+ * @param args Arguments.
+ * @return PyObject* Deep copied object.
+ */
+static PyObject *DataModel_deepcopy(PyObject *self, PyObject *args) {
+  PyObject *memo;
+  if (!PyArg_ParseTuple(args, "O!", &PyDict_Type, &memo)) {
+    return nullptr;
+  }
+  if (DataModel_validate_pending(self) < 0) {
+    return nullptr;
+  }
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return nullptr;
+  }
+  return copy_instance(self, schema, memo);
+}
+
+/**
+ * @brief Validate and store the fields of a model_copy update.
+ *
+ * Fields are validated as by attribute assignment, with the errors of all
+ * fields raised together; other names become extra attributes.
+ *
+ * @param self The copy being updated.
+ * @param schema The compiled schema of its class.
+ * @param update Dict mapping attribute names to new values.
+ * @return 0 on success, -1 on failure.
+ */
+static int apply_model_update(PyObject *self, SchemaCache *schema,
+                              PyObject *update) {
+  ErrorCollector collector;
+  PyObject *name, *value;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(update, &pos, &name, &value)) {
+    if (!PyUnicode_Check(name)) {
+      PyErr_SetString(PyExc_TypeError, "update keys must be strings");
+      return -1;
+    }
+    Py_ssize_t index = lookup_field_index(schema, name);
+    if (index == FIELD_CLASS_VAR) {
+      PyErr_SetString(PyExc_AttributeError, "Cannot set ClassVar attribute");
+      return -1;
+    }
+    if (index < 0 || index >= DataModel_num_slots(self)) {
+      const char *attr_name = PyUnicode_AsUTF8(name);
+      if (!attr_name ||
+          DataModel_store_extra(self, attr_name, Py_NewRef(value)) < 0) {
+        return -1;
+      }
+      continue;
+    }
+    FieldSchema *fs = &schema->fields[index];
+    ErrorPath field_path(nullptr, fs->field_name_c);
+    PyObject *converted =
+        validate_and_convert(value, fs->type_schema, &collector, &field_path,
+                             schema->deserializers);
+    if (converted) {
+      store_field(self, index, converted);
+    } else if (PyErr_Occurred()) {
+      return -1;
+    } else if (!collector.has_errors()) {
+      PyErr_Format(PyExc_TypeError, "Invalid value for attribute %R", name);
+      return -1;
+    }
+  }
+  if (collector.has_errors()) {
+    collector.raise();
+    return -1;
+  }
+  return 0;
+}
+
+static const char *model_copy_kwlist[] = {"update", "deep", nullptr};
+
+/**
+ * @brief DataModel.model_copy implementation.
+ *
+ * Copies the instance, sharing its validated values unless deep is set,
+ * and then validates and stores only the fields given in update.
+ *
+ * @param self Python object.
+ * @param args Arguments.
+ * @param kwds Keyword arguments: update (a dict or None) and deep.
+ * @return PyObject* The copy.
+ */
+static PyObject *DataModel_model_copy(PyObject *self, PyObject *args,
+                                      PyObject *kwds) {
+  PyObject *update = Py_None;
+  int deep = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|$Op:model_copy",
+                                   const_cast<char **>(model_copy_kwlist),
+                                   &update, &deep)) {
+    return nullptr;
+  }
+  if (update != Py_None && !PyDict_Check(update)) {
+    PyErr_SetString(PyExc_TypeError, "update must be a dict or None");
+    return nullptr;
+  }
+  if (DataModel_validate_pending(self) < 0) {
+    return nullptr;
+  }
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return nullptr;
+  }
+  PyObject *memo = deep ? PyDict_New() : nullptr;
+  if (deep && !memo) {
+    return nullptr;
+  }
+  PyObject *copy = copy_instance(self, schema, memo);
+  Py_XDECREF(memo);
+  if (copy && update != Py_None &&
+      apply_model_update(copy, schema, update) < 0) {
+    Py_CLEAR(copy);
+  }
+  return copy;
+}
+
+/**
+ * @brief A patched copy of an instance, waiting to be committed.
+ */
+struct StagedPatch {
+  PyObject *target; // The patched instance (borrowed).
+  PyObject *staged; // Copy of target holding the patched values.
+  PyObject *parent; // Staged copy of the model holding target, or nullptr.
+  Py_ssize_t index; // Slot of target in parent.
+};
+
+/**
+ * @brief Return the model class a field holds, if any.
+ *
+ * @param ts The TypeSchema of the field.
+ * @return The DataModel subclass of a model or optional model field, or
+ * nullptr.
+ */
+static PyObject *patch_model_type(TypeSchema *ts) {
+  if (ts->op == OP_OPTIONAL) {
+    ts = ts->optional_target;
+  }
+  return ts->op == OP_MODEL ? ts->expected_type : nullptr;
+}
+
+/**
+ * @brief Merge a patch into a dict as RFC 7386 describes.
+ *
+ * None values remove their key, dicts are merged into the dicts they
+ * replace and other values replace the current ones.
+ *
+ * @param target The current dict.
+ * @param patch The patch dict.
+ * @return New reference to the merged dict, or nullptr on error.
+ */
+static PyObject *merge_patch_dict(PyObject *target, PyObject *patch) {
+  PyObject *merged = PyDict_Copy(target);
+  if (!merged) {
+    return nullptr;
+  }
+  PyObject *key, *value;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(patch, &pos, &key, &value)) {
+    int status;
+    if (value == Py_None) {
+      status = PyDict_Contains(merged, key);
+      if (status > 0) {
+        status = PyDict_DelItem(merged, key);
+      }
+    } else {
+      PyObject *current = PyDict_GetItemWithError(merged, key);
+      if (!current && PyErr_Occurred()) {
+        Py_DECREF(merged);
+        return nullptr;
+      }
+      if (current && PyDict_Check(current) && PyDict_Check(value)) {
+        PyObject *nested = merge_patch_dict(current, value);
+        status = nested ? PyDict_SetItem(merged, key, nested) : -1;
+        Py_XDECREF(nested);
+      } else {
+        status = PyDict_SetItem(merged, key, value);
+      }
+    }
+    if (status < 0) {
+      Py_DECREF(merged);
+      return nullptr;
+    }
+  }
+  return merged;
+}
+
+/**
+ * @brief Find the field named by a patch key.
+ *
+ * Patches use the same keys as init and from_json: the field name or one
+ * of its aliases.
+ *
+ * @param schema The compiled schema.
+ * @param key The patch key, a str.
+ * @return The index into SchemaCache::fields, FIELD_CLASS_VAR for ClassVar
+ * annotations, or FIELD_NOT_FOUND otherwise. No Python exception is left set.
+ */
+static Py_ssize_t lookup_patch_key(SchemaCache *schema, PyObject *key) {
+  Py_ssize_t index = lookup_field_index(schema, key);
+  if (index != FIELD_NOT_FOUND) {
+    return index;
+  }
+  if (schema->field_keys) {
+    Py_ssize_t len = 0;
+    const char *text = PyUnicode_AsUTF8AndSize(key, &len);
+    if (!text) {
+      PyErr_Clear();
+      return FIELD_NOT_FOUND;
+    }
+    const FieldKey *entry =
+        lookup_field_key(schema, text, static_cast<size_t>(len));
+    return entry ? entry->field : FIELD_NOT_FOUND;
+  }
+  for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+    PyObject *alias = schema->fields[i].alias;
+    if (alias && PyList_Check(alias)) {
+      int found = PySequence_Contains(alias, key);
+      if (found < 0) {
+        PyErr_Clear();
+      } else if (found) {
+        return i;
+      }
+    }
+  }
+  return FIELD_NOT_FOUND;
+}
+
+/**
+ * @brief Validate a patch into a copy of an instance.
+ *
+ * Only the fields named by the patch are validated, as by attribute
+ * assignment; the other slots of the copy share the current values. A dict
+ * given for a field holding a model is staged recursively into a copy of
+ * that model and a dict given for a dict field is merged into it. None
+ * removes an extra attribute and is validated like any value for fields.
+ * With Config.patch_validators the validators then run on the copy.
+ *
+ * @param target The instance to patch.
+ * @param schema The compiled schema of its class.
+ * @param patch Dict mapping attribute names to new values.
+ * @param collector Collects the validation errors.
+ * @param path Path of target from the patched instance, or nullptr.
+ * @param staged Receives the copies, target's first; they own a reference.
+ * @param parent Staged copy of the model holding target, or nullptr.
+ * @param index Slot of target in parent.
+ * @return 0 on success (errors may have been collected), -1 on failure.
+ */
+static int stage_patch(PyObject *target, SchemaCache *schema, PyObject *patch,
+                       ErrorCollector *collector, const ErrorPath *path,
+                       std::vector<StagedPatch> *staged, PyObject *parent,
+                       Py_ssize_t index) {
+  for (const StagedPatch &entry : *staged) {
+    if (entry.target == target) {
+      PyErr_SetString(PyExc_ValueError,
+                      "patch reaches the same model instance twice");
+      return -1;
+    }
+  }
+  if (DataModel_validate_pending(target) < 0) {
+    return -1;
+  }
+  PyObject *copy = copy_instance(target, schema, nullptr);
+  if (!copy) {
+    return -1;
+  }
+  staged->push_back({target, copy, parent, index});
+
+  PyObject *cls = (PyObject *)Py_TYPE(target);
+  size_t initial_errors = collector->error_count();
+  PyObject *name, *value;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(patch, &pos, &name, &value)) {
+    if (!PyUnicode_Check(name)) {
+      PyErr_SetString(PyExc_TypeError, "patch keys must be strings");
+      return -1;
+    }
+    Py_ssize_t i = lookup_patch_key(schema, name);
+    if (i == FIELD_CLASS_VAR) {
+      PyErr_SetString(PyExc_AttributeError, "Cannot set ClassVar attribute");
+      return -1;
+    }
+    if (i < 0 || i >= DataModel_num_slots(copy)) {
+      const char *attr_name = PyUnicode_AsUTF8(name);
+      if (!attr_name) {
+        return -1;
+      }
+      if (value != Py_None) {
+        if (DataModel_store_extra(copy, attr_name, Py_NewRef(value)) < 0) {
+          return -1;
+        }
+        continue;
+      }
+      InstanceData *data = ((DataModelObject *)copy)->instance_data;
+      if (data) {
+        auto it = data->fields.find(attr_name);
+        if (it != data->fields.end()) {
+          Py_DECREF(it->second);
+          data->fields.erase(it);
+        }
+      }
+      continue;
+    }
+
+    FieldSchema *fs = &schema->fields[i];
+    ErrorPath field_path(path, fs->field_name_c);
+    PyObject *current = DataModel_slots(copy)[i];
+    PyObject *model_type = patch_model_type(fs->type_schema);
+    if (PyDict_Check(value) && current && model_type &&
+        PyObject_TypeCheck(current, (PyTypeObject *)model_type)) {
+      SchemaCache *nested_schema =
+          get_schema_cached((PyObject *)Py_TYPE(current));
+      size_t entry = staged->size();
+      if (!nested_schema ||
+          stage_patch(current, nested_schema, value, collector, &field_path,
+                      staged, copy, i) < 0) {
+        return -1;
+      }
+      store_field(copy, i, Py_NewRef((*staged)[entry].staged));
+      continue;
+    }
+
+    PyObject *input;
+    if (PyDict_Check(value) && current && PyDict_Check(current) &&
+        fs->type_schema->op == OP_DICT) {
+      input = merge_patch_dict(current, value);
+    } else if (schema->patch_validators && schema->has_field_before) {
+      input = run_field_before_validators(fs, cls, value);
+    } else {
+      input = Py_NewRef(value);
+    }
+    if (!input) {
+      return -1;
+    }
+    PyObject *converted =
+        validate_and_convert(input, fs->type_schema, collector, &field_path,
+                             schema->deserializers);
+    Py_DECREF(input);
+    if (converted) {
+      store_field(copy, i, converted);
+    } else if (PyErr_Occurred()) {
+      return -1;
+    } else if (collector->error_count() == initial_errors) {
+      PyErr_Format(PyExc_TypeError, "Invalid value for attribute %R", name);
+      return -1;
+    }
+  }
+
+  if (!schema->patch_validators ||
+      collector->error_count() != initial_errors) {
+    return 0;
+  }
+  if (run_field_after_validators(schema, cls, copy) != 0 ||
+      run_model_after_validators(schema, cls, copy) != 0) {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Exchange the fields and extra attributes of two instances.
+ *
+ * Both instances must have the same number of slots and either both or
+ * neither must have overflow storage, so the exchange cannot fail.
+ *
+ * @param target The instance, locked for the exchange.
+ * @param staged Its staged copy.
+ */
+static void swap_instance_state(PyObject *target, PyObject *staged) {
+  DataModelObject *a = (DataModelObject *)target;
+  DataModelObject *b = (DataModelObject *)staged;
+  Py_BEGIN_CRITICAL_SECTION(target);
+  for (Py_ssize_t i = 0; i < DataModel_num_slots(target); i++) {
+    std::swap(a->slots[i], b->slots[i]);
+  }
+  if (a->instance_data) {
+    std::swap(a->instance_data->fields, b->instance_data->fields);
+  }
+  Py_END_CRITICAL_SECTION();
+}
+
+/**
+ * @brief Commit staged copies into the instances they were made from.
+ *
+ * The staged parents are pointed back to the patched nested instances, so
+ * these keep their identity, and then every instance exchanges its state
+ * with its copy. Only the allocation of overflow storage can fail, and it
+ * happens before any instance changes.
+ *
+ * @param staged The staged copies.
+ * @return 0 on success, -1 on failure with no instance changed.
+ */
+static int commit_patch(std::vector<StagedPatch> &staged) {
+  for (const StagedPatch &entry : staged) {
+    bool target_data = ((DataModelObject *)entry.target)->instance_data;
+    bool staged_data = ((DataModelObject *)entry.staged)->instance_data;
+    if ((staged_data && !ensure_instance_data(entry.target)) ||
+        (target_data && !ensure_instance_data(entry.staged))) {
+      return -1;
+    }
+  }
+  for (const StagedPatch &entry : staged) {
+    if (entry.parent) {
+      store_field(entry.parent, entry.index, Py_NewRef(entry.target));
+    }
+  }
+  for (const StagedPatch &entry : staged) {
+    swap_instance_state(entry.target, entry.staged);
+  }
+  return 0;
+}
+
+/**
+ * @brief DataModel.apply_patch implementation.
+ *
+ * Applies a JSON merge patch (RFC 7386), given as a dict or as JSON text,
+ * validating only the fields it touches. Nested models named by the patch
+ * are patched in place. The patch is staged into copies first and applied
+ * only once all of it is valid, so on any error no instance is changed.
+ *
+ * @param self Python object.
+ * @param patch A dict, or a str or bytes holding a JSON object.
+ * @return PyObject* None.
+ */
+static PyObject *DataModel_apply_patch(PyObject *self, PyObject *patch) {
+  PyObject *patch_dict;
+  if (PyDict_Check(patch)) {
+    patch_dict = Py_NewRef(patch);
+  } else if (PyUnicode_Check(patch) || PyBytes_Check(patch)) {
+    const char *json;
+    Py_ssize_t length;
+    if (PyBytes_Check(patch)) {
+      json = PyBytes_AS_STRING(patch);
+      length = PyBytes_GET_SIZE(patch);
+    } else if (!(json = PyUnicode_AsUTF8AndSize(patch, &length))) {
+      return nullptr;
+    }
+    rapidjson::Document doc;
+    parse_json_document(doc, json, static_cast<size_t>(length));
+    if (doc.HasParseError()) {
+      PyErr_Format(PyExc_ValueError, "rapidjson parse error: %s (at offset %u)",
+                   rapidjson::GetParseError_En(doc.GetParseError()),
+                   static_cast<unsigned>(doc.GetErrorOffset()));
+      return nullptr;
+    }
+    if (!doc.IsObject()) {
+      PyErr_SetString(PyExc_TypeError, "JSON root must be an object");
+      return nullptr;
+    }
+    if (!(patch_dict = rapidjson_to_pyobject(doc))) {
+      return nullptr;
+    }
+  } else {
+    PyErr_SetString(PyExc_TypeError,
+                    "patch must be a dict or a JSON str or bytes");
+    return nullptr;
+  }
+
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  std::vector<StagedPatch> staged;
+  ErrorCollector collector;
+  int status = schema ? stage_patch(self, schema, patch_dict, &collector,
+                                    nullptr, &staged, nullptr, 0)
+                      : -1;
+  Py_DECREF(patch_dict);
+  if (status == 0 && collector.has_errors()) {
+    collector.raise();
+    status = -1;
+  }
+  if (status == 0) {
+    status = commit_patch(staged);
+  }
+  for (const StagedPatch &entry : staged) {
+    Py_DECREF(entry.staged);
+  }
+  if (status < 0) {
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
+/**
+ * @brief DataModel.__reduce__ implementation.
+ *
+ * Pickles an instance as a call to cls._restore_state with its slot values,
+ * as a tuple in slot order, and a dict of its extra attributes (or None).
+ * Slots left unset, e.g. by __new__ without __init__, are only
+ * representable by name, so such instances pass their set fields as a dict
+ * instead.
+ *
+ * @param self Python object.
+ * @return PyObject* The reduce tuple.
+ */
+static PyObject *DataModel_reduce(PyObject *self,
+                                  PyObject *Py_UNUSED(ignored)) {
+  if (DataModel_validate_pending(self) < 0) {
+    return nullptr;
+  }
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(self));
+  if (!schema) {
+    return nullptr;
+  }
+  PyObject **slots = DataModel_slots(self);
+  Py_ssize_t num_slots = DataModel_num_slots(self);
+  bool complete = num_slots == schema->num_fields;
+  for (Py_ssize_t i = 0; complete && i < num_slots; i++) {
+    complete = slots[i] != nullptr;
+  }
+
+  PyObject *values;
+  if (complete) {
+    values = PyTuple_New(num_slots);
+    for (Py_ssize_t i = 0; values && i < num_slots; i++) {
+      PyTuple_SET_ITEM(values, i, Py_NewRef(slots[i]));
+    }
+  } else {
+    values = PyDict_New();
+    for (Py_ssize_t i = 0; values && i < num_slots && i < schema->num_fields;
+         i++) {
+      if (slots[i] &&
+          PyDict_SetItem(values, schema->fields[i].field_name, slots[i]) < 0) {
+        Py_CLEAR(values);
+      }
+    }
+  }
+  if (!values) {
+    return nullptr;
+  }
+
+  InstanceData *data = ((DataModelObject *)self)->instance_data;
+  PyObject *extras = Py_NewRef(Py_None);
+  if (data && !data->fields.empty()) {
+    Py_SETREF(extras, PyDict_New());
+    for (const auto &pair : data->fields) {
+      if (!extras || PyDict_SetItemString(extras, pair.first.c_str(),
+                                          pair.second) < 0) {
+        Py_CLEAR(extras);
+        break;
+      }
+    }
+  }
+  PyObject *restore =
+      extras ? PyObject_GetAttr((PyObject *)Py_TYPE(self), restore_state_str)
+             : nullptr;
+  if (!restore) {
+    Py_DECREF(values);
+    Py_XDECREF(extras);
+    return nullptr;
+  }
+  return Py_BuildValue("N(NN)", restore, values, extras);
+}
+
+/**
+ * @brief DataModel._restore_state implementation.
+ *
+ * Rebuilds an instance pickled by DataModel_reduce, storing the values in
+ * the slots without validation, as pickles are only loaded from trusted
+ * sources. Names that are no longer fields of the class are kept as extra
+ * attributes.
+ *
+ * @param cls The model class.
+ * @param args The field values (a tuple in slot order or a dict by name)
+ * and the extra attributes (a dict or None).
+ * @return PyObject* The restored instance.
+ */
+static PyObject *DataModel_restore_state(PyObject *cls, PyObject *args) {
+  PyObject *values;
+  PyObject *extras;
+  if (!PyArg_ParseTuple(args, "OO:_restore_state", &values, &extras)) {
+    return nullptr;
+  }
+  if ((!PyTuple_Check(values) && !PyDict_Check(values)) ||
+      (extras != Py_None && !PyDict_Check(extras))) {
+    PyErr_SetString(PyExc_TypeError, "Invalid pickled model state");
+    return nullptr;
+  }
+  PyTypeObject *type = (PyTypeObject *)cls;
+  SchemaCache *schema = get_schema_cached(cls);
+  if (!schema) {
+    return nullptr;
+  }
+  if (PyTuple_Check(values) && PyTuple_GET_SIZE(values) != schema->num_fields) {
+    PyErr_Format(PyExc_ValueError,
+                 "Pickled state of %s has %zd fields, expected %zd",
+                 type->tp_name, PyTuple_GET_SIZE(values), schema->num_fields);
+    return nullptr;
+  }
+  PyObject *self = DataModel_alloc(type, schema);
+  if (!self) {
+    return nullptr;
+  }
+
+  if (PyTuple_Check(values)) {
+    for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+      store_field(self, i, Py_NewRef(PyTuple_GET_ITEM(values, i)));
+    }
+  }
+  PyObject *sources[2] = {PyDict_Check(values) ? values : nullptr,
+                          extras != Py_None ? extras : nullptr};
+  for (PyObject *source : sources) {
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    while (source && PyDict_Next(source, &pos, &key, &value)) {
+      const char *name = PyUnicode_Check(key) ? PyUnicode_AsUTF8(key) : nullptr;
+      if (!name) {
+        if (!PyErr_Occurred()) {
+          PyErr_SetString(PyExc_TypeError, "Invalid pickled model state");
+        }
+        Py_DECREF(self);
+        return nullptr;
+      }
+      Py_ssize_t index =
+          source == values ? lookup_field_index(schema, key) : FIELD_NOT_FOUND;
+      if (index >= 0) {
+        store_field(self, index, Py_NewRef(value));
+      } else if (DataModel_store_extra(self, name, Py_NewRef(value)) < 0) {
+        Py_DECREF(self);
+        return nullptr;
+      }
+    }
+  }
+  return self;
+}
+
+/**
+ * @brief Validate the pending fields of the lazy models within a value.
+ *
+ * Walks model fields, list and tuple items and dict values.
+ *
+ * @param value The value to walk.
+ * @param collector The error collector receiving field errors.
+ * @param path Error path of the value, or nullptr at the top level.
+ * @return int 0 on success or recorded errors, -1 on exception.
+ */
+static int validate_value_deep(PyObject *value, ErrorCollector *collector,
+                               const ErrorPath *path) {
+  if (PyList_Check(value) || PyTuple_Check(value)) {
+    if (Py_EnterRecursiveCall(" while validating a model")) {
+      return -1;
+    }
+    int result = 0;
+    for (Py_ssize_t i = 0; result == 0 && i < DataModel_num_slots(value);
+         i++) {
+      ErrorPath item_path(path, i);
+      PyObject *item = PyList_Check(value) ? PyList_GET_ITEM(value, i)
+                                           : PyTuple_GET_ITEM(value, i);
+      result = validate_value_deep(item, collector, &item_path);
+    }
+    Py_LeaveRecursiveCall();
+    return result;
+  }
+  if (PyDict_Check(value)) {
+    if (Py_EnterRecursiveCall(" while validating a model")) {
+      return -1;
+    }
+    Py_ssize_t pos = 0;
+    PyObject *key, *item;
+    int result = 0;
+    while (result == 0 && PyDict_Next(value, &pos, &key, &item)) {
+      ErrorPath item_path(path, key);
+      result = validate_value_deep(item, collector, &item_path);
+    }
+    Py_LeaveRecursiveCall();
+    return result;
+  }
+  if (!PyObject_TypeCheck(value, &DataModelType)) {
+    return 0;
+  }
+  SchemaCache *schema = get_schema_cached((PyObject *)Py_TYPE(value));
+  if (!schema || Py_EnterRecursiveCall(" while validating a model")) {
+    return -1;
+  }
+  int result = validate_pending_fields(value, schema, collector, path);
+  PyObject **slots = DataModel_slots(value);
+  for (Py_ssize_t i = 0; result == 0 && i < DataModel_num_slots(value);
+       i++) {
+    if (slots[i]) {
+      ErrorPath field_path(path, schema->fields[i].field_name_c);
+      result = validate_value_deep(slots[i], collector, &field_path);
+    }
+  }
+  Py_LeaveRecursiveCall();
+  return result;
+}
+
+/**
+ * @brief DataModel.validate_all implementation.
+ *
+ * Validates every pending field of a lazy instance and of the lazy models
+ * nested in it, raising all errors together.
+ *
+ * @param self Python object.
+ * @param unused Unused.
+ * @return PyObject* None on success, nullptr with ValidationError set.
+ */
+static PyObject *DataModel_validate_all(PyObject *self,
+                                        PyObject *Py_UNUSED(unused)) {
+  ErrorCollector collector;
+  if (validate_value_deep(self, &collector, nullptr) < 0) {
+    return nullptr;
+  }
+  if (collector.has_errors()) {
+    collector.raise();
+    return nullptr;
+  }
+  Py_RETURN_NONE;
 }
 
 static PyMethodDef DataModel_methods[] = {
@@ -390,8 +2092,49 @@ static PyMethodDef DataModel_methods[] = {
      "Create an instance from a JSON string."},
     {"to_json", (PyCFunction)json_utils_to_json, METH_NOARGS,
      "Convert the model instance to a JSON string."},
+    {"to_json_bytes", (PyCFunction)json_utils_to_json_bytes, METH_NOARGS,
+     "Convert the model instance to UTF-8 encoded JSON bytes."},
+    {"from_json_many", (PyCFunction)batch_utils_from_json_many,
+     METH_CLASS | METH_VARARGS | METH_KEYWORDS,
+     "Create a list of instances from a JSON array."},
+    {"validate_many", (PyCFunction)batch_utils_validate_many,
+     METH_CLASS | METH_VARARGS | METH_KEYWORDS,
+     "Create a list of instances from a list of dictionaries."},
+    {"to_json_into", (PyCFunction)json_utils_to_json_into,
+     METH_VARARGS | METH_KEYWORDS,
+     "Write the model instance as JSON to a file, writer or buffer."},
+    {"to_json_many", (PyCFunction)json_utils_to_json_many,
+     METH_CLASS | METH_O, "Convert a sequence of instances to a JSON array."},
+    {"to_json_many_into", (PyCFunction)json_utils_to_json_many_into,
+     METH_CLASS | METH_VARARGS | METH_KEYWORDS,
+     "Write a sequence of instances as a JSON array to a file, writer or "
+     "buffer."},
+    {"to_columns", (PyCFunction)columnar_to_columns, METH_CLASS | METH_O,
+     "Convert a sequence of instances to a dict of columns."},
+    {"_to_arrow_capsules", (PyCFunction)columnar_to_arrow,
+     METH_CLASS | METH_O,
+     "Export the primitive columns of instances as Arrow capsules."},
+    {"iter_json_lines", (PyCFunction)json_lines_iter,
+     METH_CLASS | METH_VARARGS | METH_KEYWORDS,
+     "Iterate over the instances stored in a JSON-lines source."},
+    {"to_msgpack", (PyCFunction)msgpack_utils_to_msgpack, METH_NOARGS,
+     "Convert the model instance to msgpack bytes."},
+    {"from_msgpack", (PyCFunction)msgpack_utils_from_msgpack,
+     METH_CLASS | METH_VARARGS | METH_KEYWORDS,
+     "Create an instance from msgpack bytes."},
+    {"model_copy", (PyCFunction)DataModel_model_copy,
+     METH_VARARGS | METH_KEYWORDS,
+     "Copy the model instance, validating only the updated fields."},
+    {"apply_patch", (PyCFunction)DataModel_apply_patch, METH_O,
+     "Apply a JSON merge patch, validating only the patched fields."},
     {"__deepcopy__", (PyCFunction)DataModel_deepcopy, METH_VARARGS,
      "Deep copy the model instance."},
+    {"__reduce__", (PyCFunction)DataModel_reduce, METH_NOARGS,
+     "Return the state of the instance for pickling."},
+    {"_restore_state", (PyCFunction)DataModel_restore_state,
+     METH_CLASS | METH_VARARGS, "Rebuild an instance from its pickled state."},
+    {"validate_all", (PyCFunction)DataModel_validate_all, METH_NOARGS,
+     "Validate all pending fields of a lazy model instance."},
     {nullptr, nullptr, 0, nullptr}};
 
 PyTypeObject DataModelType = {
@@ -420,7 +2163,7 @@ PyTypeObject DataModelType = {
     .tp_traverse = nullptr,
     .tp_clear = nullptr,
     .tp_richcompare = nullptr,
-    .tp_weaklistoffset = 0,
+    .tp_weaklistoffset = offsetof(DataModelObject, weakreflist),
     .tp_iter = nullptr,
     .tp_iternext = nullptr,
     .tp_methods = DataModel_methods,
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "schema/schema.hpp"
 #include <Python.h>
 #include <string>
 #include <unordered_map>
 
 #ifdef __cplusplus
+#include "error_handling.hpp"
+#include <memory>
 #include <rapidjson/document.h>
 #endif
 
@@ -85,11 +88,6 @@ void DataModel_dealloc(PyObject *self);
  */
 extern PyTypeObject DataModelType;
 
-/**
- * An interned key used for caching a compiled SchemaCache on a model class.
- */
-extern PyObject *schema_key;
-
 /**
  * @brief Initialize a DataModel instance from a native JSON object.
  *
@@ -103,30 +101,238 @@ extern PyObject *schema_key;
  */
 int DataModel_init_from_native(PyObject *self, const rapidjson::Value &native);
 
+/**
+ * @brief Check whether a model class can be initialized from a native value.
+ *
+ * Classes that override __new__ or __init__ in Python (e.g. AsyncDataModel)
+ * must be constructed through the regular call machinery instead.
+ *
+ * @param type The model class.
+ * @return 1 if DataModel_init_from_native may be used, 0 otherwise.
+ */
+int DataModel_supports_native_init(PyTypeObject *type);
+
+/**
+ * @brief Allocate an uninitialized DataModel instance for a known schema.
+ *
+ * Equivalent to DataModel_new without the schema lookup; used by batch
+ * constructors that resolve the schema once. An instance recycled by
+ * DataModel_dealloc is reused when the freelist of the class has one.
+ *
+ * @param type The model class.
+ * @param schema The compiled schema of the class.
+ * @return A new instance, or nullptr on failure.
+ */
+PyObject *DataModel_alloc(PyTypeObject *type, SchemaCache *schema);
+
+/**
+ * @brief Free the recycled instances kept by a schema.
+ *
+ * @param schema The schema of a model class.
+ */
+void DataModel_clear_freelist(SchemaCache *schema);
+
+/**
+ * @brief vldt.freelist_stats implementation.
+ *
+ * @param module The extension module.
+ * @param cls A DataModel subclass.
+ * @return New dict with the length and limit of the freelist of the class,
+ * and the number of allocations served from it ("reused") or by the memory
+ * allocator ("created"); nullptr on error.
+ */
+PyObject *DataModel_freelist_stats(PyObject *module, PyObject *cls);
+
+/**
+ * @brief Initialize a DataModel instance from keyword arguments.
+ *
+ * Same as DataModel_init, with the schema already resolved.
+ *
+ * @param self The model instance.
+ * @param kwds Keyword arguments for field values.
+ * @param schema The compiled schema of the instance's class.
+ * @return 0 on success, -1 on failure.
+ */
+int DataModel_init_with_schema(PyObject *self, PyObject *kwds,
+                               SchemaCache *schema);
+
+/**
+ * @brief Initialize a DataModel instance from a native JSON object.
+ *
+ * Same as DataModel_init_from_native, with the schema already resolved.
+ *
+ * @param self The model instance.
+ * @param native The rapidjson DOM element representing the JSON object.
+ * @param schema The compiled schema of the instance's class.
+ * @return 0 on success, -1 on failure.
+ */
+int DataModel_init_native_with_schema(PyObject *self,
+                                      const rapidjson::Value &native,
+                                      SchemaCache *schema);
+
 #ifdef __cplusplus
 } // end extern "C"
 #endif
 
 #ifdef __cplusplus
 /**
- * @brief Internal data structure for storing instance attributes.
+ * @brief Initialize a nested DataModel instance from keyword arguments.
+ *
+ * Used when a model is validated as a field of another model. Field errors
+ * are recorded in the enclosing collector under paths prefixed with the
+ * given path instead of being raised and re-parsed by the caller.
+ *
+ * @param self An instance allocated with DataModel_alloc.
+ * @param kwds Keyword arguments for field values.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The collector of the enclosing validation.
+ * @param prefix Error path of the nested instance.
+ * @return 0 on success, 1 if errors were recorded in the collector, -1 if a
+ * Python exception is set.
+ */
+int DataModel_init_nested(PyObject *self, PyObject *kwds, SchemaCache *schema,
+                          ErrorCollector *collector,
+                          const ErrorPath *prefix);
+
+/**
+ * @brief Initialize a nested DataModel instance from a native JSON object.
+ *
+ * Native counterpart of DataModel_init_nested.
+ *
+ * @param self An instance allocated with DataModel_alloc.
+ * @param native The rapidjson DOM element representing the JSON object.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The collector of the enclosing validation.
+ * @param prefix Error path of the nested instance.
+ * @return 0 on success, 1 if errors were recorded in the collector, -1 if a
+ * Python exception is set.
+ */
+int DataModel_init_native_nested(PyObject *self, const rapidjson::Value &native,
+                                 SchemaCache *schema, ErrorCollector *collector,
+                                 const ErrorPath *prefix);
+
+/**
+ * @brief Store a non-annotated attribute of an instance.
+ *
+ * @param self The model instance.
+ * @param name The attribute name.
+ * @param value The value to store (reference is stolen).
+ * @return 0 on success, -1 on failure.
+ */
+int DataModel_store_extra(PyObject *self, const char *name, PyObject *value);
+
+/**
+ * @brief Fill the unset slots of an instance as init fills missing fields.
+ *
+ * Each unset field gets its default_factory result, a copy of its default,
+ * or None if it is optional; a required field is recorded as missing.
+ *
+ * @param self The model instance.
+ * @param schema The compiled schema of the instance's class.
+ * @param collector The error collector receiving missing fields.
+ * @param prefix Error path of the instance, or nullptr at the top level.
+ * @return 0 on success (missing fields included), -1 if a default raised.
+ */
+int DataModel_fill_missing_fields(PyObject *self, SchemaCache *schema,
+                                  ErrorCollector *collector,
+                                  const ErrorPath *prefix);
+
+/**
+ * @brief Raw input kept by an instance of a lazily validated model.
+ *
+ * Exactly one of kwds and native is set. A JSON object is kept together with
+ * the document owning it, which may be shared by several instances.
+ */
+struct LazySource {
+  PyObject *kwds = nullptr; // Copy of the keyword dict.
+  std::shared_ptr<rapidjson::Document> document;
+  const rapidjson::Value *native = nullptr; // JSON object inside document.
+};
+
+/**
+ * @brief Internal data structure for storing non-annotated attributes.
  *
- * Holds the fields of a DataModel instance in a C++ unordered_map
- * for faster access, avoiding the overhead of Python’s __dict__.
+ * Declared fields live in the slot array of DataModelObject; only attributes
+ * that are not part of the schema end up in this overflow map. It is
+ * allocated lazily on the first such assignment, or on initialization of a
+ * lazily validated instance, whose fields are pending while their slot is
+ * empty and lazy is set.
  */
 struct InstanceData {
   std::unordered_map<std::string, PyObject *>
-      fields;            // Field name to value mapping.
+      fields;            // Attribute name to value mapping.
   bool dict_initialized; // Tracks whether __dict__ has been populated.
+  LazySource *lazy = nullptr; // Input of the pending fields, or nullptr.
 };
 
+/**
+ * @brief Makes a parsed document available to lazily validated models.
+ *
+ * While a scope is active, lazy models initialized from values of the
+ * document keep a reference to it instead of validating their fields.
+ * Without one, such models are validated eagerly from JSON.
+ */
+class LazyDocumentScope {
+public:
+  /**
+   * @brief Activate a document for the current thread.
+   *
+   * @param document The document the validated JSON values belong to.
+   */
+  explicit LazyDocumentScope(
+      const std::shared_ptr<rapidjson::Document> &document);
+  LazyDocumentScope(const LazyDocumentScope &) = delete;
+  LazyDocumentScope &operator=(const LazyDocumentScope &) = delete;
+  ~LazyDocumentScope();
+
+private:
+  const std::shared_ptr<rapidjson::Document> *previous_;
+};
+
+/**
+ * @brief Validate the pending fields of a lazily validated instance.
+ *
+ * Does nothing for instances without pending fields. On success the raw
+ * input is released; on failure all field errors are raised together.
+ *
+ * @param self The model instance.
+ * @return 0 on success, -1 with an exception set on failure.
+ */
+int DataModel_validate_pending(PyObject *self);
+
 /**
  * @brief DataModel object structure.
  *
- * Extends PyObject to include a pointer to the internal C++ data structure.
+ * A fixed-size object, so subclasses may declare __slots__ and weak
+ * references work. The field slots are a separate array of num_slots
+ * entries, laid out in SchemaCache::fields order, that is kept with the
+ * instance when it is recycled. Unset fields are nullptr.
  */
 typedef struct {
   PyObject_HEAD InstanceData
-      *instance_data; // Pointer to the native instance data.
+      *instance_data;    // Overflow storage for non-annotated attributes.
+  PyObject *weakreflist; // Weak references to the instance.
+  Py_ssize_t num_slots;  // Number of field slots.
+  PyObject **slots;      // Field values, indexed by field position.
 } DataModelObject;
+
+/**
+ * @brief Return the field slot array of a DataModel instance.
+ *
+ * @param self The model instance.
+ * @return Pointer to the first slot.
+ */
+static inline PyObject **DataModel_slots(PyObject *self) {
+  return reinterpret_cast<DataModelObject *>(self)->slots;
+}
+
+/**
+ * @brief Return the number of field slots of a DataModel instance.
+ *
+ * @param self The model instance.
+ * @return The number of slots.
+ */
+static inline Py_ssize_t DataModel_num_slots(PyObject *self) {
+  return reinterpret_cast<DataModelObject *>(self)->num_slots;
+}
 #endif // __cplusplus
@@ -0,0 +1,570 @@
+#include "error_handling.hpp"
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <stdio.h>
+#include <string_view>
+#include <unordered_map>
+
+ErrorRecord::ErrorRecord(const ErrorRecord &other)
+    : path(other.path), code(other.code), got_instance(other.got_instance),
+      expected(other.expected), got(other.got),
+      expected_len(other.expected_len), got_len(other.got_len),
+      message(other.message) {
+  Py_XINCREF(expected);
+  Py_XINCREF(got);
+}
+
+ErrorRecord::ErrorRecord(ErrorRecord &&other) noexcept
+    : path(std::move(other.path)), code(other.code),
+      got_instance(other.got_instance), expected(other.expected),
+      got(other.got), expected_len(other.expected_len),
+      got_len(other.got_len), message(std::move(other.message)) {
+  other.expected = nullptr;
+  other.got = nullptr;
+}
+
+ErrorRecord &ErrorRecord::operator=(ErrorRecord &&other) noexcept {
+  if (this != &other) {
+    Py_XDECREF(expected);
+    Py_XDECREF(got);
+    path = std::move(other.path);
+    code = other.code;
+    got_instance = other.got_instance;
+    expected = other.expected;
+    got = other.got;
+    expected_len = other.expected_len;
+    got_len = other.got_len;
+    message = std::move(other.message);
+    other.expected = nullptr;
+    other.got = nullptr;
+  }
+  return *this;
+}
+
+ErrorRecord::~ErrorRecord() {
+  Py_XDECREF(expected);
+  Py_XDECREF(got);
+}
+
+/**
+ * @brief Return the display name of a class.
+ *
+ * Uses __name__ (or __qualname__) so that e.g. datetime.datetime shows as
+ * "datetime", falling back to tp_name.
+ *
+ * @param cls A type object.
+ * @return The name of the class.
+ */
+static std::string class_name(PyObject *cls) {
+  if (!cls || !PyType_Check(cls)) {
+    return "<unknown>";
+  }
+  PyObject *name_obj = PyObject_GetAttrString(cls, "__name__");
+  if (!name_obj) {
+    PyErr_Clear();
+    name_obj = PyObject_GetAttrString(cls, "__qualname__");
+  }
+  if (name_obj) {
+    Py_ssize_t len = 0;
+    const char *name =
+        PyUnicode_Check(name_obj) ? PyUnicode_AsUTF8AndSize(name_obj, &len)
+                                  : nullptr;
+    if (name) {
+      std::string result(name, len);
+      Py_DECREF(name_obj);
+      return result;
+    }
+    Py_DECREF(name_obj);
+  }
+  PyErr_Clear();
+  return reinterpret_cast<PyTypeObject *>(cls)->tp_name;
+}
+
+/**
+ * @brief Return the display name of the rejected value of a record.
+ *
+ * @param record The error record.
+ * @return The value's type name, or the class name when the value was a class.
+ */
+static std::string got_name(const ErrorRecord &record) {
+  if (!record.got) {
+    return "<unknown>";
+  }
+  if (record.got_instance) {
+    const char *name = reinterpret_cast<PyTypeObject *>(record.got)->tp_name;
+    return name ? name : "<unknown>";
+  }
+  return class_name(record.got);
+}
+
+/**
+ * @brief Return repr(obj) as a std::string.
+ *
+ * @param obj Any object.
+ * @return The repr, or "<unknown>" if it cannot be computed.
+ */
+static std::string object_repr(PyObject *obj) {
+  PyObject *repr = obj ? PyObject_Repr(obj) : nullptr;
+  Py_ssize_t len = 0;
+  const char *text = repr ? PyUnicode_AsUTF8AndSize(repr, &len) : nullptr;
+  std::string result = text ? std::string(text, len) : "<unknown>";
+  Py_XDECREF(repr);
+  PyErr_Clear();
+  return result;
+}
+
+std::string ErrorRecord::format() const {
+  switch (code) {
+  case ERR_MESSAGE:
+    return message;
+  case ERR_TYPE:
+    return "Expected type " + class_name(expected) + ", got " + got_name(*this);
+  case ERR_LIST_TYPE:
+    return "Expected a list, got " + got_name(*this);
+  case ERR_DICT_TYPE:
+    return "Expected a dict, got " + got_name(*this);
+  case ERR_TUPLE_TYPE:
+    return "Expected a tuple, got " + got_name(*this);
+  case ERR_SET_TYPE:
+    return "Expected a set, got " + got_name(*this);
+  case ERR_TUPLE_LENGTH: {
+    char buf[128];
+    snprintf(buf, sizeof(buf), "Expected tuple of length %zd, got %zd",
+             expected_len, got_len);
+    return buf;
+  }
+  case ERR_UNION:
+    return "Value did not match any candidate in Union: got " +
+           got_name(*this);
+  case ERR_MISSING:
+    return "Missing required field";
+  case ERR_DEFAULT_FACTORY:
+    return "Missing required field and default factory call failed";
+  case ERR_TAG_MISSING:
+    return "Missing discriminator " + object_repr(expected);
+  case ERR_TAG_UNKNOWN:
+    return "Unknown value " + object_repr(got) + " for discriminator " +
+           object_repr(expected);
+  }
+  return message;
+}
+
+const char *ErrorRecord::code_name() const {
+  switch (code) {
+  case ERR_MESSAGE:
+    return "value_error";
+  case ERR_TYPE:
+    return "type_error";
+  case ERR_LIST_TYPE:
+    return "list_type";
+  case ERR_DICT_TYPE:
+    return "dict_type";
+  case ERR_TUPLE_TYPE:
+    return "tuple_type";
+  case ERR_SET_TYPE:
+    return "set_type";
+  case ERR_TUPLE_LENGTH:
+    return "tuple_length";
+  case ERR_UNION:
+    return "union";
+  case ERR_MISSING:
+    return "missing";
+  case ERR_DEFAULT_FACTORY:
+    return "default_factory";
+  case ERR_TAG_MISSING:
+    return "discriminator_missing";
+  case ERR_TAG_UNKNOWN:
+    return "discriminator_unknown";
+  }
+  return "value_error";
+}
+
+/**
+ * @brief Append the text of one path frame.
+ *
+ * @param out The string to append to.
+ * @param frame The frame.
+ */
+static void append_segment(std::string &out, const ErrorPath *frame) {
+  if (frame->name) {
+    if (frame->name_len < 0) {
+      out.append(frame->name);
+    } else {
+      out.append(frame->name, frame->name_len);
+    }
+    return;
+  }
+  if (!frame->key) {
+    out.append(std::to_string(frame->index));
+    return;
+  }
+  if (PyUnicode_Check(frame->key)) {
+    Py_ssize_t len = 0;
+    const char *text = PyUnicode_AsUTF8AndSize(frame->key, &len);
+    if (text) {
+      out.append(text, len);
+      return;
+    }
+    PyErr_Clear();
+  }
+  out.append(PyType_Check(frame->key) ? class_name(frame->key)
+                                      : Py_TYPE(frame->key)->tp_name);
+}
+
+/**
+ * @brief Append the dotted text of a path, outermost frame first.
+ *
+ * @param out The string to append to.
+ * @param frame The innermost frame.
+ */
+static void append_path(std::string &out, const ErrorPath *frame) {
+  if (frame->parent) {
+    append_path(out, frame->parent);
+    out.push_back('.');
+  }
+  append_segment(out, frame);
+}
+
+std::string ErrorPath::format(const ErrorPath *path) {
+  std::string result;
+  if (path) {
+    append_path(result, path);
+  }
+  return result;
+}
+
+ErrorRecord &ErrorCollector::push(std::string path, ErrorCode code) {
+  ErrorRecord &record = records_.emplace_back();
+  record.path = std::move(path);
+  record.code = code;
+  return record;
+}
+
+void ErrorCollector::add_error(const std::string &field,
+                               const std::string &message) {
+  ErrorRecord &record = push(field, ERR_MESSAGE);
+  record.message = message;
+}
+
+void ErrorCollector::add_type_error(const ErrorPath *path, PyObject *expected,
+                                    PyObject *value) {
+  ErrorRecord &record = push(ErrorPath::format(path), ERR_TYPE);
+  Py_XINCREF(expected);
+  record.expected = expected;
+  add_code_value(record, value);
+}
+
+void ErrorCollector::add_code(const ErrorPath *path, ErrorCode code,
+                              PyObject *value) {
+  ErrorRecord &record = push(ErrorPath::format(path), code);
+  add_code_value(record, value);
+}
+
+void ErrorCollector::add_length_error(const ErrorPath *path,
+                                      Py_ssize_t expected_len,
+                                      Py_ssize_t got_len) {
+  ErrorRecord &record = push(ErrorPath::format(path), ERR_TUPLE_LENGTH);
+  record.expected_len = expected_len;
+  record.got_len = got_len;
+}
+
+void ErrorCollector::add_tag_error(const ErrorPath *path, PyObject *key,
+                                   PyObject *tag) {
+  ErrorRecord &record =
+      push(ErrorPath::format(path), tag ? ERR_TAG_UNKNOWN : ERR_TAG_MISSING);
+  Py_INCREF(key);
+  record.expected = key;
+  Py_XINCREF(tag);
+  record.got = tag;
+  record.got_instance = false;
+}
+
+void ErrorCollector::add_code_value(ErrorRecord &record, PyObject *value) {
+  if (!value) {
+    return;
+  }
+  record.got_instance = !PyType_Check(value);
+  record.got = record.got_instance ? (PyObject *)Py_TYPE(value) : value;
+  Py_INCREF(record.got);
+}
+
+void ErrorCollector::add_suberror(const std::string &field,
+                                  const std::string &json_errors) {
+  rapidjson::Document subdoc;
+  if (subdoc.Parse(json_errors.c_str()).HasParseError() ||
+      !subdoc.IsObject()) {
+    add_error(field, "Invalid suberror JSON");
+    return;
+  }
+
+  for (auto itr = subdoc.MemberBegin(); itr != subdoc.MemberEnd(); ++itr) {
+    std::string combined_key =
+        field + "." +
+        std::string(itr->name.GetString(), itr->name.GetStringLength());
+    const rapidjson::Value &value = itr->value;
+    if (value.IsString()) {
+      add_error(combined_key,
+                std::string(value.GetString(), value.GetStringLength()));
+    } else if (value.IsArray()) {
+      for (auto &item : value.GetArray()) {
+        if (item.IsString()) {
+          add_error(combined_key,
+                    std::string(item.GetString(), item.GetStringLength()));
+        }
+      }
+    }
+  }
+}
+
+void ErrorCollector::merge(const std::string &prefix,
+                           const std::vector<ErrorRecord> &records) {
+  records_.reserve(records_.size() + records.size());
+  for (const ErrorRecord &record : records) {
+    ErrorRecord &copy = records_.emplace_back(record);
+    if (!prefix.empty()) {
+      copy.path = prefix + "." + record.path;
+    }
+  }
+}
+
+/**
+ * @brief Render records as a pretty-printed JSON object.
+ *
+ * Paths keep the order of their first error; a path with several errors maps
+ * to an array of messages.
+ *
+ * @param records The records to render.
+ * @return The JSON text.
+ */
+static std::string render_json(const std::vector<ErrorRecord> &records) {
+  std::vector<std::vector<size_t>> groups;
+  std::unordered_map<std::string_view, size_t> group_of;
+  groups.reserve(records.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    auto [it, inserted] = group_of.try_emplace(records[i].path, groups.size());
+    if (inserted) {
+      groups.emplace_back();
+    }
+    groups[it->second].push_back(i);
+  }
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  writer.SetIndent(' ', 2);
+  writer.StartObject();
+  for (const std::vector<size_t> &group : groups) {
+    const std::string &path = records[group[0]].path;
+    writer.Key(path.c_str(), static_cast<rapidjson::SizeType>(path.size()));
+    if (group.size() > 1) {
+      writer.StartArray();
+    }
+    for (size_t index : group) {
+      std::string message = records[index].format();
+      writer.String(message.c_str(),
+                    static_cast<rapidjson::SizeType>(message.size()));
+    }
+    if (group.size() > 1) {
+      writer.EndArray();
+    }
+  }
+  writer.EndObject();
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+std::string ErrorCollector::to_json() const { return render_json(records_); }
+
+/**
+ * @brief ValidationError instance layout.
+ *
+ * Extends the TypeError layout with the native records; the JSON text is
+ * rendered on the first str() and cached.
+ */
+typedef struct {
+  PyBaseExceptionObject base;
+  std::vector<ErrorRecord> *records; // Moved out of the raising collector.
+  PyObject *rendered;                // Cached str(); nullptr until requested.
+} ValidationErrorObject;
+
+void ErrorCollector::raise() {
+  PyObject *exc =
+      PyObject_CallObject((PyObject *)&ValidationErrorType, nullptr);
+  if (!exc) {
+    return;
+  }
+  reinterpret_cast<ValidationErrorObject *>(exc)->records =
+      new std::vector<ErrorRecord>(std::move(records_));
+  records_.clear();
+  PyErr_SetObject((PyObject *)&ValidationErrorType, exc);
+  Py_DECREF(exc);
+}
+
+const std::vector<ErrorRecord> *validation_error_records(PyObject *exc) {
+  if (!exc || !PyObject_TypeCheck(exc, &ValidationErrorType)) {
+    return nullptr;
+  }
+  return reinterpret_cast<ValidationErrorObject *>(exc)->records;
+}
+
+static PyTypeObject *type_error_base() {
+  return reinterpret_cast<PyTypeObject *>(PyExc_TypeError);
+}
+
+static void ValidationError_dealloc(PyObject *self) {
+  auto *err = reinterpret_cast<ValidationErrorObject *>(self);
+  PyObject_GC_UnTrack(self);
+  delete err->records;
+  err->records = nullptr;
+  Py_CLEAR(err->rendered);
+  type_error_base()->tp_dealloc(self);
+}
+
+static int ValidationError_traverse(PyObject *self, visitproc visit,
+                                    void *arg) {
+  return type_error_base()->tp_traverse(self, visit, arg);
+}
+
+static int ValidationError_clear(PyObject *self) {
+  Py_CLEAR(reinterpret_cast<ValidationErrorObject *>(self)->rendered);
+  return type_error_base()->tp_clear(self);
+}
+
+/**
+ * @brief ValidationError.__str__: the errors as JSON, rendered on demand.
+ */
+static PyObject *ValidationError_str(PyObject *self) {
+  auto *err = reinterpret_cast<ValidationErrorObject *>(self);
+  if (!err->records) {
+    return type_error_base()->tp_str(self);
+  }
+  if (!err->rendered) {
+    std::string text = render_json(*err->records);
+    err->rendered = PyUnicode_FromStringAndSize(text.data(), text.size());
+    if (!err->rendered) {
+      return nullptr;
+    }
+  }
+  Py_INCREF(err->rendered);
+  return err->rendered;
+}
+
+static PyObject *ValidationError_repr(PyObject *self) {
+  auto *err = reinterpret_cast<ValidationErrorObject *>(self);
+  if (!err->records) {
+    return type_error_base()->tp_repr(self);
+  }
+  return PyUnicode_FromFormat("%s(%zd errors)", Py_TYPE(self)->tp_name,
+                              (Py_ssize_t)err->records->size());
+}
+
+/**
+ * @brief ValidationError.errors(): the errors as a list of dicts.
+ *
+ * Each dict has "path", "type" (a stable code name) and "msg" keys.
+ */
+static PyObject *ValidationError_errors(PyObject *self,
+                                        PyObject *Py_UNUSED(ignored)) {
+  auto *err = reinterpret_cast<ValidationErrorObject *>(self);
+  Py_ssize_t count = err->records ? (Py_ssize_t)err->records->size() : 0;
+  PyObject *result = PyList_New(count);
+  if (!result) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < count; i++) {
+    const ErrorRecord &record = (*err->records)[i];
+    std::string message = record.format();
+    PyObject *item = Py_BuildValue(
+        "{s:N,s:s,s:N}", "path",
+        PyUnicode_FromStringAndSize(record.path.data(), record.path.size()),
+        "type", record.code_name(), "msg",
+        PyUnicode_FromStringAndSize(message.data(), message.size()));
+    if (!item) {
+      Py_DECREF(result);
+      return nullptr;
+    }
+    PyList_SET_ITEM(result, i, item);
+  }
+  return result;
+}
+
+/**
+ * @brief ValidationError.__reduce__: pickle as the rendered message.
+ */
+static PyObject *ValidationError_reduce(PyObject *self,
+                                        PyObject *Py_UNUSED(ignored)) {
+  auto *err = reinterpret_cast<ValidationErrorObject *>(self);
+  if (!err->records) {
+    return Py_BuildValue("(OO)", Py_TYPE(self), err->base.args);
+  }
+  PyObject *text = ValidationError_str(self);
+  if (!text) {
+    return nullptr;
+  }
+  PyObject *result = Py_BuildValue("(O(N))", Py_TYPE(self), text);
+  return result;
+}
+
+static PyMethodDef ValidationError_methods[] = {
+    {"errors", (PyCFunction)ValidationError_errors, METH_NOARGS,
+     "Return the validation errors as a list of dicts"},
+    {"__reduce__", (PyCFunction)ValidationError_reduce, METH_NOARGS,
+     "Support pickling"},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyTypeObject ValidationErrorType = {
+    .ob_base = {.ob_base = {.ob_refcnt = 1, .ob_type = &PyType_Type},
+                .ob_size = 0},
+    .tp_name = "vldt._vldt.ValidationError",
+    .tp_basicsize = sizeof(ValidationErrorObject),
+    .tp_itemsize = 0,
+    .tp_dealloc = ValidationError_dealloc,
+    .tp_vectorcall_offset = 0,
+    .tp_getattr = nullptr,
+    .tp_setattr = nullptr,
+    .tp_as_async = nullptr,
+    .tp_repr = ValidationError_repr,
+    .tp_as_number = nullptr,
+    .tp_as_sequence = nullptr,
+    .tp_as_mapping = nullptr,
+    .tp_hash = nullptr,
+    .tp_call = nullptr,
+    .tp_str = ValidationError_str,
+    .tp_getattro = nullptr,
+    .tp_setattro = nullptr,
+    .tp_as_buffer = nullptr,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = "Raised when data does not match a model schema",
+    .tp_traverse = ValidationError_traverse,
+    .tp_clear = ValidationError_clear,
+    .tp_richcompare = nullptr,
+    .tp_weaklistoffset = 0,
+    .tp_iter = nullptr,
+    .tp_iternext = nullptr,
+    .tp_methods = ValidationError_methods,
+    .tp_members = nullptr,
+    .tp_getset = nullptr,
+    .tp_base = nullptr,
+    .tp_dict = nullptr,
+    .tp_descr_get = nullptr,
+    .tp_descr_set = nullptr,
+    .tp_dictoffset = 0,
+    .tp_init = nullptr,
+    .tp_alloc = nullptr,
+    .tp_new = nullptr,
+    .tp_free = nullptr,
+    .tp_is_gc = nullptr,
+    .tp_bases = nullptr,
+    .tp_mro = nullptr,
+    .tp_cache = nullptr,
+    .tp_subclasses = nullptr,
+    .tp_weaklist = nullptr,
+    .tp_del = nullptr,
+    .tp_version_tag = 0,
+    .tp_finalize = nullptr};
+
+int init_validation_error_type(void) {
+  ValidationErrorType.tp_base = type_error_base();
+  return PyType_Ready(&ValidationErrorType);
+}
@@ -1,52 +1,197 @@
 #pragma once
 
-#include "rapidjson/document.h"
-#include "rapidjson/error/en.h"
-#include "rapidjson/prettywriter.h"
-#include "rapidjson/stringbuffer.h"
-#include <memory>
+#include <Python.h>
 #include <string>
+#include <vector>
 
 /**
- * @brief Collects and manages error messages in a JSON format.
+ * @brief Kind of a recorded validation error.
+ *
+ * The code together with the type references of an ErrorRecord is enough to
+ * produce the message, so no text is built while validating.
+ */
+enum ErrorCode : unsigned char {
+  ERR_MESSAGE,         // Preformatted text stored in ErrorRecord::message.
+  ERR_TYPE,            // Expected type <expected>, got <got>.
+  ERR_LIST_TYPE,       // Expected a list, got <got>.
+  ERR_DICT_TYPE,       // Expected a dict, got <got>.
+  ERR_TUPLE_TYPE,      // Expected a tuple, got <got>.
+  ERR_SET_TYPE,        // Expected a set, got <got>.
+  ERR_TUPLE_LENGTH,    // Expected tuple of length <n>, got <m>.
+  ERR_UNION,           // Value did not match any candidate in Union.
+  ERR_MISSING,         // Missing required field.
+  ERR_DEFAULT_FACTORY, // Missing required field and default factory failed.
+  ERR_TAG_MISSING,     // Discriminator <expected> is missing.
+  ERR_TAG_UNKNOWN,     // Discriminator <expected> has unknown value <got>.
+};
+
+/**
+ * @brief A single validation error in native form.
+ *
+ * Holds strong references to the expected type and to the type of the
+ * rejected value (or the value itself when it is a class), never to the
+ * value, so recording an error is a path copy and two reference increments.
+ * Discriminator errors are the exception: expected holds the discriminator
+ * key and got the (small) tag value.
+ */
+struct ErrorRecord {
+  std::string path;
+  ErrorCode code = ERR_MESSAGE;
+  bool got_instance = true; // got is the type of the value, not the value.
+  PyObject *expected = nullptr;
+  PyObject *got = nullptr;
+  Py_ssize_t expected_len = 0;
+  Py_ssize_t got_len = 0;
+  std::string message;
+
+  ErrorRecord() = default;
+  ErrorRecord(const ErrorRecord &other);
+  ErrorRecord(ErrorRecord &&other) noexcept;
+  ErrorRecord &operator=(const ErrorRecord &other) = delete;
+  ErrorRecord &operator=(ErrorRecord &&other) noexcept;
+  ~ErrorRecord();
+
+  /**
+   * @brief Format the human-readable message of the error.
+   *
+   * @return The message text.
+   */
+  std::string format() const;
+
+  /**
+   * @brief Return the stable identifier of the error code.
+   *
+   * @return A static string such as "type_error" or "missing".
+   */
+  const char *code_name() const;
+};
+
+/**
+ * @brief Location of a value in the validated data, formatted on demand.
+ *
+ * Validators keep one frame per field, element or key on the C stack, each
+ * linking to the frame of its parent, so descending into a value costs a few
+ * stores. The dotted path text is only built when an error is recorded.
+ */
+struct ErrorPath {
+  const ErrorPath *parent;
+  const char *name;    // Segment text, or nullptr for an index or a key.
+  Py_ssize_t name_len; // Length of name, or -1 if it is NUL-terminated.
+  Py_ssize_t index;    // Element index when name and key are nullptr.
+  PyObject *key;       // Borrowed non-text dict key.
+
+  /**
+   * @brief Frame for a field name.
+   *
+   * @param parent The enclosing frame, or nullptr at the top level.
+   * @param name NUL-terminated segment text.
+   */
+  ErrorPath(const ErrorPath *parent, const char *name)
+      : parent(parent), name(name), name_len(-1), index(0), key(nullptr) {}
+
+  /**
+   * @brief Frame for a segment of known length, such as a JSON key.
+   *
+   * @param parent The enclosing frame, or nullptr at the top level.
+   * @param name Segment text.
+   * @param name_len Length of name in bytes.
+   */
+  ErrorPath(const ErrorPath *parent, const char *name, Py_ssize_t name_len)
+      : parent(parent), name(name), name_len(name_len), index(0),
+        key(nullptr) {}
+
+  /**
+   * @brief Frame for a list, tuple or set element.
+   *
+   * @param parent The enclosing frame.
+   * @param index The element index.
+   */
+  ErrorPath(const ErrorPath *parent, Py_ssize_t index)
+      : parent(parent), name(nullptr), name_len(0), index(index),
+        key(nullptr) {}
+
+  /**
+   * @brief Frame for a dict key.
+   *
+   * A str key is shown as its text, any other key by the name of its type.
+   *
+   * @param parent The enclosing frame.
+   * @param key The key; must outlive the frame.
+   */
+  ErrorPath(const ErrorPath *parent, PyObject *key)
+      : parent(parent), name(nullptr), name_len(0), index(0), key(key) {}
+
+  /**
+   * @brief Format a path as dotted text.
+   *
+   * @param path The innermost frame, or nullptr for the empty path.
+   * @return The segments from the outermost frame, joined by dots.
+   */
+  static std::string format(const ErrorPath *path);
+};
+
+/**
+ * @brief Collects validation errors as compact native records.
+ *
+ * Messages and the JSON rendering are only produced on demand, usually when
+ * the ValidationError raised from the collector is displayed. Errors sharing
+ * a path are grouped into an array when rendered.
  */
 class ErrorCollector {
 public:
   /**
    * @brief Construct a new ErrorCollector object.
    */
-  ErrorCollector() : doc_(nullptr) {}
+  ErrorCollector() = default;
+  ErrorCollector(const ErrorCollector &) = delete;
+  ErrorCollector &operator=(const ErrorCollector &) = delete;
 
   /**
-   * @brief Add an error message for a given field.
+   * @brief Add a preformatted error message for a given field.
    *
    * @param field The field associated with the error.
    * @param message The error message.
    */
-  void add_error(const std::string &field, const std::string &message) {
-    lazy_init();
+  void add_error(const std::string &field, const std::string &message);
+
+  /**
+   * @brief Record that a value did not match the expected type.
+   *
+   * @param path The location of the value.
+   * @param expected The expected type.
+   * @param value The rejected value.
+   */
+  void add_type_error(const ErrorPath *path, PyObject *expected,
+                      PyObject *value);
 
-    rapidjson::Value key;
-    key.SetString(field.c_str(), static_cast<rapidjson::SizeType>(field.size()),
-                  doc_->GetAllocator());
+  /**
+   * @brief Record an error described by its code and the rejected value.
+   *
+   * @param path The location of the value.
+   * @param code The error code (e.g. ERR_LIST_TYPE or ERR_UNION).
+   * @param value The rejected value, or nullptr when not applicable.
+   */
+  void add_code(const ErrorPath *path, ErrorCode code,
+                PyObject *value = nullptr);
 
-    rapidjson::Value msg;
-    msg.SetString(message.c_str(),
-                  static_cast<rapidjson::SizeType>(message.size()),
-                  doc_->GetAllocator());
+  /**
+   * @brief Record a missing or unknown discriminator value.
+   *
+   * @param path The location of the value.
+   * @param key The discriminator key.
+   * @param tag The tag value found, or nullptr if the key is missing.
+   */
+  void add_tag_error(const ErrorPath *path, PyObject *key, PyObject *tag);
 
-    if (doc_->HasMember(key)) {
-      rapidjson::Value &existing = (*doc_)[key];
-      if (!existing.IsArray()) {
-        rapidjson::Value arr(rapidjson::kArrayType);
-        arr.PushBack(existing, doc_->GetAllocator());
-        existing = arr;
-      }
-      existing.PushBack(msg, doc_->GetAllocator());
-    } else {
-      doc_->AddMember(key, msg, doc_->GetAllocator());
-    }
-  }
+  /**
+   * @brief Record a tuple length mismatch.
+   *
+   * @param path The location of the value.
+   * @param expected_len The expected number of items.
+   * @param got_len The actual number of items.
+   */
+  void add_length_error(const ErrorPath *path, Py_ssize_t expected_len,
+                        Py_ssize_t got_len);
 
   /**
    * @brief Add suberrors for a given field.
@@ -57,76 +202,82 @@ public:
    * @param field The field associated with the suberrors.
    * @param json_errors A JSON string representing the suberrors.
    */
-  void add_suberror(const std::string &field, const std::string &json_errors) {
-    lazy_init();
-
-    rapidjson::Document subdoc;
-    if (subdoc.Parse(json_errors.c_str()).HasParseError() ||
-        !subdoc.IsObject()) {
-      add_error(field, "Invalid suberror JSON");
-      return;
-    }
-
-    for (auto itr = subdoc.MemberBegin(); itr != subdoc.MemberEnd(); ++itr) {
-      std::string combined_key =
-          field + "." +
-          std::string(itr->name.GetString(), itr->name.GetStringLength());
-
-      rapidjson::Value key;
-      key.SetString(combined_key.c_str(),
-                    static_cast<rapidjson::SizeType>(combined_key.size()),
-                    doc_->GetAllocator());
-
-      rapidjson::Value value;
-      value.CopyFrom(itr->value, doc_->GetAllocator());
-
-      if (doc_->HasMember(key)) {
-        rapidjson::Value &existing = (*doc_)[key];
-        if (!existing.IsArray()) {
-          rapidjson::Value arr(rapidjson::kArrayType);
-          arr.PushBack(existing, doc_->GetAllocator());
-          existing = arr;
-        }
-        existing.PushBack(value, doc_->GetAllocator());
-      } else {
-        doc_->AddMember(key, value, doc_->GetAllocator());
-      }
-    }
-  }
+  void add_suberror(const std::string &field, const std::string &json_errors);
+
+  /**
+   * @brief Copy records into this collector under a path prefix.
+   *
+   * @param prefix The path prefix; each record path becomes prefix.path.
+   * @param records The records to copy.
+   */
+  void merge(const std::string &prefix,
+             const std::vector<ErrorRecord> &records);
 
   /**
    * @brief Check whether any errors have been recorded.
    *
    * @return true if errors exist, false otherwise.
    */
-  bool has_errors() const { return doc_ && !doc_->ObjectEmpty(); }
+  bool has_errors() const { return !records_.empty(); }
+
+  /**
+   * @brief Return the number of errors recorded so far.
+   *
+   * Lets a caller sharing the collector with nested validation tell whether
+   * its own step added errors.
+   *
+   * @return The number of recorded error messages.
+   */
+  size_t error_count() const { return records_.size(); }
+
+  /**
+   * @brief Return the recorded errors.
+   *
+   * @return The records in the order they were added.
+   */
+  const std::vector<ErrorRecord> &records() const { return records_; }
 
   /**
    * @brief Convert the recorded errors to a JSON string.
    *
-   * @return A JSON string representing the errors.
+   * @return A JSON object mapping each path to its message, or to an array
+   * of messages when the path has several errors.
    */
-  std::string to_json() const {
-    if (!doc_) {
-      return "";
-    }
-    rapidjson::StringBuffer buffer;
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-    writer.SetIndent(' ', 2);
-    doc_->Accept(writer);
-    return buffer.GetString();
-  }
+  std::string to_json() const;
 
-private:
   /**
-   * @brief Lazily initialize the JSON document.
+   * @brief Raise a ValidationError holding the recorded errors.
+   *
+   * The records are moved into the exception, leaving the collector empty.
    */
-  void lazy_init() {
-    if (!doc_) {
-      doc_ = std::make_unique<rapidjson::Document>();
-      doc_->SetObject();
-    }
-  }
+  void raise();
+
+private:
+  ErrorRecord &push(std::string path, ErrorCode code);
+  static void add_code_value(ErrorRecord &record, PyObject *value);
 
-  std::unique_ptr<rapidjson::Document> doc_;
+  std::vector<ErrorRecord> records_;
 };
+
+/**
+ * The ValidationError exception type, a subclass of TypeError.
+ */
+extern PyTypeObject ValidationErrorType;
+
+/**
+ * @brief Ready the ValidationError type.
+ *
+ * TypeError is not a constant expression, so the base is filled in here.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int init_validation_error_type(void);
+
+/**
+ * @brief Return the records carried by an exception.
+ *
+ * @param exc An exception instance.
+ * @return The records when exc is a ValidationError raised from a
+ * collector, nullptr otherwise.
+ */
+const std::vector<ErrorRecord> *validation_error_records(PyObject *exc);
@@ -21,6 +21,13 @@ PyObject *StrType = nullptr;
 PyObject *BoolType = nullptr;
 PyObject *NoneType = nullptr;
 
+PyObject *DateTimeType = nullptr;
+PyObject *DateType = nullptr;
+PyObject *TimeType = nullptr;
+PyObject *UUIDType = nullptr;
+PyObject *DecimalType = nullptr;
+PyObject *EnumType = nullptr;
+
 /**
  * @brief Initialize an empty tuple.
  *
@@ -116,6 +123,44 @@ int init_primitive_types() {
   return 0;
 }
 
+/**
+ * @brief Import an attribute of a standard library module.
+ *
+ * @param module_name The module name.
+ * @param name The attribute name.
+ * @return New reference to the attribute, or nullptr on error.
+ */
+static PyObject *import_attr(const char *module_name, const char *name) {
+  PyObject *module = PyImport_ImportModule(module_name);
+  if (!module) {
+    return nullptr;
+  }
+  PyObject *attr = PyObject_GetAttrString(module, name);
+  Py_DECREF(module);
+  return attr;
+}
+
+/**
+ * @brief Initialize the standard library value types.
+ *
+ * @return int 0 on success, -1 on error.
+ */
+int init_stdlib_types() {
+  if (!DateTimeType) {
+    DateTimeType = import_attr("datetime", "datetime");
+    DateType = import_attr("datetime", "date");
+    TimeType = import_attr("datetime", "time");
+    UUIDType = import_attr("uuid", "UUID");
+    DecimalType = import_attr("decimal", "Decimal");
+    EnumType = import_attr("enum", "Enum");
+    if (!DateTimeType || !DateType || !TimeType || !UUIDType ||
+        !DecimalType || !EnumType) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
 /**
  * @brief Ensure UnionType is initialized from the typing module.
  *
@@ -257,6 +302,9 @@ int init_extension_globals(void) {
   if (init_primitive_types() != 0) {
     return -1;
   }
+  if (init_stdlib_types() != 0) {
+    return -1;
+  }
   if (init_vldt_undefined() != 0) {
     return -1;
   }
@@ -28,6 +28,16 @@ extern PyObject *StrType;
 extern PyObject *BoolType;
 extern PyObject *NoneType;
 
+/**
+ * @brief Standard library value types with native validators.
+ */
+extern PyObject *DateTimeType;
+extern PyObject *DateType;
+extern PyObject *TimeType;
+extern PyObject *UUIDType;
+extern PyObject *DecimalType;
+extern PyObject *EnumType;
+
 /**
  * @brief Sentinel for undefined default.
  */
@@ -41,6 +51,7 @@ int init_class_var_type();
 int init_any_type();
 int ensure_union_type();
 int ensure_generic_cache();
+int init_stdlib_types();
 
 /**
  * @brief Initialize the undefined default sentinel.
@@ -1,7 +1,33 @@
 #include "deserializer.hpp"
 
+#include <vector>
+
+namespace {
+// Live Deserializers, searched for an equal one before a new one is kept.
+std::vector<Deserializers *> live_deserializers;
+uint64_t next_deserializers_id = 1;
+
+/**
+ * @brief Release the references held by a Deserializers and delete it.
+ * @param deserializers Pointer to the Deserializers structure.
+ */
+void destroy_deserializers(Deserializers *deserializers) {
+  for (auto &entry : deserializers->map) {
+    Py_DECREF(entry.first.deserialize_to);
+    Py_DECREF(entry.first.deserialize_from);
+    Py_DECREF(entry.second);
+  }
+  delete deserializers;
+}
+} // namespace
+
 /**
  * @brief Create a Deserializers structure from a Python dict.
+ *
+ * Configurations usually merge the same global functions, so a live
+ * structure mapping the same types to the same functions is returned instead
+ * of a new one.
+ *
  * @param deserializer_dict A Python dictionary containing deserializer
  * functions.
  * @return Deserializers* Pointer to the created Deserializers structure.
@@ -24,7 +50,7 @@ Deserializers *create_deserializers(PyObject *deserializer_dict) {
     if (!PyDict_Check(outer_value)) {
       PyErr_SetString(PyExc_TypeError,
                       "Each value in deserializer_dict must be a dict");
-      free_deserializers(deserializers);
+      destroy_deserializers(deserializers);
       return nullptr;
     }
     PyObject *inner_key, *inner_value;
@@ -33,16 +59,29 @@ Deserializers *create_deserializers(PyObject *deserializer_dict) {
       if (!PyCallable_Check(inner_value)) {
         PyErr_SetString(PyExc_TypeError,
                         "Deserializer function must be callable");
-        free_deserializers(deserializers);
+        destroy_deserializers(deserializers);
         return nullptr;
       }
       Py_INCREF(outer_key);
       Py_INCREF(inner_key);
       Py_INCREF(inner_value);
       DeserializerKey dk = {outer_key, inner_key};
-      deserializers->map.insert({dk, inner_value});
+      if (!deserializers->map.insert({dk, inner_value}).second) {
+        Py_DECREF(outer_key);
+        Py_DECREF(inner_key);
+        Py_DECREF(inner_value);
+      }
+    }
+  }
+  for (Deserializers *existing : live_deserializers) {
+    if (existing->map == deserializers->map) {
+      destroy_deserializers(deserializers);
+      existing->refcount++;
+      return existing;
     }
   }
+  deserializers->id = next_deserializers_id++;
+  live_deserializers.push_back(deserializers);
   return deserializers;
 }
 
@@ -70,18 +109,19 @@ PyObject *get_deserializer(Deserializers *deserializers,
 }
 
 /**
- * @brief Free the Deserializers structure and decrement reference counts on all
- * stored objects.
+ * @brief Release a Deserializers structure, freeing it with its last user.
  * @param deserializers Pointer to the Deserializers structure to be freed.
  */
 void free_deserializers(Deserializers *deserializers) {
-  if (!deserializers) {
+  if (!deserializers || --deserializers->refcount > 0) {
     return;
   }
-  for (auto &entry : deserializers->map) {
-    Py_DECREF(entry.first.deserialize_to);
-    Py_DECREF(entry.first.deserialize_from);
-    Py_DECREF(entry.second);
+  for (size_t i = 0; i < live_deserializers.size(); i++) {
+    if (live_deserializers[i] == deserializers) {
+      live_deserializers[i] = live_deserializers.back();
+      live_deserializers.pop_back();
+      break;
+    }
   }
-  delete deserializers;
+  destroy_deserializers(deserializers);
 }
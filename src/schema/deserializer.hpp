@@ -1,8 +1,10 @@
 #pragma once
 
 #include <Python.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
+#include <cstddef>
 #include <unordered_map>
 
 /**
@@ -29,17 +31,27 @@ struct DeserializerKey {
 namespace std {
 template <> struct hash<DeserializerKey> {
   std::size_t operator()(const DeserializerKey &k) const {
-    return std::hash<PyObject *>()(k.deserialize_to) ^
-           (std::hash<PyObject *>()(k.deserialize_from) << 1);
+    // Objects are 16-byte aligned and pointer hashes are the identity, so
+    // drop the constant low bits and mix the two halves asymmetrically.
+    std::size_t to = reinterpret_cast<std::size_t>(k.deserialize_to) >> 4;
+    std::size_t from = reinterpret_cast<std::size_t>(k.deserialize_from) >> 4;
+    std::size_t seed = to * 0x9E3779B97F4A7C15ull;
+    return seed ^ (from + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
   }
 };
 } // namespace std
 
 /**
  * @brief Structure that caches deserializer functions.
+ *
+ * Models whose configurations resolve to the same functions share one
+ * instance, so the inline caches on shared TypeSchemas see a single owner.
+ * The id is never reused and identifies the owner of cached entries.
  */
 struct Deserializers {
   std::unordered_map<DeserializerKey, PyObject *> map;
+  uint64_t id = 0;
+  Py_ssize_t refcount = 1;
 };
 
 extern "C" {
@@ -55,6 +67,9 @@ extern "C" {
  *     }, ...
  * }
  *
+ * An existing structure with the same functions is shared instead of
+ * creating a new one.
+ *
  * @param deserializer_dict The Python dictionary containing deserializer
  * functions.
  * @return Deserializers* Pointer to the created Deserializers structure.
@@ -76,8 +91,9 @@ PyObject *get_deserializer(Deserializers *deserializers,
                            PyObject *deserialize_from);
 
 /**
- * @brief Free the Deserializers structure and decrement reference counts on all
- * stored objects.
+ * @brief Release a Deserializers structure.
+ *
+ * The structure and the references it holds are freed with its last user.
  *
  * @param deserializers Pointer to the Deserializers structure to be freed.
  */
@@ -1,12 +1,18 @@
 #include <Python.h>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <structmember.h>
 
 #include "data_model.hpp"
 #include "init_globals.hpp"
 #include "schema/deserializer.hpp"
 #include "schema/schema.hpp"
+#include "stats.hpp"
+#include "validation/validation_validators.hpp"
 
 extern PyObject *UnionType;
 extern PyObject *ClassVarType;
@@ -52,10 +58,6 @@ TypeSchema *get_cached_type_schema(PyObject *expected_type) {
   if (PyType_Check(expected_type)) {
     auto type_dict = reinterpret_cast<PyTypeObject *>(expected_type)->tp_dict;
     if (type_dict && PyDict_Check(type_dict)) {
-      if (!cached_type_schema_key) {
-        cached_type_schema_key =
-            PyUnicode_InternFromString("__vldt_type_schema__");
-      }
       PyObject *capsule = PyDict_GetItem(type_dict, cached_type_schema_key);
       if (capsule) {
         auto cached_ts = static_cast<TypeSchema *>(
@@ -71,6 +73,10 @@ TypeSchema *get_cached_type_schema(PyObject *expected_type) {
 
 /**
  * @brief Caches the TypeSchema for the expected type.
+ *
+ * Only the first schema cached for a type is kept; if another thread cached
+ * one meanwhile, ts stays uncached and is freed by its owner.
+ *
  * @param expected_type The expected type.
  * @param ts The TypeSchema to cache.
  */
@@ -78,21 +84,117 @@ void try_cache_type_schema(PyObject *expected_type, TypeSchema *ts) {
   if (PyType_Check(expected_type)) {
     auto type_dict = reinterpret_cast<PyTypeObject *>(expected_type)->tp_dict;
     if (type_dict && PyDict_Check(type_dict)) {
-      if (!cached_type_schema_key) {
-        cached_type_schema_key =
-            PyUnicode_InternFromString("__vldt_type_schema__");
-      }
       PyObject *capsule =
           PyCapsule_New(ts, "vldt.TypeSchema", no_op_capsule_destructor);
       if (capsule) {
-        PyDict_SetItem(type_dict, cached_type_schema_key, capsule);
-        Py_DECREF(capsule);
+        // Marked before publication, as readers never free cached schemas.
         ts->cached = 1;
+        PyObject *stored =
+            PyDict_SetDefault(type_dict, cached_type_schema_key, capsule);
+        if (stored != capsule) {
+          ts->cached = 0;
+          PyErr_Clear();
+        }
+        Py_DECREF(capsule);
       }
     }
   }
 }
 
+/**
+ * @brief Retrieves the value-to-member map of an Enum class.
+ *
+ * The map is updated in place when Flag pseudo-members are created, so a
+ * reference to it stays current.
+ *
+ * @param cls The Enum class.
+ * @return New reference to the dict, or nullptr (no exception set) when the
+ * class has none.
+ */
+PyObject *enum_value_map(PyObject *cls) {
+  PyObject *map = PyObject_GetAttrString(cls, "_value2member_map_");
+  if (!map) {
+    PyErr_Clear();
+    return nullptr;
+  }
+  if (!PyDict_Check(map)) {
+    Py_DECREF(map);
+    return nullptr;
+  }
+  return map;
+}
+
+/**
+ * @brief Lowers the TypeSchema to its validation opcode.
+ *
+ * Must run after the container kind and the optional flag are known.
+ *
+ * @param ts The TypeSchema.
+ */
+void assign_validation_op(TypeSchema *ts) {
+  PyObject *expected = ts->expected_type;
+  switch (ts->container_kind) {
+  case CK_LIST:
+    ts->op = OP_LIST;
+    return;
+  case CK_DICT:
+    ts->op = OP_DICT;
+    return;
+  case CK_TUPLE:
+    ts->op = OP_TUPLE;
+    return;
+  case CK_SET:
+    ts->op = OP_SET;
+    return;
+  case CK_UNION:
+    ts->op = OP_UNION;
+    // Union[X, None] with a non-generic X behaves exactly like X plus None:
+    // the isinstance scan and the conversion attempts reduce to those of X.
+    if (ts->is_optional && ts->num_args == 2) {
+      PyObject *none_type = (PyObject *)Py_TYPE(Py_None);
+      TypeSchema *target =
+          ts->args[0]->expected_type == none_type ? ts->args[1] : ts->args[0];
+      if (target->origin == Py_None) {
+        ts->op = OP_OPTIONAL;
+        ts->optional_target = target;
+      }
+    }
+    return;
+  }
+  if (expected == AnyType) {
+    ts->op = OP_ANY;
+  } else if (ts->origin != Py_None) {
+    ts->op = OP_CONSTRUCT;
+  } else if (ts->is_data_model) {
+    ts->op = OP_MODEL;
+  } else if (expected == IntType) {
+    ts->op = OP_INT;
+  } else if (expected == StrType) {
+    ts->op = OP_STR;
+  } else if (expected == FloatType) {
+    ts->op = OP_FLOAT;
+  } else if (expected == BoolType) {
+    ts->op = OP_BOOL;
+  } else if (expected == DateTimeType) {
+    ts->op = OP_DATETIME;
+  } else if (expected == DateType) {
+    ts->op = OP_DATE;
+  } else if (expected == TimeType) {
+    ts->op = OP_TIME;
+  } else if (expected == UUIDType) {
+    ts->op = OP_UUID;
+  } else if (expected == DecimalType) {
+    ts->op = OP_DECIMAL;
+  } else if (PyType_Check(expected) &&
+             PyType_IsSubtype((PyTypeObject *)expected,
+                              (PyTypeObject *)EnumType) &&
+             (ts->enum_members = enum_value_map(expected))) {
+    ts->op = OP_ENUM;
+  } else {
+    ts->op = OP_PLAIN;
+  }
+}
+
 /**
  * @brief Handles the case when no origin attribute is available.
  * @param ts The TypeSchema.
@@ -112,6 +214,7 @@ TypeSchema *handle_no_origin(TypeSchema *ts, PyObject *expected_type) {
   ts->utf8_repr = PyUnicode_AsUTF8(ts->repr);
   try_cache_type_schema(expected_type, ts);
   ts->is_optional = 0;
+  assign_validation_op(ts);
   return ts;
 }
 
@@ -158,6 +261,7 @@ TypeSchema *handle_no_args(TypeSchema *ts, PyObject *expected_type) {
   ts->utf8_repr = PyUnicode_AsUTF8(ts->repr);
   try_cache_type_schema(expected_type, ts);
   ts->is_optional = 0;
+  assign_validation_op(ts);
   return ts;
 }
 
@@ -192,6 +296,41 @@ int compile_args(TypeSchema *ts, PyObject *args) {
   return 0;
 }
 
+/**
+ * @brief Builds the exact-type dispatch table of a union.
+ *
+ * Only built when every member is a plain class, so that an exact type hit
+ * is equivalent to the isinstance scan over the members.
+ *
+ * @param ts The union TypeSchema.
+ */
+void build_union_type_table(TypeSchema *ts) {
+  for (Py_ssize_t i = 0; i < ts->num_args; i++) {
+    if (ts->args[i]->origin != Py_None ||
+        !PyType_Check(ts->args[i]->expected_type)) {
+      return;
+    }
+  }
+  PyObject *table = PyDict_New();
+  if (!table) {
+    PyErr_Clear();
+    return;
+  }
+  // Iterate backwards so the first member wins for duplicates.
+  for (Py_ssize_t i = ts->num_args - 1; i >= 0; i--) {
+    PyObject *index = PyLong_FromSsize_t(i);
+    if (!index ||
+        PyDict_SetItem(table, ts->args[i]->expected_type, index) < 0) {
+      Py_XDECREF(index);
+      Py_DECREF(table);
+      PyErr_Clear();
+      return;
+    }
+    Py_DECREF(index);
+  }
+  ts->type_table = table;
+}
+
 /**
  * @brief Determines the container kind for the TypeSchema.
  * @param ts The TypeSchema.
@@ -211,6 +350,7 @@ void handle_container_kind(TypeSchema *ts) {
           Py_INCREF(ts->inner_model_type);
         }
       }
+      build_union_type_table(ts);
     } else if (PyObject_RichCompareBool(ts->origin, (PyObject *)&PyDict_Type,
                                         Py_EQ) == 1 &&
                ts->num_args == 2) {
@@ -322,6 +462,7 @@ TypeSchema *compile_type_schema(PyObject *expected_type) {
   }
   ts->utf8_repr = PyUnicode_AsUTF8(ts->repr);
   handle_container_kind(ts);
+  assign_validation_op(ts);
   try_cache_type_schema(expected_type, ts);
   return ts;
 }
@@ -343,6 +484,15 @@ void free_type_schema(TypeSchema *ts) {
   if (ts->inner_model_type) {
     Py_DECREF(ts->inner_model_type);
   }
+  Py_XDECREF(ts->type_table);
+  Py_XDECREF(ts->tag_table);
+  Py_XDECREF(ts->discriminator);
+  Py_XDECREF(ts->tag_keys);
+  Py_XDECREF(ts->enum_members);
+  for (DeserializerCacheEntry &entry : ts->deserializer_cache) {
+    Py_XDECREF(entry.from_type);
+    Py_XDECREF(entry.func);
+  }
   if (ts->args) {
     for (Py_ssize_t i = 0; i < ts->num_args; i++) {
       free_type_schema(ts->args[i]);
@@ -352,6 +502,118 @@ void free_type_schema(TypeSchema *ts) {
   delete ts;
 }
 
+namespace {
+/**
+ * @brief Looks up an entry of the deserializer cache of a TypeSchema.
+ * @param ts The TypeSchema of the target type.
+ * @param owner The id of the Deserializers the lookup is made in.
+ * @param from_type The source type.
+ * @return The matching entry, or nullptr on a miss.
+ */
+DeserializerCacheEntry *find_cached_deserializer(TypeSchema *ts,
+                                                 uint64_t owner,
+                                                 PyObject *from_type) {
+  for (DeserializerCacheEntry &entry : ts->deserializer_cache) {
+    if (std::atomic_ref<uint64_t>(entry.owner).load(
+            std::memory_order_acquire) == owner &&
+        entry.from_type == from_type) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Records a deserializer lookup in the cache of a TypeSchema.
+ *
+ * Empty entries are used first, then they are replaced in turn.
+ *
+ * @param ts The TypeSchema of the target type.
+ * @param owner The id of the Deserializers the lookup was made in.
+ * @param from_type The source type.
+ * @param func The registered function, or nullptr if none is registered.
+ */
+void cache_deserializer(TypeSchema *ts, uint64_t owner, PyObject *from_type,
+                        PyObject *func) {
+  DeserializerCacheEntry &entry =
+      ts->deserializer_cache[ts->deserializer_cache_next++ %
+                             DESERIALIZER_CACHE_SIZE];
+  PyObject *old_type = entry.from_type;
+  PyObject *old_func = entry.func;
+  Py_INCREF(from_type);
+  Py_XINCREF(func);
+  entry.from_type = from_type;
+  entry.func = func;
+  // Published last, so a reader matching the owner sees the whole entry.
+  std::atomic_ref<uint64_t>(entry.owner).store(owner,
+                                               std::memory_order_release);
+  Py_XDECREF(old_type);
+  Py_XDECREF(old_func);
+}
+
+#ifdef Py_GIL_DISABLED
+// Serializes priming, the only writer of the caches without the GIL.
+std::mutex deserializer_cache_mutex;
+#endif
+
+/**
+ * @brief Fills the unused deserializer cache entries of a TypeSchema tree.
+ * @param ts The root TypeSchema.
+ * @param deserializers The deserializers of the model owning the schema.
+ */
+void prime_type_schema(TypeSchema *ts, Deserializers *deserializers) {
+  for (const auto &item : deserializers->map) {
+    // Only fill unused entries; a lookup records the entry on a miss.
+    if (item.first.deserialize_to == ts->expected_type &&
+        ts->deserializer_cache_next < DESERIALIZER_CACHE_SIZE &&
+        !find_cached_deserializer(ts, deserializers->id,
+                                  item.first.deserialize_from)) {
+      cache_deserializer(ts, deserializers->id, item.first.deserialize_from,
+                         item.second);
+    }
+  }
+  for (Py_ssize_t i = 0; ts->args && i < ts->num_args; i++) {
+    prime_type_schema(ts->args[i], deserializers);
+  }
+}
+} // namespace
+
+/**
+ * @brief Finds the deserializer converting a source type to a schema's type.
+ * @param ts The TypeSchema of the target type.
+ * @param deserializers The deserializers of the model being validated.
+ * @param from_type The type of the value to convert.
+ * @return Borrowed reference to the function, or nullptr.
+ */
+PyObject *find_deserializer(TypeSchema *ts, Deserializers *deserializers,
+                            PyObject *from_type) {
+  DeserializerCacheEntry *entry =
+      find_cached_deserializer(ts, deserializers->id, from_type);
+  if (entry) {
+    return entry->func;
+  }
+  auto it = deserializers->map.find({ts->expected_type, from_type});
+  PyObject *func = it != deserializers->map.end() ? it->second : nullptr;
+#ifndef Py_GIL_DISABLED
+  // Without the GIL, entries are only written while priming, so an entry
+  // being read is never replaced.
+  cache_deserializer(ts, deserializers->id, from_type, func);
+#endif
+  return func;
+}
+
+/**
+ * @brief Fills the deserializer caches of a TypeSchema tree.
+ * @param ts The root TypeSchema.
+ * @param deserializers The deserializers of the model owning the schema.
+ */
+void prime_deserializer_cache(TypeSchema *ts, Deserializers *deserializers) {
+#ifdef Py_GIL_DISABLED
+  std::lock_guard<std::mutex> lock(deserializer_cache_mutex);
+#endif
+  prime_type_schema(ts, deserializers);
+}
+
 namespace {
 /**
  * @brief Counts the number of non-class variable annotations.
@@ -380,13 +642,127 @@ Py_ssize_t count_non_class_vars(PyObject *annotations) {
   return count;
 }
 
+/**
+ * @brief Appends the input keys of a member's tag field to the tag keys.
+ *
+ * Aliases come before the field name, as in init; keys already listed by
+ * another member are skipped.
+ *
+ * @param keys The list of tag keys.
+ * @param fs The tag field of the member.
+ * @return 0 on success, -1 on error.
+ */
+static int add_tag_keys(PyObject *keys, FieldSchema *fs) {
+  Py_ssize_t num_aliases =
+      fs->alias && PyList_Check(fs->alias) ? PyList_GET_SIZE(fs->alias) : 0;
+  for (Py_ssize_t i = 0; i <= num_aliases; i++) {
+    PyObject *key =
+        i < num_aliases ? PyList_GET_ITEM(fs->alias, i) : fs->field_name;
+    if (!PyUnicode_Check(key)) {
+      continue;
+    }
+    int seen = PySequence_Contains(keys, key);
+    if (seen < 0 || (!seen && PyList_Append(keys, key) < 0)) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Compiles the tag table of a discriminated union field.
+ *
+ * Every non-None member must be a model whose discriminator field has a
+ * default; that default is the tag selecting the member. The tag is read
+ * from the field name or any alias of the tag field, as init reads it.
+ *
+ * @param ts The field's TypeSchema.
+ * @param discriminator The name of the discriminator field.
+ * @return 0 on success, -1 with TypeError set on failure.
+ */
+int compile_discriminator(TypeSchema *ts, PyObject *discriminator) {
+  if (!PyUnicode_Check(discriminator)) {
+    PyErr_SetString(PyExc_TypeError, "discriminator must be a str");
+    return -1;
+  }
+  if (ts->container_kind != CK_UNION) {
+    PyErr_Format(PyExc_TypeError,
+                 "discriminator %R requires a Union of models, got %R",
+                 discriminator, ts->expected_type);
+    return -1;
+  }
+  PyObject *table = PyDict_New();
+  PyObject *keys = PyList_New(0);
+  if (!table || !keys) {
+    Py_XDECREF(table);
+    Py_XDECREF(keys);
+    return -1;
+  }
+  PyObject *none_type = (PyObject *)Py_TYPE(Py_None);
+  for (Py_ssize_t i = 0; i < ts->num_args; i++) {
+    TypeSchema *candidate = ts->args[i];
+    if (candidate->expected_type == none_type) {
+      continue;
+    }
+    if (!candidate->is_data_model) {
+      PyErr_Format(PyExc_TypeError,
+                   "discriminated Union member %R is not a model",
+                   candidate->expected_type);
+      Py_DECREF(table);
+      Py_DECREF(keys);
+      return -1;
+    }
+    SchemaCache *schema = get_schema_cached(candidate->expected_type);
+    if (!schema) {
+      Py_DECREF(table);
+      Py_DECREF(keys);
+      return -1;
+    }
+    Py_ssize_t field = lookup_field_index(schema, discriminator);
+    PyObject *tag =
+        field >= 0 ? schema->fields[field].default_value : VLDTUndefined;
+    if (tag == VLDTUndefined) {
+      PyErr_Format(PyExc_TypeError,
+                   "Union member %R needs a default for discriminator %R",
+                   candidate->expected_type, discriminator);
+      Py_DECREF(table);
+      Py_DECREF(keys);
+      return -1;
+    }
+    if (add_tag_keys(keys, &schema->fields[field]) < 0) {
+      Py_DECREF(table);
+      Py_DECREF(keys);
+      return -1;
+    }
+    int seen = PyDict_Contains(table, tag);
+    PyObject *index = seen == 0 ? PyLong_FromSsize_t(i) : nullptr;
+    if (seen > 0) {
+      PyErr_Format(PyExc_TypeError, "duplicate discriminator value %R", tag);
+    }
+    if (!index || PyDict_SetItem(table, tag, index) < 0) {
+      Py_XDECREF(index);
+      Py_DECREF(table);
+      Py_DECREF(keys);
+      return -1;
+    }
+    Py_DECREF(index);
+  }
+  ts->tag_table = table;
+  ts->tag_keys = keys;
+  ts->discriminator = discriminator;
+  ts->op = OP_UNION;
+  ts->optional_target = nullptr;
+  Py_INCREF(discriminator);
+  return 0;
+}
+
 /**
  * @brief Compiles the field schema for a given field.
  * @param cls The class object.
  * @param key The field name.
  * @param expected_type The expected type.
  * @param fs Pointer to the FieldSchema.
- * @return 0 on success.
+ * @return 0 on success, -1 on error (fs is still fully initialized).
  */
 int compile_field_schema(PyObject *cls, PyObject *key, PyObject *expected_type,
                          FieldSchema *fs) {
@@ -400,6 +776,7 @@ int compile_field_schema(PyObject *cls, PyObject *key, PyObject *expected_type,
   Py_INCREF(Py_None);
   const char *key_str = PyUnicode_AsUTF8(key);
   PyObject *field_obj = nullptr;
+  PyObject *discriminator = nullptr;
   if (PyObject_HasAttrString(cls, key_str)) {
     field_obj = PyObject_GetAttrString(cls, key_str);
   }
@@ -428,6 +805,12 @@ int compile_field_schema(PyObject *cls, PyObject *key, PyObject *expected_type,
       } else {
         fs->alias = nullptr;
       }
+      discriminator = PyObject_GetAttrString(field_obj, "discriminator");
+      if (!discriminator) {
+        PyErr_Clear();
+      } else if (discriminator == Py_None) {
+        Py_CLEAR(discriminator);
+      }
       PyObject *factory = PyObject_GetAttrString(field_obj, "default_factory");
       if (factory && factory != Py_None && PyCallable_Check(factory)) {
         fs->default_factory = factory;
@@ -447,6 +830,13 @@ int compile_field_schema(PyObject *cls, PyObject *key, PyObject *expected_type,
     Py_DECREF(field_obj);
   }
   fs->type_schema = compile_type_schema(expected_type);
+  if (discriminator) {
+    int result = fs->type_schema
+                     ? compile_discriminator(fs->type_schema, discriminator)
+                     : -1;
+    Py_DECREF(discriminator);
+    return result;
+  }
   return 0;
 }
 
@@ -499,14 +889,48 @@ void compile_config(PyObject *cls, SchemaCache *schema) {
     }
     if (deserializer_obj && PyDict_Check(deserializer_obj)) {
       schema->deserializers = create_deserializers(deserializer_obj);
-      if (!schema->deserializers) {
-        Py_DECREF(deserializer_obj);
-        schema->deserializers = nullptr;
-      }
     } else {
       schema->deserializers = nullptr;
     }
     Py_XDECREF(deserializer_obj);
+    PyObject *lazy = PyDict_Check(config)
+                         ? PyDict_GetItemString(config, "lazy")
+                         : PyObject_GetAttrString(config, "lazy");
+    if (lazy) {
+      schema->lazy = PyObject_IsTrue(lazy) == 1;
+      if (!PyDict_Check(config)) {
+        Py_DECREF(lazy);
+      }
+    } else {
+      PyErr_Clear();
+    }
+    PyObject *patch_validators =
+        PyDict_Check(config)
+            ? PyDict_GetItemString(config, "patch_validators")
+            : PyObject_GetAttrString(config, "patch_validators");
+    if (patch_validators) {
+      schema->patch_validators = PyObject_IsTrue(patch_validators) == 1;
+      if (!PyDict_Check(config)) {
+        Py_DECREF(patch_validators);
+      }
+    } else {
+      PyErr_Clear();
+    }
+    PyObject *freelist_size =
+        PyDict_Check(config) ? PyDict_GetItemString(config, "freelist_size")
+                             : PyObject_GetAttrString(config, "freelist_size");
+    if (freelist_size) {
+      Py_ssize_t limit = PyLong_AsSsize_t(freelist_size);
+      if (limit >= 0) {
+        schema->free_limit = limit;
+      }
+      PyErr_Clear();
+      if (!PyDict_Check(config)) {
+        Py_DECREF(freelist_size);
+      }
+    } else {
+      PyErr_Clear();
+    }
     schema->config = config;
   } else {
     schema->config = Py_None;
@@ -521,10 +945,14 @@ void compile_config(PyObject *cls, SchemaCache *schema) {
 
 /**
  * @brief Compiles validators for the schema.
+ *
+ * The validator lists are resolved into the chains of the fields and the
+ * model; the has_* flags tell whether any chain of a kind is non-empty.
  * @param cls The class object.
  * @param schema Pointer to the SchemaCache.
+ * @return 0 on success, -1 on error.
  */
-void compile_validators(PyObject *cls, SchemaCache *schema) {
+int compile_validators(PyObject *cls, SchemaCache *schema) {
   PyObject *validators = PyObject_GetAttrString(cls, "__vldt_validators__");
   if (validators && PyDict_Check(validators)) {
     schema->validators = validators;
@@ -541,7 +969,10 @@ void compile_validators(PyObject *cls, SchemaCache *schema) {
     tmp = PyObject_GetAttrString(cls, "__vldt_has_model_after_validators__");
     schema->has_model_after = tmp ? PyObject_IsTrue(tmp) : 0;
     Py_XDECREF(tmp);
+    PyErr_Clear();
+    return compile_validator_chains(schema);
   } else {
+    Py_XDECREF(validators);
     schema->validators = Py_None;
     Py_INCREF(Py_None);
     schema->has_field_before = 0;
@@ -549,15 +980,172 @@ void compile_validators(PyObject *cls, SchemaCache *schema) {
     schema->has_model_before = 0;
     schema->has_model_after = 0;
   }
+  PyErr_Clear();
+  return 0;
+}
+
+/**
+ * @brief Inserts a key into the key table unless another field has it.
+ *
+ * @param schema The schema owning the table.
+ * @param key The field name or alias (a str object).
+ * @param field The field index.
+ * @param priority The lookup order of the key within the field.
+ * @return true on success, false if the key also names another field.
+ */
+bool insert_field_key(SchemaCache *schema, PyObject *key, Py_ssize_t field,
+                      Py_ssize_t priority) {
+  Py_ssize_t len = 0;
+  const char *name = PyUnicode_AsUTF8AndSize(key, &len);
+  if (!name) {
+    PyErr_Clear();
+    return false;
+  }
+  uint64_t hash = hash_field_key(name, len);
+  for (size_t i = hash & schema->field_key_mask;;
+       i = (i + 1) & schema->field_key_mask) {
+    FieldKey *entry = &schema->field_keys[i];
+    if (!entry->name) {
+      *entry = FieldKey{name, len, hash, key, field, priority};
+      return true;
+    }
+    if (entry->hash == hash && entry->len == len &&
+        memcmp(entry->name, name, len) == 0) {
+      // Repeated within one field the first occurrence wins, as in lookup.
+      return entry->field == field;
+    }
+  }
+}
+
+/**
+ * @brief Inserts the names and aliases of all fields into the key table.
+ *
+ * @param schema The schema owning the table.
+ * @return true on success, false if a key names several fields.
+ */
+bool insert_all_field_keys(SchemaCache *schema) {
+  for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+    FieldSchema *fs = &schema->fields[i];
+    Py_ssize_t priority = 0;
+    if (fs->alias && PyList_Check(fs->alias)) {
+      for (; priority < PyList_GET_SIZE(fs->alias); priority++) {
+        PyObject *alias = PyList_GET_ITEM(fs->alias, priority);
+        if (PyUnicode_Check(alias) &&
+            !insert_field_key(schema, alias, i, priority)) {
+          return false;
+        }
+      }
+    }
+    if (!insert_field_key(schema, fs->field_name, i, priority)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Builds the table mapping input keys to fields.
+ *
+ * The table holds every field name and alias at a load factor of at most
+ * one half. When a key names two fields the table is left unset and
+ * members are found field by field instead.
+ * @param schema Pointer to the SchemaCache, with its fields compiled.
+ */
+void compile_field_keys(SchemaCache *schema) {
+  size_t count = 0;
+  for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+    PyObject *alias = schema->fields[i].alias;
+    count += 1 + (alias && PyList_Check(alias) ? PyList_GET_SIZE(alias) : 0);
+  }
+  size_t size = 8;
+  while (size < 2 * count) {
+    size *= 2;
+  }
+  schema->field_keys = new (std::nothrow) FieldKey[size]();
+  if (!schema->field_keys) {
+    return;
+  }
+  schema->field_key_mask = size - 1;
+  if (!insert_all_field_keys(schema)) {
+    delete[] schema->field_keys;
+    schema->field_keys = nullptr;
+    schema->field_key_mask = 0;
+  }
+}
+
+/**
+ * @brief Records ClassVar annotations in the field index.
+ *
+ * The metaclass keeps ClassVars out of the instance annotations, so they are
+ * read from __vldt_class_annotations__ and mapped to FIELD_CLASS_VAR.
+ * @param cls The class object.
+ * @param schema Pointer to the SchemaCache.
+ */
+void mark_class_vars(PyObject *cls, SchemaCache *schema) {
+  PyObject *class_annos =
+      PyObject_GetAttrString(cls, "__vldt_class_annotations__");
+  if (!class_annos || !PyDict_Check(class_annos)) {
+    Py_XDECREF(class_annos);
+    PyErr_Clear();
+    return;
+  }
+  PyObject *index = PyLong_FromSsize_t(FIELD_CLASS_VAR);
+  Py_ssize_t pos = 0;
+  PyObject *key, *value;
+  while (index && PyDict_Next(class_annos, &pos, &key, &value)) {
+    if (!PyDict_SetDefault(schema->field_index, key, index)) {
+      PyErr_Clear();
+    }
+  }
+  Py_XDECREF(index);
+  Py_DECREF(class_annos);
+  PyErr_Clear();
 }
 } // anonymous namespace
 
+/**
+ * @brief Releases a compiled SchemaCache and everything it owns.
+ * @param schema The schema to free.
+ */
+static void free_schema_cache(SchemaCache *schema) {
+  for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+    FieldSchema *fs = &schema->fields[i];
+    Py_DECREF(fs->field_name);
+    if (fs->alias) {
+      Py_DECREF(fs->alias);
+    }
+    Py_DECREF(fs->default_value);
+    Py_DECREF(fs->default_factory);
+    if (fs->type_schema) {
+      free_type_schema(fs->type_schema);
+    }
+  }
+  free_validator_chains(schema);
+  free_model_stats(schema);
+  delete[] schema->field_keys;
+  delete[] schema->fields;
+  DataModel_clear_freelist(schema);
+  // The remaining members are unset when compilation failed part-way.
+  Py_XDECREF(schema->field_index);
+  Py_XDECREF(schema->config);
+  Py_XDECREF(schema->dict_serializer);
+  Py_XDECREF(schema->json_serializer);
+  Py_XDECREF(schema->instance_annotations);
+  Py_XDECREF(schema->validators);
+  Py_XDECREF(schema->cached_to_dict);
+  if (schema->deserializers) {
+    free_deserializers(schema->deserializers);
+  }
+  delete schema;
+}
+
 /**
  * @brief Compiles the schema for the class.
  * @param cls The class object.
- * @return A new capsule containing the SchemaCache.
+ * @return A newly allocated SchemaCache, or nullptr on error.
  */
-PyObject *compile_schema(PyObject *cls) {
+static SchemaCache *compile_schema(PyObject *cls) {
+  auto compile_started = std::chrono::steady_clock::now();
   PyObject *annotations = get_type_annotations(cls);
   if (!annotations || !PyDict_Check(annotations)) {
     Py_XDECREF(annotations);
@@ -571,6 +1159,7 @@ PyObject *compile_schema(PyObject *cls) {
     return nullptr;
   }
   schema->num_fields = count;
+  schema->free_limit = DEFAULT_FREELIST_SIZE;
   schema->fields = new (std::nothrow) FieldSchema[count];
   if (!schema->fields) {
     delete schema;
@@ -578,6 +1167,13 @@ PyObject *compile_schema(PyObject *cls) {
     PyErr_NoMemory();
     return nullptr;
   }
+  schema->field_index = PyDict_New();
+  if (!schema->field_index) {
+    delete[] schema->fields;
+    delete schema;
+    Py_DECREF(annotations);
+    return nullptr;
+  }
   Py_ssize_t pos = 0, idx = 0;
   PyObject *key, *expected_type;
   while (PyDict_Next(annotations, &pos, &key, &expected_type)) {
@@ -592,14 +1188,37 @@ PyObject *compile_schema(PyObject *cls) {
       PyErr_Clear();
     }
     if (is_class_var) {
+      PyObject *index = PyLong_FromSsize_t(FIELD_CLASS_VAR);
+      if (!index || PyDict_SetItem(schema->field_index, key, index) < 0) {
+        PyErr_Clear();
+      }
+      Py_XDECREF(index);
       continue;
     }
     FieldSchema *fs = &schema->fields[idx];
-    compile_field_schema(cls, key, expected_type, fs);
+    if (compile_field_schema(cls, key, expected_type, fs) != 0) {
+      schema->num_fields = idx + 1;
+      free_schema_cache(schema);
+      Py_DECREF(annotations);
+      return nullptr;
+    }
+    PyObject *index = PyLong_FromSsize_t(idx);
+    if (!index || PyDict_SetItem(schema->field_index, key, index) < 0) {
+      PyErr_Clear();
+    }
+    Py_XDECREF(index);
     idx++;
   }
   Py_DECREF(annotations);
+  mark_class_vars(cls, schema);
+  compile_field_keys(schema);
   compile_config(cls, schema);
+  if (schema->deserializers) {
+    for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+      prime_deserializer_cache(schema->fields[i].type_schema,
+                               schema->deserializers);
+    }
+  }
 
   // Directly retrieve __vldt_instance_annotations__; the Python metaclass is
   // expected to have set this correctly.
@@ -614,67 +1233,205 @@ PyObject *compile_schema(PyObject *cls) {
     Py_INCREF(Py_None);
   }
 
-  compile_validators(cls, schema);
+  if (compile_validators(cls, schema) < 0) {
+    free_schema_cache(schema);
+    return nullptr;
+  }
+  // Validators see the whole input or the whole instance, so models with
+  // validators are always validated eagerly.
+  if (schema->has_field_before || schema->has_field_after ||
+      schema->has_model_before || schema->has_model_after) {
+    schema->lazy = 0;
+  }
   schema->cached_to_dict = PyObject_GetAttrString(cls, "to_dict");
-  PyObject *capsule = PyCapsule_New(
-      static_cast<void *>(schema), "vldt.SchemaCache", [](PyObject *capsule) {
-        auto schema = static_cast<SchemaCache *>(
-            PyCapsule_GetPointer(capsule, "vldt.SchemaCache"));
-        if (schema) {
-          for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
-            FieldSchema *fs = &schema->fields[i];
-            Py_DECREF(fs->field_name);
-            if (fs->alias) {
-              Py_DECREF(fs->alias);
-            }
-            Py_DECREF(fs->default_value);
-            Py_DECREF(fs->default_factory);
-            if (fs->type_schema) {
-              free_type_schema(fs->type_schema);
-            }
-          }
-          delete[] schema->fields;
-          Py_DECREF(schema->config);
-          Py_DECREF(schema->dict_serializer);
-          Py_DECREF(schema->json_serializer);
-          Py_DECREF(schema->instance_annotations);
-          Py_DECREF(schema->validators);
-          Py_DECREF(schema->cached_to_dict);
-          if (schema->deserializers) {
-            free_deserializers(schema->deserializers);
-          }
-          delete schema;
-        }
-      });
-  return capsule;
+  schema->compile_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - compile_started)
+                           .count();
+  return schema;
+}
+
+/**
+ * @brief Looks up the slot index of a field by name.
+ * @param schema The compiled schema.
+ * @param name The attribute name.
+ * @return The field index, FIELD_CLASS_VAR, or FIELD_NOT_FOUND.
+ */
+Py_ssize_t lookup_field_index(SchemaCache *schema, PyObject *name) {
+  PyObject *index = PyDict_GetItemWithError(schema->field_index, name);
+  if (!index) {
+    PyErr_Clear();
+    return FIELD_NOT_FOUND;
+  }
+  return PyLong_AsSsize_t(index);
 }
 
 /**
- * @brief Retrieves a cached schema for the class if available.
+ * @brief Compiles and caches the schema of a class on first use.
+ *
+ * Classes created by ModelMeta keep the pointer in their type object; any
+ * other class falls back to a capsule in its own tp_dict.
+ *
  * @param cls The class object.
- * @return A new reference to the schema capsule.
+ * @return Borrowed pointer to the schema, or nullptr with an exception set.
  */
-PyObject *get_schema_cached(PyObject *cls) {
+SchemaCache *compile_schema_cached(PyObject *cls) {
+  if (PyObject_TypeCheck(cls, &ModelMetaType)) {
+    auto model_type = reinterpret_cast<ModelTypeObject *>(cls);
+    std::atomic_ref<SchemaCache *> slot(model_type->schema);
+    SchemaCache *schema = slot.load(std::memory_order_acquire);
+    if (schema) {
+      return schema;
+    }
+    schema = compile_schema(cls);
+    if (!schema) {
+      if (!PyErr_Occurred()) {
+        PyErr_SetString(PyExc_TypeError, "Could not compile model schema");
+      }
+      return nullptr;
+    }
+    // Compiling runs Python code, so another thread may have published a
+    // schema meanwhile; the first one published is kept.
+    SchemaCache *published = nullptr;
+    if (!slot.compare_exchange_strong(published, schema,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+      free_schema_cache(schema);
+      return published;
+    }
+    return schema;
+  }
+
+  if (!PyType_Check(cls)) {
+    PyErr_SetString(PyExc_TypeError, "Expected a model class");
+    return nullptr;
+  }
   auto type_dict = reinterpret_cast<PyTypeObject *>(cls)->tp_dict;
   if (type_dict && PyDict_Check(type_dict)) {
-    if (!unified_schema_key) {
-      unified_schema_key = PyUnicode_InternFromString("__vldt_schema__");
-    }
     PyObject *capsule = PyDict_GetItem(type_dict, unified_schema_key);
     if (capsule) {
-      Py_INCREF(capsule);
-      return capsule;
+      return static_cast<SchemaCache *>(
+          PyCapsule_GetPointer(capsule, "vldt.SchemaCache"));
     }
   }
-  PyObject *capsule = compile_schema(cls);
+  SchemaCache *schema = compile_schema(cls);
+  if (!schema) {
+    if (!PyErr_Occurred()) {
+      PyErr_SetString(PyExc_TypeError, "Could not compile model schema");
+    }
+    return nullptr;
+  }
+  PyObject *capsule = PyCapsule_New(
+      static_cast<void *>(schema), "vldt.SchemaCache", [](PyObject *capsule) {
+        auto schema = static_cast<SchemaCache *>(
+            PyCapsule_GetPointer(capsule, "vldt.SchemaCache"));
+        if (schema) {
+          free_schema_cache(schema);
+        }
+      });
   if (!capsule) {
+    free_schema_cache(schema);
     return nullptr;
   }
-  if (type_dict && PyDict_Check(type_dict)) {
-    if (!unified_schema_key) {
-      unified_schema_key = PyUnicode_InternFromString("__vldt_schema__");
+  // As above, the first schema cached is kept; dropping the capsule of
+  // another one frees it.
+  PyObject *stored =
+      (type_dict && PyDict_Check(type_dict))
+          ? PyDict_SetDefault(type_dict, unified_schema_key, capsule)
+          : nullptr;
+  if (stored) {
+    schema = static_cast<SchemaCache *>(
+        PyCapsule_GetPointer(stored, "vldt.SchemaCache"));
+  }
+  Py_DECREF(capsule);
+  if (!stored) {
+    if (!PyErr_Occurred()) {
+      PyErr_SetString(PyExc_TypeError, "Could not cache model schema");
     }
-    PyDict_SetItem(type_dict, unified_schema_key, capsule);
+    return nullptr;
+  }
+  return schema;
+}
+
+/**
+ * @brief Create the keys under which schemas are cached in type dicts.
+ */
+int init_schema_globals(void) {
+  cached_type_schema_key = PyUnicode_InternFromString("__vldt_type_schema__");
+  unified_schema_key = PyUnicode_InternFromString("__vldt_schema__");
+  if (!cached_type_schema_key || !unified_schema_key) {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief ModelMeta deallocator: releases the schema, then the type itself.
+ *
+ * The object is untracked while the schema is freed, since releasing it may
+ * run arbitrary code, and re-tracked for type's own deallocator.
+ *
+ * @param self The model class being destroyed.
+ */
+static void ModelMeta_dealloc(PyObject *self) {
+  auto model_type = reinterpret_cast<ModelTypeObject *>(self);
+  if (model_type->schema) {
+    PyObject_GC_UnTrack(self);
+    SchemaCache *schema = model_type->schema;
+    model_type->schema = nullptr;
+    free_schema_cache(schema);
+    PyObject_GC_Track(self);
   }
-  return capsule;
+  PyType_Type.tp_dealloc(self);
 }
+
+PyTypeObject ModelMetaType = {
+    .ob_base = {.ob_base = {.ob_refcnt = 1, .ob_type = &PyType_Type},
+                .ob_size = 0},
+    .tp_name = "vldt._vldt.ModelMeta",
+    .tp_basicsize = sizeof(ModelTypeObject),
+    .tp_itemsize = sizeof(PyMemberDef),
+    .tp_dealloc = ModelMeta_dealloc,
+    .tp_vectorcall_offset = 0,
+    .tp_getattr = nullptr,
+    .tp_setattr = nullptr,
+    .tp_as_async = nullptr,
+    .tp_repr = nullptr,
+    .tp_as_number = nullptr,
+    .tp_as_sequence = nullptr,
+    .tp_as_mapping = nullptr,
+    .tp_hash = nullptr,
+    .tp_call = nullptr,
+    .tp_str = nullptr,
+    .tp_getattro = nullptr,
+    .tp_setattro = nullptr,
+    .tp_as_buffer = nullptr,
+    // GC support, traverse and clear are inherited from type.
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = "Metatype of model classes, holding their compiled schema",
+    .tp_traverse = nullptr,
+    .tp_clear = nullptr,
+    .tp_richcompare = nullptr,
+    .tp_weaklistoffset = 0,
+    .tp_iter = nullptr,
+    .tp_iternext = nullptr,
+    .tp_methods = nullptr,
+    .tp_members = nullptr,
+    .tp_getset = nullptr,
+    .tp_base = &PyType_Type,
+    .tp_dict = nullptr,
+    .tp_descr_get = nullptr,
+    .tp_descr_set = nullptr,
+    .tp_dictoffset = 0,
+    .tp_init = nullptr,
+    .tp_alloc = nullptr,
+    .tp_new = nullptr,
+    .tp_free = nullptr,
+    .tp_is_gc = nullptr,
+    .tp_bases = nullptr,
+    .tp_mro = nullptr,
+    .tp_cache = nullptr,
+    .tp_subclasses = nullptr,
+    .tp_weaklist = nullptr,
+    .tp_del = nullptr,
+    .tp_version_tag = 0,
+    .tp_finalize = nullptr};
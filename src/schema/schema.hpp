@@ -2,6 +2,9 @@
 
 #include "schema/deserializer.hpp" // Include the deserializers header
 #include <Python.h>
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,6 +29,74 @@ enum ContainerKind {
   CK_UNION = 5
 };
 
+/**
+ * @brief Validation opcodes.
+ *
+ * Each TypeSchema is lowered to one opcode when compiled; validation is a
+ * single switch over it. Primitive and class opcodes accept an exact type
+ * match before anything else and only fall back to coercion on a miss.
+ *
+ * OP_CONSTRUCT (0): generic type validated by calling its constructor
+ * OP_ANY (1): typing.Any, accepted as is
+ * OP_INT, OP_STR, OP_FLOAT, OP_BOOL (2-5): the primitive types
+ * OP_PLAIN (6): any other non-generic type
+ * OP_MODEL (7): a DataModel subclass
+ * OP_LIST, OP_DICT, OP_TUPLE, OP_SET (8-11): the container types
+ * OP_OPTIONAL (12): Optional[X] for a non-generic X, validated as X
+ * OP_UNION (13): any other union
+ * OP_DATETIME, OP_DATE, OP_TIME (14-16): datetime types, parsed from ISO 8601
+ * OP_UUID (17): uuid.UUID
+ * OP_DECIMAL (18): decimal.Decimal
+ * OP_ENUM (19): an Enum subclass, looked up by member value
+ */
+enum ValidationOp {
+  OP_CONSTRUCT = 0,
+  OP_ANY = 1,
+  OP_INT = 2,
+  OP_STR = 3,
+  OP_FLOAT = 4,
+  OP_BOOL = 5,
+  OP_PLAIN = 6,
+  OP_MODEL = 7,
+  OP_LIST = 8,
+  OP_DICT = 9,
+  OP_TUPLE = 10,
+  OP_SET = 11,
+  OP_OPTIONAL = 12,
+  OP_UNION = 13,
+  OP_DATETIME = 14,
+  OP_DATE = 15,
+  OP_TIME = 16,
+  OP_UUID = 17,
+  OP_DECIMAL = 18,
+  OP_ENUM = 19
+};
+
+/**
+ * @brief Sentinel results of lookup_field_index.
+ *
+ * FIELD_NOT_FOUND (-1): the name is not annotated on the model
+ * FIELD_CLASS_VAR (-2): the name is annotated as a ClassVar
+ */
+enum FieldIndexKind { FIELD_NOT_FOUND = -1, FIELD_CLASS_VAR = -2 };
+
+/**
+ * @brief Number of entries in the deserializer cache of a TypeSchema.
+ */
+enum { DESERIALIZER_CACHE_SIZE = 4 };
+
+/**
+ * @brief One entry of the deserializer cache of a TypeSchema.
+ *
+ * Records the function the Deserializers with the given id registers for
+ * converting from_type to the schema's type, or that it registers none.
+ */
+struct DeserializerCacheEntry {
+  uint64_t owner;      // Deserializers::id, or 0 for an unused entry.
+  PyObject *from_type; // Strong reference.
+  PyObject *func;      // Strong reference, or nullptr if none is registered.
+};
+
 /**
  * @brief A structure that caches generic type information.
  *
@@ -39,6 +110,14 @@ enum ContainerKind {
  *  - Flags for model and optional types.
  *  - Container information: container_kind and, if applicable,
  *    inner_model_type.
+ *  - For unions, dispatch tables mapping an exact member type, or the value
+ *    of a discriminator key, to the index of the candidate in args, and the
+ *    input keys of the discriminator: its aliases and its name.
+ *  - The validation opcode and, for OP_OPTIONAL, the non-None member or,
+ *    for OP_ENUM, the value-to-member map of the class.
+ *  - A small inline cache of the deserializers looked up for the type.
+ *    Leaf schemas are shared between models, so entries are keyed by the
+ *    owning Deserializers as well as by the source type.
  */
 struct TypeSchema {
   PyObject *expected_type;
@@ -52,6 +131,35 @@ struct TypeSchema {
   int cached;
   int container_kind;
   PyObject *inner_model_type;
+  PyObject *type_table;    // Union of plain types: member type -> index.
+  PyObject *tag_table;     // Discriminated union: tag value -> index.
+  PyObject *discriminator; // Discriminated union: name of the tag field.
+  PyObject *tag_keys; // Discriminated union: list of the keys that may hold
+                      // the tag, the aliases of the tag field first.
+  int op;                  // ValidationOp.
+  struct TypeSchema *optional_target; // OP_OPTIONAL: the non-None member.
+  PyObject *enum_members;             // OP_ENUM: _value2member_map_.
+  struct DeserializerCacheEntry deserializer_cache[DESERIALIZER_CACHE_SIZE];
+  unsigned int deserializer_cache_next; // Entry replaced on the next miss.
+};
+
+/**
+ * @brief A validator resolved for calling.
+ */
+struct CompiledValidator {
+  PyObject *func; // Strong reference to the unwrapped callable.
+  int with_cls;   // Called as func(cls, target) instead of func(target).
+};
+
+/**
+ * @brief The validators run in order on one target.
+ *
+ * Compiled once from __vldt_validators__, with classmethods and
+ * staticmethods already unwrapped.
+ */
+struct ValidatorChain {
+  struct CompiledValidator *items = nullptr;
+  Py_ssize_t count = 0;
 };
 
 /**
@@ -69,28 +177,70 @@ struct FieldSchema {
   PyObject *default_value;
   PyObject *default_factory;
   TypeSchema *type_schema;
+  struct ValidatorChain before_validators; // Field BEFORE validators.
+  struct ValidatorChain after_validators;  // Field AFTER validators.
 };
 
+/**
+ * @brief An input key naming a field: the field name or one of its aliases.
+ *
+ * Entries of the open-addressing key table of a SchemaCache; an entry with
+ * a null name is empty.
+ */
+struct FieldKey {
+  const char *name;    // UTF-8 text, owned by key.
+  Py_ssize_t len;      // Length of name in bytes.
+  uint64_t hash;       // FNV-1a hash of name.
+  PyObject *key;       // Borrowed str: the field name or the alias.
+  Py_ssize_t field;    // Index into SchemaCache::fields.
+  Py_ssize_t priority; // Lookup order within the field: aliases first.
+};
+
+/**
+ * @brief Default number of recycled instances kept per model class.
+ */
+enum { DEFAULT_FREELIST_SIZE = 64 };
+
 /**
  * @brief Structure aggregating model-level schema information.
  *
  * Contains an array of FieldSchema entries plus any configuration/validator
- * settings.
+ * settings, and the freelist of deallocated instances of the class that are
+ * reused by the next allocations.
  */
 struct SchemaCache {
   FieldSchema *fields;
   Py_ssize_t num_fields;
+  PyObject *field_index; // Dict mapping field names to slot indices and
+                         // ClassVar names to FIELD_CLASS_VAR.
+  struct FieldKey *field_keys; // Key table of the fields, or nullptr if a
+                               // key names several fields.
+  size_t field_key_mask;       // Number of table entries minus one.
   PyObject *config;
   PyObject *dict_serializer;
   PyObject *json_serializer;
   PyObject *instance_annotations;
   PyObject *validators;
+  struct ValidatorChain model_before; // Model BEFORE validators.
+  struct ValidatorChain model_after;  // Model AFTER validators.
   PyObject *cached_to_dict;
+  size_t json_size_hint; // Running average of to_json output sizes, accessed
+                         // through std::atomic_ref.
   int has_field_before;
   int has_field_after;
   int has_model_before;
   int has_model_after;
+  int lazy; // Fields are validated on first access (Config.lazy).
+  int patch_validators; // apply_patch runs the validators
+                        // (Config.patch_validators).
   Deserializers *deserializers;
+  PyObject *free_instances;     // Recycled instances, linked in a list.
+  Py_ssize_t free_count;        // Length of the free_instances list.
+  Py_ssize_t free_limit;        // Longest list kept (Config.freelist_size).
+  Py_ssize_t instances_reused;  // Allocations served from the freelist.
+  Py_ssize_t instances_created; // Allocations served by tp_alloc.
+  Py_ssize_t compile_ns;        // Time spent compiling the schema.
+  struct ModelStats *stats;     // Counters of vldt.stats(), or nullptr.
 };
 
 /**
@@ -109,14 +259,140 @@ TypeSchema *compile_type_schema(PyObject *expected_type);
 void free_type_schema(TypeSchema *ts);
 
 /**
- * @brief Retrieves a cached SchemaCache for the given model class.
+ * @brief Finds the deserializer converting a source type to a schema's type.
+ *
+ * Answered from the inline cache of the TypeSchema when possible; a miss is
+ * resolved from the Deserializers map and recorded, including the absence of
+ * a deserializer.
+ *
+ * @param ts The TypeSchema of the target type.
+ * @param deserializers The deserializers of the model being validated.
+ * @param from_type The type of the value to convert.
+ * @return Borrowed reference to the function, or nullptr if none is
+ * registered. No Python exception is set.
+ */
+PyObject *find_deserializer(TypeSchema *ts, Deserializers *deserializers,
+                            PyObject *from_type);
+
+/**
+ * @brief Fills the deserializer caches of a TypeSchema tree.
+ *
+ * Records every function registered for the type of each schema, so that
+ * validation finds them without consulting the map.
+ *
+ * @param ts The root TypeSchema.
+ * @param deserializers The deserializers of the model owning the schema.
+ */
+void prime_deserializer_cache(TypeSchema *ts, Deserializers *deserializers);
+
+/**
+ * @brief Looks up the slot index of a field by name.
+ *
+ * @param schema The compiled schema.
+ * @param name The attribute name (a str object).
+ * @return The index into SchemaCache::fields, FIELD_CLASS_VAR for ClassVar
+ * annotations, or FIELD_NOT_FOUND otherwise. No Python exception is left set.
+ */
+Py_ssize_t lookup_field_index(SchemaCache *schema, PyObject *name);
+
+/**
+ * @brief Hashes the bytes of an input key for lookup_field_key.
  *
- * If the schema is not cached on the class, it is compiled.
+ * @param name The key text.
+ * @param len Length of the text in bytes.
+ * @return The FNV-1a hash of the text.
+ */
+static inline uint64_t hash_field_key(const char *name, size_t len) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; i++) {
+    hash = (hash ^ static_cast<unsigned char>(name[i])) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Looks up the field named by the raw bytes of an input key.
+ *
+ * Lets JSON members bind to field slots without creating a str for the key.
+ *
+ * @param schema The compiled schema; its field_keys must be set.
+ * @param name The key text (not necessarily NUL-terminated).
+ * @param len Length of the text in bytes.
+ * @return The table entry, or nullptr if the key names no field.
+ */
+static inline const struct FieldKey *
+lookup_field_key(struct SchemaCache *schema, const char *name, size_t len) {
+  uint64_t hash = hash_field_key(name, len);
+  for (size_t i = hash & schema->field_key_mask;;
+       i = (i + 1) & schema->field_key_mask) {
+    const struct FieldKey *entry = &schema->field_keys[i];
+    if (!entry->name) {
+      return nullptr;
+    }
+    if (entry->hash == hash && static_cast<size_t>(entry->len) == len &&
+        memcmp(entry->name, name, len) == 0) {
+      return entry;
+    }
+  }
+}
+
+/**
+ * @brief Layout of a model class: a heap type plus its compiled schema.
+ *
+ * Model classes are instances of ModelMeta (through the Python metaclass),
+ * which allocates this extra pointer with each class. It starts out null, so
+ * a subclass never sees the schema of its base and compiles its own.
+ */
+typedef struct {
+  PyHeapTypeObject ht;
+  struct SchemaCache *schema; // Compiled on first use, freed with the class.
+} ModelTypeObject;
+
+/**
+ * The metatype of model classes; base of the Python DataModelMeta.
+ */
+extern PyTypeObject ModelMetaType;
+
+/**
+ * @brief Compiles the schema of a class and caches it.
+ *
+ * Slow path of get_schema_cached. Threads using a class for the first time
+ * concurrently may each compile a schema; the first one published is kept
+ * and returned to all of them.
  *
  * @param cls The model class (a Python type).
- * @return A new reference to the PyCapsule, or nullptr on error.
+ * @return Borrowed pointer to the schema, or nullptr with an exception set.
  */
-PyObject *get_schema_cached(PyObject *cls);
+struct SchemaCache *compile_schema_cached(PyObject *cls);
+
+/**
+ * @brief Create the keys under which schemas are cached in type dicts.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int init_schema_globals(void);
+
+/**
+ * @brief Retrieves the SchemaCache of a model class.
+ *
+ * For classes created by ModelMeta this is a pointer load once the schema
+ * has been compiled; the first call compiles it.
+ *
+ * @param cls The model class (a Python type).
+ * @return Borrowed pointer to the schema (kept alive by the class), or
+ * nullptr with an exception set.
+ */
+static inline struct SchemaCache *get_schema_cached(PyObject *cls) {
+  if (PyObject_TypeCheck(cls, &ModelMetaType)) {
+    struct SchemaCache *schema =
+        std::atomic_ref<struct SchemaCache *>(((ModelTypeObject *)cls)->schema)
+            .load(std::memory_order_acquire);
+    if (schema) {
+      return schema;
+    }
+  }
+  return compile_schema_cached(cls);
+}
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,349 @@
+#include <Python.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "schema/schema.hpp"
+#include "stats.hpp"
+
+std::atomic<bool> stats_enabled{false};
+constinit thread_local ModelStatsScope *active_stats_scope = nullptr;
+
+namespace {
+
+// Counter shards of each model; threads are spread over them.
+constexpr unsigned kStatsShards = 8;
+
+enum StatsCounter {
+  STAT_INSTANCES,
+  STAT_FAILURES,
+  STAT_VALIDATION_NS,
+  STAT_VALIDATOR_NS,
+  STAT_DESERIALIZER_HITS,
+  STAT_DESERIALIZER_MISSES,
+  STAT_UNION_ATTEMPTS,
+  STAT_COUNT
+};
+
+// Keys of the counters in the dicts returned by vldt.stats().
+const char *const kStatsCounterNames[STAT_COUNT] = {
+    "instances",         "failures",          "validation_ns",
+    "validator_ns",      "deserializer_hits", "deserializer_misses",
+    "union_attempts",
+};
+
+/**
+ * @brief Counters updated by the threads assigned to one shard.
+ */
+struct alignas(64) ModelStatsShard {
+  std::atomic<uint64_t> counters[STAT_COUNT];
+};
+
+// Schemas with counters, guarded by stats_mutex. Counting only takes the
+// lock to register a schema, the first time its model is validated.
+std::mutex stats_mutex;
+std::vector<SchemaCache *> stats_schemas;
+
+/**
+ * @brief Read a monotonic clock.
+ *
+ * @return The current time in nanoseconds.
+ */
+inline uint64_t stats_clock_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @brief Return the shard index of the current thread.
+ */
+inline unsigned stats_shard_index() {
+  static std::atomic<unsigned> next_shard{0};
+  static thread_local const unsigned shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % kStatsShards;
+  return shard;
+}
+
+} // namespace
+
+/**
+ * @brief Counters of one model class.
+ */
+struct ModelStats {
+  ModelStatsShard shards[kStatsShards] = {};
+  std::atomic<uint64_t> *field_failures = nullptr; // One per field.
+  PyObject *model_ref = nullptr; // Weak reference to the model class.
+
+  ~ModelStats() {
+    delete[] field_failures;
+    Py_XDECREF(model_ref);
+  }
+
+  /**
+   * @brief Add to a counter of the current thread's shard.
+   */
+  void add(StatsCounter counter, uint64_t amount) {
+    shards[stats_shard_index()].counters[counter].fetch_add(
+        amount, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sum a counter over the shards.
+   */
+  uint64_t total(StatsCounter counter) const {
+    uint64_t sum = 0;
+    for (const ModelStatsShard &shard : shards) {
+      sum += shard.counters[counter].load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+};
+
+/**
+ * @brief Return the counters of a schema, creating them on first use.
+ *
+ * Counting is best effort: if the counters cannot be created, the error is
+ * cleared and the instance is not counted.
+ *
+ * @param schema The compiled schema.
+ * @param cls The model class.
+ * @return The counters, or nullptr.
+ */
+static ModelStats *acquire_model_stats(SchemaCache *schema, PyObject *cls) {
+  std::atomic_ref<ModelStats *> slot(schema->stats);
+  ModelStats *stats = slot.load(std::memory_order_acquire);
+  if (stats) {
+    return stats;
+  }
+  stats = new (std::nothrow) ModelStats();
+  if (!stats) {
+    return nullptr;
+  }
+  stats->field_failures =
+      new (std::nothrow) std::atomic<uint64_t>[schema->num_fields + 1]();
+  stats->model_ref = PyWeakref_NewRef(cls, nullptr);
+  if (!stats->field_failures || !stats->model_ref) {
+    PyErr_Clear();
+    delete stats;
+    return nullptr;
+  }
+  ModelStats *published = nullptr;
+  if (!slot.compare_exchange_strong(published, stats,
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+    delete stats;
+    return published;
+  }
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  stats_schemas.push_back(schema);
+  return stats;
+}
+
+void ModelStatsScope::start(SchemaCache *schema, PyObject *cls) {
+  stats_ = acquire_model_stats(schema, cls);
+  if (stats_) {
+    previous_ = active_stats_scope;
+    active_stats_scope = this;
+    started_ns_ = stats_clock_ns();
+  }
+}
+
+void ModelStatsScope::finish() {
+  uint64_t elapsed = stats_clock_ns() - started_ns_;
+  active_stats_scope = previous_;
+  stats_->add(STAT_INSTANCES, 1);
+  if (failed_) {
+    stats_->add(STAT_FAILURES, 1);
+  }
+  stats_->add(STAT_VALIDATOR_NS, validator_ns_);
+  stats_->add(STAT_VALIDATION_NS,
+              elapsed > validator_ns_ ? elapsed - validator_ns_ : 0);
+}
+
+ValidatorTimer::ValidatorTimer()
+    : scope_(active_stats_scope), started_ns_(scope_ ? stats_clock_ns() : 0) {
+}
+
+void ValidatorTimer::stop() {
+  scope_->validator_ns_ += stats_clock_ns() - started_ns_;
+}
+
+void stats_count_deserializer(bool hit) {
+  if (active_stats_scope) {
+    active_stats_scope->stats_->add(
+        hit ? STAT_DESERIALIZER_HITS : STAT_DESERIALIZER_MISSES, 1);
+  }
+}
+
+void stats_count_union_attempt() {
+  if (active_stats_scope) {
+    active_stats_scope->stats_->add(STAT_UNION_ATTEMPTS, 1);
+  }
+}
+
+void stats_count_field_failure(Py_ssize_t index) {
+  if (active_stats_scope) {
+    active_stats_scope->stats_->field_failures[index].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+}
+
+void free_model_stats(SchemaCache *schema) {
+  if (!schema->stats) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    auto it = std::find(stats_schemas.begin(), stats_schemas.end(), schema);
+    if (it != stats_schemas.end()) {
+      stats_schemas.erase(it);
+    }
+  }
+  delete schema->stats;
+  schema->stats = nullptr;
+}
+
+/**
+ * @brief Counters of one model, copied out of the registry.
+ */
+struct StatsSnapshot {
+  PyObject *model; // Strong reference to the model class.
+  uint64_t counters[STAT_COUNT];
+  Py_ssize_t compile_ns;
+  std::vector<std::pair<PyObject *, uint64_t>> field_failures; // Own names.
+};
+
+/**
+ * @brief Build the counters dict of one snapshot.
+ *
+ * @param snapshot The snapshot.
+ * @return New reference to the dict, or nullptr on error.
+ */
+static PyObject *snapshot_to_dict(const StatsSnapshot &snapshot) {
+  PyObject *result = PyDict_New();
+  PyObject *fields = PyDict_New();
+  if (!result || !fields) {
+    Py_XDECREF(result);
+    Py_XDECREF(fields);
+    return nullptr;
+  }
+  bool ok = true;
+  for (int i = 0; i < STAT_COUNT && ok; i++) {
+    PyObject *value = PyLong_FromUnsignedLongLong(snapshot.counters[i]);
+    ok = value &&
+         PyDict_SetItemString(result, kStatsCounterNames[i], value) == 0;
+    Py_XDECREF(value);
+  }
+  for (const auto &entry : snapshot.field_failures) {
+    if (!ok) {
+      break;
+    }
+    PyObject *value = PyLong_FromUnsignedLongLong(entry.second);
+    ok = value && PyDict_SetItem(fields, entry.first, value) == 0;
+    Py_XDECREF(value);
+  }
+  if (ok) {
+    PyObject *compile_ns = PyLong_FromSsize_t(snapshot.compile_ns);
+    ok = compile_ns &&
+         PyDict_SetItemString(result, "compile_ns", compile_ns) == 0 &&
+         PyDict_SetItemString(result, "field_failures", fields) == 0;
+    Py_XDECREF(compile_ns);
+  }
+  Py_DECREF(fields);
+  if (!ok) {
+    Py_CLEAR(result);
+  }
+  return result;
+}
+
+PyObject *stats_snapshot(PyObject *Py_UNUSED(module),
+                         PyObject *Py_UNUSED(ignored)) {
+  // Only references are taken under the lock: creating Python objects may
+  // run a collection freeing a model, which takes the lock to unregister.
+  std::vector<StatsSnapshot> snapshots;
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    snapshots.reserve(stats_schemas.size());
+    for (SchemaCache *schema : stats_schemas) {
+      ModelStats *stats = schema->stats;
+      PyObject *model;
+#if PY_VERSION_HEX >= 0x030D0000
+      if (PyWeakref_GetRef(stats->model_ref, &model) <= 0) {
+        PyErr_Clear();
+        continue;
+      }
+#else
+      model = PyWeakref_GetObject(stats->model_ref);
+      if (model == Py_None) {
+        continue;
+      }
+      Py_INCREF(model);
+#endif
+      StatsSnapshot &snapshot = snapshots.emplace_back();
+      snapshot.model = model;
+      for (int i = 0; i < STAT_COUNT; i++) {
+        snapshot.counters[i] = stats->total(static_cast<StatsCounter>(i));
+      }
+      snapshot.compile_ns = schema->compile_ns;
+      for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+        uint64_t failures =
+            stats->field_failures[i].load(std::memory_order_relaxed);
+        if (failures) {
+          snapshot.field_failures.emplace_back(
+              Py_NewRef(schema->fields[i].field_name), failures);
+        }
+      }
+    }
+  }
+
+  PyObject *result = PyDict_New();
+  for (const StatsSnapshot &snapshot : snapshots) {
+    if (result) {
+      PyObject *counters = snapshot_to_dict(snapshot);
+      if (!counters || PyDict_SetItem(result, snapshot.model, counters) < 0) {
+        Py_CLEAR(result);
+      }
+      Py_XDECREF(counters);
+    }
+    Py_DECREF(snapshot.model);
+    for (const auto &entry : snapshot.field_failures) {
+      Py_DECREF(entry.first);
+    }
+  }
+  return result;
+}
+
+PyObject *stats_reset(PyObject *Py_UNUSED(module),
+                      PyObject *Py_UNUSED(ignored)) {
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  for (SchemaCache *schema : stats_schemas) {
+    ModelStats *stats = schema->stats;
+    for (ModelStatsShard &shard : stats->shards) {
+      for (std::atomic<uint64_t> &counter : shard.counters) {
+        counter.store(0, std::memory_order_relaxed);
+      }
+    }
+    for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+      stats->field_failures[i].store(0, std::memory_order_relaxed);
+    }
+  }
+  Py_RETURN_NONE;
+}
+
+static const char *enable_stats_kwlist[] = {"enabled", nullptr};
+
+PyObject *stats_enable(PyObject *Py_UNUSED(module), PyObject *args,
+                       PyObject *kwds) {
+  int enabled = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p:enable_stats",
+                                   const_cast<char **>(enable_stats_kwlist),
+                                   &enabled)) {
+    return nullptr;
+  }
+  return PyBool_FromLong(stats_enabled.exchange(enabled != 0));
+}
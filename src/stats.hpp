@@ -0,0 +1,162 @@
+#pragma once
+
+#include "schema/schema.hpp"
+#include <Python.h>
+#include <atomic>
+#include <stdint.h>
+
+// Whether validation is being counted (vldt.enable_stats).
+extern std::atomic<bool> stats_enabled;
+
+class ModelStatsScope;
+
+// Innermost model being validated by the current thread while counting.
+extern constinit thread_local ModelStatsScope *active_stats_scope;
+
+/**
+ * @brief Counts the validation of one model instance.
+ *
+ * Does nothing unless statistics are enabled. Otherwise the instance is
+ * counted when the scope ends, as a failure unless record() was given 0,
+ * with the time spent in it: the time spent in validators is accounted
+ * separately and the rest, nested models included, as validation time.
+ * While the scope is active, the counting hooks below add to its model.
+ */
+class ModelStatsScope {
+public:
+  /**
+   * @brief Start counting the validation of an instance.
+   *
+   * @param schema The compiled schema of the instance's class.
+   * @param self The instance being validated.
+   */
+  ModelStatsScope(SchemaCache *schema, PyObject *self) {
+    if (stats_enabled.load(std::memory_order_relaxed)) {
+      start(schema, (PyObject *)Py_TYPE(self));
+    }
+  }
+  ModelStatsScope(const ModelStatsScope &) = delete;
+  ModelStatsScope &operator=(const ModelStatsScope &) = delete;
+  ~ModelStatsScope() {
+    if (stats_) {
+      finish();
+    }
+  }
+
+  /**
+   * @brief Record the outcome of the validation.
+   *
+   * @param status 0 if the instance was validated, nonzero otherwise.
+   * @return The status, unchanged.
+   */
+  int record(int status) {
+    failed_ = status != 0;
+    return status;
+  }
+
+private:
+  void start(SchemaCache *schema, PyObject *cls);
+  void finish();
+
+  friend class ValidatorTimer;
+  friend void stats_count_deserializer(bool hit);
+  friend void stats_count_union_attempt();
+  friend void stats_count_field_failure(Py_ssize_t index);
+
+  struct ModelStats *stats_ = nullptr;
+  ModelStatsScope *previous_ = nullptr;
+  uint64_t started_ns_ = 0;
+  uint64_t validator_ns_ = 0;
+  bool failed_ = true;
+};
+
+/**
+ * @brief Accounts the time until it is destroyed as validator time.
+ */
+class ValidatorTimer {
+public:
+  ValidatorTimer();
+  ValidatorTimer(const ValidatorTimer &) = delete;
+  ValidatorTimer &operator=(const ValidatorTimer &) = delete;
+  ~ValidatorTimer() {
+    if (scope_) {
+      stop();
+    }
+  }
+
+private:
+  void stop();
+
+  ModelStatsScope *scope_;
+  uint64_t started_ns_;
+};
+
+/**
+ * @brief Count a deserializer lookup of the model being validated.
+ *
+ * @param hit Whether a deserializer was found for the value.
+ */
+void stats_count_deserializer(bool hit);
+
+/**
+ * @brief Count a conversion attempted for a union member.
+ */
+void stats_count_union_attempt();
+
+/**
+ * @brief Count a field of the model being validated as failed.
+ *
+ * @param index The field index.
+ */
+void stats_count_field_failure(Py_ssize_t index);
+
+/**
+ * @brief Release the counters of a schema, if it has any.
+ *
+ * @param schema The schema being freed.
+ */
+void free_model_stats(SchemaCache *schema);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief vldt.stats implementation.
+ *
+ * Returns a dict mapping each model class validated while statistics were
+ * enabled to a dict of its counters: instances, failures, validation_ns,
+ * validator_ns, deserializer_hits, deserializer_misses, union_attempts,
+ * compile_ns and field_failures, a dict of failures by field name.
+ *
+ * @param module The extension module.
+ * @param Py_UNUSED(ignored) Unused parameter.
+ * @return A new dict, or NULL on error.
+ */
+PyObject *stats_snapshot(PyObject *module, PyObject *Py_UNUSED(ignored));
+
+/**
+ * @brief vldt.reset_stats implementation: zero every counter.
+ *
+ * @param module The extension module.
+ * @param Py_UNUSED(ignored) Unused parameter.
+ * @return None.
+ */
+PyObject *stats_reset(PyObject *module, PyObject *Py_UNUSED(ignored));
+
+/**
+ * @brief vldt.enable_stats implementation.
+ *
+ * Accepts an optional enabled flag, True by default. Counters collected so
+ * far are kept when counting is disabled.
+ *
+ * @param module The extension module.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @return True if statistics were enabled before the call, False otherwise.
+ */
+PyObject *stats_enable(PyObject *module, PyObject *args, PyObject *kwds);
+
+#ifdef __cplusplus
+}
+#endif
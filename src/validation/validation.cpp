@@ -1,86 +1,98 @@
 #include <Python.h>
-#include <array>
-#include <stdio.h>
 #include <string>
 
+#include "data_model.hpp"
 #include "error_handling.hpp"
 #include "init_globals.hpp"
 #include "schema/deserializer.hpp"
 #include "schema/schema.hpp"
+#include "stats.hpp"
 #include "validation.hpp"
+#include "validation_builtins.hpp"
 #include "validation_containers.hpp"
 #include "validation_primitives.hpp"
 
 /**
- * @brief Safely retrieves the type name of a PyObject.
+ * @brief Records the pending Python exception as nested model errors.
  *
- * This function returns the __name__ attribute of a type if available.
- * If the object is not a type or the name cannot be determined, it returns
- * a default "<unknown>" string.
+ * The errors of a ValidationError are merged under the given path; for other
+ * exceptions the exception text is added as suberrors.
  *
- * @param obj Pointer to a PyObject.
- * @return A const char* representing the type name.
+ * @param collector Pointer to an ErrorCollector for reporting errors.
+ * @param error_path The base error path.
  */
-static const char *safe_type_name(PyObject *obj) {
-  if (!obj) {
-    return "<unknown>";
-  }
-  if (PyType_Check(obj)) {
-    PyObject *name_obj = PyObject_GetAttrString(obj, "__name__");
-    if (!name_obj) {
-      PyErr_Clear();
-      name_obj = PyObject_GetAttrString(obj, "__qualname__");
+static void record_nested_exception(ErrorCollector *collector,
+                                    const ErrorPath *error_path) {
+  PyObject *exc_type = nullptr, *exc_value = nullptr, *exc_tb = nullptr;
+  PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+  const std::vector<ErrorRecord> *records = validation_error_records(exc_value);
+  if (records) {
+    if (collector) {
+      collector->merge(ErrorPath::format(error_path), *records);
     }
-    if (name_obj) {
-      const char *name = PyUnicode_AsUTF8(name_obj);
-      Py_DECREF(name_obj);
-      if (name) {
-        return name;
-      }
+  } else {
+    PyObject *exc_str = exc_value ? PyObject_Str(exc_value) : nullptr;
+    const char *nested_json =
+        exc_str ? PyUnicode_AsUTF8(exc_str) : "Unknown error";
+    if (collector) {
+      collector->add_suberror(ErrorPath::format(error_path),
+                              nested_json ? nested_json : "Unknown error");
     }
-    return ((PyTypeObject *)obj)->tp_name;
-  }
-  PyTypeObject *type = Py_TYPE(obj);
-  if (!type || !type->tp_name) {
-    return "<unknown>";
+    Py_XDECREF(exc_str);
   }
-  return type->tp_name;
+  Py_XDECREF(exc_type);
+  Py_XDECREF(exc_value);
+  Py_XDECREF(exc_tb);
+  PyErr_Clear();
 }
 
 /**
  * @brief Validates and converts a DataModel from a Python dictionary.
  *
- * This function attempts to construct a new object of the expected type by
- * calling its constructor with the provided value. If an exception occurs,
- * the error is captured and reported via the ErrorCollector.
+ * Models using the built-in DataModel construction are allocated and
+ * initialized directly, recording field errors in the caller's collector
+ * under error_path. Other models (e.g. ones overriding __init__ in Python)
+ * are constructed by calling the class, and the raised error is captured
+ * and reported via the ErrorCollector.
  *
  * @param value The Python object to validate.
  * @param ts Pointer to the TypeSchema describing the expected type.
  * @param collector Pointer to an ErrorCollector for reporting errors.
- * @param error_path A string representing the path for error messages.
+ * @param error_path The base error path.
  * @param deserializers Pointer to registered deserializers.
  * @return A new PyObject on success, or nullptr on error.
  */
 static PyObject *validate_data_model(PyObject *value, TypeSchema *ts,
                                      ErrorCollector *collector,
-                                     const char *error_path,
+                                     const ErrorPath *error_path,
                                      Deserializers *deserializers) {
-  PyObject *converted = PyObject_Call(ts->expected_type, empty_tuple, value);
-  if (converted) {
-    return converted;
-  } else {
-    PyObject *exc_type = nullptr, *exc_value = nullptr, *exc_tb = nullptr;
-    PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
-    PyObject *exc_str = PyObject_Str(exc_value);
-    const char *nested_json =
-        exc_str ? PyUnicode_AsUTF8(exc_str) : "Unknown error";
-    if (collector) {
-      collector->add_suberror(error_path, nested_json);
+  PyTypeObject *type = reinterpret_cast<PyTypeObject *>(ts->expected_type);
+  if (!DataModel_supports_native_init(type)) {
+    PyObject *converted = PyObject_Call(ts->expected_type, empty_tuple, value);
+    if (!converted) {
+      record_nested_exception(collector, error_path);
     }
-    Py_XDECREF(exc_str);
-    PyErr_Clear();
+    return converted;
+  }
+
+  SchemaCache *schema = get_schema_cached(ts->expected_type);
+  PyObject *instance = schema ? DataModel_alloc(type, schema) : nullptr;
+  if (!instance) {
+    record_nested_exception(collector, error_path);
     return nullptr;
   }
+  ErrorCollector local;
+  int result = DataModel_init_nested(instance, value, schema,
+                                     collector ? collector : &local,
+                                     error_path);
+  if (result == 0) {
+    return instance;
+  }
+  Py_DECREF(instance);
+  if (result < 0) {
+    record_nested_exception(collector, error_path);
+  }
+  return nullptr;
 }
 
 /**
@@ -88,31 +100,36 @@ static PyObject *validate_data_model(PyObject *value, TypeSchema *ts,
  *
  * If the value is already an instance of the expected type, it is returned.
  * Otherwise, a registered deserializer is attempted, and if that fails,
- * the function attempts specific validations for basic types.
+ * the function attempts specific validations for basic types. Deserializers
+ * are found through the inline cache of the TypeSchema.
  *
  * @param value The Python object to validate.
  * @param ts Pointer to the TypeSchema describing the expected type.
  * @param collector Pointer to an ErrorCollector for reporting errors.
- * @param error_path A string representing the path for error messages.
+ * @param error_path The base error path.
  * @param deserializers Pointer to registered deserializers.
  * @return A new PyObject on success, or nullptr on error.
  */
 static PyObject *validate_plain(PyObject *value, TypeSchema *ts,
                                 ErrorCollector *collector,
-                                const char *error_path,
+                                const ErrorPath *error_path,
                                 Deserializers *deserializers) {
   if (PyObject_IsInstance(value, ts->expected_type)) {
     Py_INCREF(value);
     return value;
   } else {
-    PyObject *deserializer_func = nullptr;
+    PyObject *deserializer_func =
+        deserializers ? find_deserializer(ts, deserializers,
+                                          (PyObject *)Py_TYPE(value))
+                      : nullptr;
     if (deserializers) {
-      deserializer_func = get_deserializer(deserializers, ts->expected_type,
-                                           (PyObject *)Py_TYPE(value));
+      stats_count_deserializer(deserializer_func != nullptr);
     }
-    if (deserializer_func && deserializer_func != Py_None) {
-      PyObject *deserialized =
-          PyObject_CallFunctionObjArgs(deserializer_func, value, nullptr);
+    if (deserializer_func) {
+      // The call may evict the cache entry holding the function.
+      Py_INCREF(deserializer_func);
+      PyObject *deserialized = PyObject_CallOneArg(deserializer_func, value);
+      Py_DECREF(deserializer_func);
       if (deserialized &&
           PyObject_IsInstance(deserialized, ts->expected_type)) {
         return deserialized;
@@ -134,17 +151,14 @@ static PyObject *validate_plain(PyObject *value, TypeSchema *ts,
       return validate_bool(value, collector, error_path);
     }
 
-    PyObject *conv =
-        PyObject_CallFunctionObjArgs(ts->expected_type, value, nullptr);
+    PyObject *conv = PyObject_CallOneArg(ts->expected_type, value);
     if (conv && PyObject_IsInstance(conv, ts->expected_type)) {
       return conv;
     }
     Py_XDECREF(conv);
     PyErr_Clear();
     if (collector) {
-      collector->add_error(error_path, std::string("Expected type ") +
-                                           safe_type_name(ts->expected_type) +
-                                           ", got " + safe_type_name(value));
+      collector->add_type_error(error_path, ts->expected_type, value);
     }
     return nullptr;
   }
@@ -160,25 +174,22 @@ static PyObject *validate_plain(PyObject *value, TypeSchema *ts,
  * @param value The Python object to convert.
  * @param ts Pointer to the TypeSchema describing the expected type.
  * @param collector Pointer to an ErrorCollector for reporting errors.
- * @param error_path A string representing the path for error messages.
+ * @param error_path The base error path.
  * @param deserializers Pointer to registered deserializers.
  * @return A new PyObject on success, or nullptr on error.
  */
 static PyObject *convert_using_constructor(PyObject *value, TypeSchema *ts,
                                            ErrorCollector *collector,
-                                           const char *error_path,
+                                           const ErrorPath *error_path,
                                            Deserializers *deserializers) {
-  PyObject *conv =
-      PyObject_CallFunctionObjArgs(ts->expected_type, value, nullptr);
+  PyObject *conv = PyObject_CallOneArg(ts->expected_type, value);
   if (conv && PyObject_IsInstance(conv, ts->expected_type)) {
     return conv;
   }
   Py_XDECREF(conv);
   PyErr_Clear();
   if (collector) {
-    collector->add_error(error_path, std::string("Expected type ") +
-                                         safe_type_name(ts->expected_type) +
-                                         ", got " + safe_type_name(value));
+    collector->add_type_error(error_path, ts->expected_type, value);
   }
   return nullptr;
 }
@@ -186,63 +197,109 @@ static PyObject *convert_using_constructor(PyObject *value, TypeSchema *ts,
 /**
  * @brief Validates and converts a Python object to the expected type.
  *
- * This function handles conversion for optional types, data models, containers,
- * unions, and plain types by dispatching to appropriate helper functions.
+ * Runs the opcode the schema was lowered to. Exact type matches are accepted
+ * first; conversion is only attempted when they miss. Standard library types
+ * are converted natively unless a deserializer is registered for them.
  *
  * @param value The Python object to validate.
  * @param ts Pointer to the TypeSchema describing the expected type.
  * @param collector Pointer to an ErrorCollector for reporting errors.
- * @param error_path A string representing the path for error messages.
+ * @param error_path The base error path.
  * @param deserializers Pointer to registered deserializers.
  * @return A new PyObject on success, or nullptr on error.
  */
 PyObject *validate_and_convert(PyObject *value, TypeSchema *ts,
                                ErrorCollector *collector,
-                               const char *error_path,
+                               const ErrorPath *error_path,
                                Deserializers *deserializers) {
-  if (value == Py_None) {
-    if (ts->is_optional) {
-      Py_INCREF(Py_None);
-      return Py_None;
-    }
-  }
-
-  if (ts->expected_type == AnyType) {
+  switch (ts->op) {
+  case OP_ANY:
     Py_INCREF(value);
     return value;
-  }
-
-  if (ts->is_data_model && PyDict_Check(value)) {
-    return validate_data_model(value, ts, collector, error_path, deserializers);
-  }
-
-  switch (ts->container_kind) {
-  case CK_LIST:
+  case OP_INT:
+    if (PyLong_CheckExact(value)) {
+      Py_INCREF(value);
+      return value;
+    }
+    break;
+  case OP_STR:
+    if (PyUnicode_CheckExact(value)) {
+      Py_INCREF(value);
+      return value;
+    }
+    break;
+  case OP_FLOAT:
+    if (PyFloat_CheckExact(value)) {
+      Py_INCREF(value);
+      return value;
+    }
+    break;
+  case OP_BOOL:
+    if (PyBool_Check(value)) {
+      Py_INCREF(value);
+      return value;
+    }
+    break;
+  case OP_PLAIN:
+    if ((PyObject *)Py_TYPE(value) == ts->expected_type) {
+      Py_INCREF(value);
+      return value;
+    }
+    break;
+  case OP_MODEL:
+    if ((PyObject *)Py_TYPE(value) == ts->expected_type) {
+      Py_INCREF(value);
+      return value;
+    }
+    if (PyDict_Check(value)) {
+      return validate_data_model(value, ts, collector, error_path,
+                                 deserializers);
+    }
+    break;
+  case OP_LIST:
     return validate_list(value, ts, collector, error_path, deserializers);
-  case CK_DICT:
+  case OP_DICT:
     return validate_dict(value, ts, collector, error_path, deserializers);
-  case CK_TUPLE:
+  case OP_TUPLE:
     return validate_tuple(value, ts, collector, error_path, deserializers);
-  case CK_SET:
+  case OP_SET:
     return validate_set(value, ts, collector, error_path, deserializers);
-  }
-
-  if (ts->origin == Py_None) {
-    return validate_plain(value, ts, collector, error_path, deserializers);
-  }
-
-  if (ts->container_kind == CK_UNION) {
+  case OP_OPTIONAL:
+    return validate_optional(value, ts, collector, error_path, deserializers);
+  case OP_UNION:
+    if (value == Py_None && ts->is_optional) {
+      Py_INCREF(Py_None);
+      return Py_None;
+    }
     return validate_union(value, ts, collector, error_path, deserializers);
+  case OP_DATETIME:
+  case OP_DATE:
+  case OP_TIME:
+  case OP_UUID:
+  case OP_DECIMAL:
+  case OP_ENUM:
+    if ((PyObject *)Py_TYPE(value) == ts->expected_type) {
+      Py_INCREF(value);
+      return value;
+    }
+    // A deserializer registered for the source type takes precedence.
+    if (!deserializers ||
+        !find_deserializer(ts, deserializers, (PyObject *)Py_TYPE(value))) {
+      return validate_builtin(value, ts, collector, error_path);
+    }
+    break;
+  case OP_CONSTRUCT:
+    return convert_using_constructor(value, ts, collector, error_path,
+                                     deserializers);
   }
-
-  return convert_using_constructor(value, ts, collector, error_path,
-                                   deserializers);
+  return validate_plain(value, ts, collector, error_path, deserializers);
 }
 
 /**
  * @brief Initializes the validation globals for the extension.
  *
- * This function initializes the extension globals and the AnyType.
+ * This function initializes the extension globals, the native validators of
+ * standard library types and the AnyType.
  *
  * @return 0 on success, -1 on failure.
  */
@@ -250,5 +307,8 @@ int init_validation_globals(void) {
   if (init_extension_globals() != 0) {
     return -1;
   }
+  if (init_builtin_validators() != 0) {
+    return -1;
+  }
   return init_any_type();
 }
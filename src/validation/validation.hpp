@@ -16,8 +16,8 @@
  * @param ts Pointer to the compiled type schema against which to validate.
  * @param collector Pointer to an ErrorCollector for recording any validation
  * errors.
- * @param error_path A string describing the current location in the data
- * structure for error reporting.
+ * @param error_path The current location in the data structure for error
+ * reporting, formatted only if an error is recorded.
  * @param deserializers Pointer to a Deserializers cache (from the model
  * configuration) used to convert between types.
  * @return A new reference to the validated/converted value on success, or
@@ -25,9 +25,56 @@
  */
 PyObject *validate_and_convert(PyObject *value, TypeSchema *ts,
                                ErrorCollector *collector,
-                               const char *error_path,
+                               const ErrorPath *error_path,
                                Deserializers *deserializers);
 
+/**
+ * @brief Check whether a value is valid as is, without any conversion.
+ *
+ * Only exact type tests and table lookups are used, so this is cheap enough
+ * to scan every element of a container before deciding to copy it.
+ *
+ * @param value The value to check.
+ * @param ts The compiled type schema.
+ * @return true if validate_and_convert would return value itself.
+ */
+static inline bool value_is_exact(PyObject *value, TypeSchema *ts) {
+  switch (ts->op) {
+  case OP_ANY:
+    return true;
+  case OP_INT:
+    return PyLong_CheckExact(value);
+  case OP_STR:
+    return PyUnicode_CheckExact(value);
+  case OP_FLOAT:
+    return PyFloat_CheckExact(value);
+  case OP_BOOL:
+    return PyBool_Check(value);
+  case OP_PLAIN:
+  case OP_MODEL:
+  case OP_DATETIME:
+  case OP_DATE:
+  case OP_TIME:
+  case OP_UUID:
+  case OP_DECIMAL:
+  case OP_ENUM:
+    return (PyObject *)Py_TYPE(value) == ts->expected_type;
+  case OP_OPTIONAL:
+    return value == Py_None || value_is_exact(value, ts->optional_target);
+  case OP_UNION:
+    if (value == Py_None && ts->is_optional) {
+      return true;
+    }
+    if (ts->type_table) {
+      PyObject *hit =
+          PyDict_GetItemWithError(ts->type_table, (PyObject *)Py_TYPE(value));
+      return hit != nullptr;
+    }
+    return false;
+  }
+  return false;
+}
+
 /**
  * @brief Initialize validation globals.
  *
@@ -0,0 +1,457 @@
+#include <Python.h>
+#include <cstdint>
+#include <datetime.h>
+
+#include "error_handling.hpp"
+#include "init_globals.hpp"
+#include "schema/schema.hpp"
+#include "validation_builtins.hpp"
+
+namespace {
+PyObject *int_name = nullptr;           // "int", the value slot of a UUID.
+PyObject *is_safe_name = nullptr;       // "is_safe", the other UUID slot.
+PyObject *safe_uuid_unknown = nullptr;  // uuid.SafeUUID.unknown.
+PyObject *fromisoformat_name = nullptr; // "fromisoformat".
+PyObject *fromtimestamp_name = nullptr; // "fromtimestamp".
+PyObject *sixty_four = nullptr;         // The int 64.
+
+/**
+ * @brief Fields of a parsed time of day.
+ */
+struct TimeFields {
+  int hour = 0;
+  int minute = 0;
+  int second = 0;
+  int microsecond = 0;
+  bool has_offset = false;
+  int offset_seconds = 0;
+};
+
+/**
+ * @brief Reads a fixed number of decimal digits.
+ * @param text The digits.
+ * @param count The number of digits to read.
+ * @param out Receives the value.
+ * @return true if all count characters are digits.
+ */
+bool read_digits(const char *text, int count, int *out) {
+  int result = 0;
+  for (int i = 0; i < count; i++) {
+    unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+    if (digit > 9) {
+      return false;
+    }
+    result = result * 10 + static_cast<int>(digit);
+  }
+  *out = result;
+  return true;
+}
+
+/**
+ * @brief Parses a YYYY-MM-DD date.
+ * @param text The text.
+ * @param len Length of the text; must be exactly 10.
+ * @return true on success.
+ */
+bool parse_date(const char *text, Py_ssize_t len, int *year, int *month,
+                int *day) {
+  return len == 10 && text[4] == '-' && text[7] == '-' &&
+         read_digits(text, 4, year) && read_digits(text + 5, 2, month) &&
+         read_digits(text + 8, 2, day);
+}
+
+/**
+ * @brief Parses HH:MM[:SS[.fff[fff]]] with an optional Z or +HH:MM suffix.
+ * @param text The text.
+ * @param len Length of the text.
+ * @param fields Receives the parsed fields.
+ * @return true if the whole text is in that form.
+ */
+bool parse_time(const char *text, Py_ssize_t len, TimeFields *fields) {
+  if (len < 5 || text[2] != ':' || !read_digits(text, 2, &fields->hour) ||
+      !read_digits(text + 3, 2, &fields->minute)) {
+    return false;
+  }
+  Py_ssize_t pos = 5;
+  if (pos < len && text[pos] == ':') {
+    if (len - pos < 3 || !read_digits(text + pos + 1, 2, &fields->second)) {
+      return false;
+    }
+    pos += 3;
+    if (pos < len && text[pos] == '.') {
+      int digits = 0;
+      while (pos + 1 + digits < len && digits < 7 &&
+             static_cast<unsigned>(
+                 static_cast<unsigned char>(text[pos + 1 + digits]) - '0') <=
+                 9u) {
+        digits++;
+      }
+      if (digits != 3 && digits != 6) {
+        return false;
+      }
+      read_digits(text + pos + 1, digits, &fields->microsecond);
+      if (digits == 3) {
+        fields->microsecond *= 1000;
+      }
+      pos += 1 + digits;
+    }
+  }
+  if (pos == len) {
+    return true;
+  }
+  if (text[pos] == 'Z' && pos + 1 == len) {
+    fields->has_offset = true;
+    return true;
+  }
+  int hours, minutes;
+  if ((text[pos] == '+' || text[pos] == '-') && len - pos == 6 &&
+      text[pos + 3] == ':' && read_digits(text + pos + 1, 2, &hours) &&
+      read_digits(text + pos + 4, 2, &minutes)) {
+    fields->has_offset = true;
+    fields->offset_seconds =
+        (hours * 3600 + minutes * 60) * (text[pos] == '-' ? -1 : 1);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Builds the tzinfo of a parsed time.
+ * @param fields The parsed time.
+ * @return New reference to None, timezone.utc or a fixed-offset timezone, or
+ * nullptr on error.
+ */
+PyObject *make_tzinfo(const TimeFields &fields) {
+  if (!fields.has_offset) {
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  if (fields.offset_seconds == 0) {
+    Py_INCREF(PyDateTime_TimeZone_UTC);
+    return PyDateTime_TimeZone_UTC;
+  }
+  PyObject *delta = PyDelta_FromDSU(0, fields.offset_seconds, 0);
+  if (!delta) {
+    return nullptr;
+  }
+  PyObject *tzinfo = PyTimeZone_FromOffset(delta);
+  Py_DECREF(delta);
+  return tzinfo;
+}
+
+/**
+ * @brief Builds a datetime, date or time from text.
+ * @param op OP_DATETIME, OP_DATE or OP_TIME.
+ * @param text The text.
+ * @param len Length of the text.
+ * @return New reference, or nullptr (with or without an exception).
+ */
+PyObject *parse_temporal(int op, const char *text, Py_ssize_t len) {
+  int year = 0, month = 0, day = 0;
+  TimeFields fields;
+  if (op == OP_DATE) {
+    if (!parse_date(text, len, &year, &month, &day)) {
+      return nullptr;
+    }
+    return PyDate_FromDate(year, month, day);
+  }
+  if (op == OP_DATETIME) {
+    if (len < 10 || !parse_date(text, 10, &year, &month, &day)) {
+      return nullptr;
+    }
+    if (len > 10 && ((text[10] != 'T' && text[10] != ' ') ||
+                     !parse_time(text + 11, len - 11, &fields))) {
+      return nullptr;
+    }
+  } else if (!parse_time(text, len, &fields)) {
+    return nullptr;
+  }
+  PyObject *tzinfo = make_tzinfo(fields);
+  if (!tzinfo) {
+    return nullptr;
+  }
+  PyObject *result =
+      op == OP_DATETIME
+          ? PyDateTimeAPI->DateTime_FromDateAndTime(
+                year, month, day, fields.hour, fields.minute, fields.second,
+                fields.microsecond, tzinfo, PyDateTimeAPI->DateTimeType)
+          : PyDateTimeAPI->Time_FromTime(fields.hour, fields.minute,
+                                         fields.second, fields.microsecond,
+                                         tzinfo, PyDateTimeAPI->TimeType);
+  Py_DECREF(tzinfo);
+  return result;
+}
+
+/**
+ * @brief Builds a UUID from 32 hex digits, optionally in 8-4-4-4-12 groups.
+ *
+ * The instance is initialized the way UUID.__init__ does, without running
+ * it.
+ *
+ * @param text The text.
+ * @param len Length of the text.
+ * @return New reference, or nullptr (with or without an exception).
+ */
+PyObject *parse_uuid(const char *text, Py_ssize_t len) {
+  char hex[33];
+  int count = 0;
+  if (len == 36) {
+    if (text[8] != '-' || text[13] != '-' || text[18] != '-' ||
+        text[23] != '-') {
+      return nullptr;
+    }
+  } else if (len != 32) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < len; i++) {
+    char c = text[i];
+    if (c == '-' && len == 36) {
+      continue;
+    }
+    if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+          (c >= 'A' && c <= 'F'))) {
+      return nullptr;
+    }
+    hex[count++] = c;
+  }
+  if (count != 32) {
+    return nullptr;
+  }
+  hex[32] = '\0';
+  PyObject *number = PyLong_FromString(hex, nullptr, 16);
+  if (!number) {
+    return nullptr;
+  }
+  PyObject *uuid = PyBaseObject_Type.tp_new((PyTypeObject *)UUIDType,
+                                            empty_tuple, nullptr);
+  if (!uuid || PyObject_GenericSetAttr(uuid, int_name, number) < 0 ||
+      PyObject_GenericSetAttr(uuid, is_safe_name, safe_uuid_unknown) < 0) {
+    Py_XDECREF(uuid);
+    Py_DECREF(number);
+    return nullptr;
+  }
+  Py_DECREF(number);
+  return uuid;
+}
+
+/**
+ * @brief Writes a zero-padded decimal number.
+ * @param out The output position.
+ * @param value The number.
+ * @param width The number of digits.
+ * @return The position after the digits.
+ */
+char *write_decimal(char *out, int value, int width) {
+  for (int i = width - 1; i >= 0; i--) {
+    out[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  return out + width;
+}
+
+/**
+ * @brief Writes a zero-padded lowercase hexadecimal number.
+ * @param out The output position.
+ * @param value The number.
+ * @param width The number of digits.
+ * @return The position after the digits.
+ */
+char *write_hex(char *out, uint64_t value, int width) {
+  for (int i = width - 1; i >= 0; i--) {
+    out[i] = "0123456789abcdef"[value & 0xf];
+    value >>= 4;
+  }
+  return out + width;
+}
+
+/**
+ * @brief Writes HH:MM:SS, followed by .ffffff when there are microseconds.
+ * @return The position after the text.
+ */
+char *write_time(char *out, int hour, int minute, int second,
+                 int microsecond) {
+  out = write_decimal(out, hour, 2);
+  *out++ = ':';
+  out = write_decimal(out, minute, 2);
+  *out++ = ':';
+  out = write_decimal(out, second, 2);
+  if (microsecond) {
+    *out++ = '.';
+    out = write_decimal(out, microsecond, 6);
+  }
+  return out;
+}
+
+/**
+ * @brief Writes YYYY-MM-DD.
+ * @return The position after the text.
+ */
+char *write_date(char *out, PyObject *date) {
+  out = write_decimal(out, PyDateTime_GET_YEAR(date), 4);
+  *out++ = '-';
+  out = write_decimal(out, PyDateTime_GET_MONTH(date), 2);
+  *out++ = '-';
+  return write_decimal(out, PyDateTime_GET_DAY(date), 2);
+}
+
+/**
+ * @brief Writes the 8-4-4-4-12 form of a UUID.
+ * @return The length of the text, or -1 on error.
+ */
+Py_ssize_t write_uuid(PyObject *uuid, char *buffer) {
+  PyObject *number = PyObject_GenericGetAttr(uuid, int_name);
+  if (!number) {
+    return -1;
+  }
+  PyObject *high_part = PyNumber_Rshift(number, sixty_four);
+  uint64_t low = PyLong_AsUnsignedLongLongMask(number);
+  Py_DECREF(number);
+  if (!high_part) {
+    return -1;
+  }
+  uint64_t high = PyLong_AsUnsignedLongLongMask(high_part);
+  Py_DECREF(high_part);
+  if (PyErr_Occurred()) {
+    return -1;
+  }
+  char *out = write_hex(buffer, high >> 32, 8);
+  *out++ = '-';
+  out = write_hex(out, high >> 16, 4);
+  *out++ = '-';
+  out = write_hex(out, high, 4);
+  *out++ = '-';
+  out = write_hex(out, low >> 48, 4);
+  *out++ = '-';
+  out = write_hex(out, low, 12);
+  return out - buffer;
+}
+} // namespace
+
+int init_builtin_validators(void) {
+  if (int_name) {
+    return 0;
+  }
+  PyDateTime_IMPORT;
+  if (!PyDateTimeAPI) {
+    return -1;
+  }
+  PyObject *uuid_module = PyImport_ImportModule("uuid");
+  if (!uuid_module) {
+    return -1;
+  }
+  PyObject *safe_uuid = PyObject_GetAttrString(uuid_module, "SafeUUID");
+  Py_DECREF(uuid_module);
+  if (!safe_uuid) {
+    return -1;
+  }
+  safe_uuid_unknown = PyObject_GetAttrString(safe_uuid, "unknown");
+  Py_DECREF(safe_uuid);
+  is_safe_name = PyUnicode_InternFromString("is_safe");
+  fromisoformat_name = PyUnicode_InternFromString("fromisoformat");
+  fromtimestamp_name = PyUnicode_InternFromString("fromtimestamp");
+  sixty_four = PyLong_FromLong(64);
+  int_name = PyUnicode_InternFromString("int");
+  if (!safe_uuid_unknown || !is_safe_name || !fromisoformat_name ||
+      !fromtimestamp_name || !sixty_four || !int_name) {
+    Py_CLEAR(int_name);
+    return -1;
+  }
+  return 0;
+}
+
+PyObject *parse_builtin_text(int op, const char *text, Py_ssize_t len) {
+  PyObject *result = op == OP_UUID ? parse_uuid(text, len)
+                                   : parse_temporal(op, text, len);
+  if (!result && PyErr_ExceptionMatches(PyExc_ValueError)) {
+    // Out-of-range fields; fromisoformat produces the authoritative error.
+    PyErr_Clear();
+  }
+  return result;
+}
+
+PyObject *validate_builtin(PyObject *value, TypeSchema *ts,
+                           ErrorCollector *collector,
+                           const ErrorPath *error_path) {
+  PyObject *expected = ts->expected_type;
+  if (PyObject_TypeCheck(value, (PyTypeObject *)expected)) {
+    Py_INCREF(value);
+    return value;
+  }
+  PyObject *result = nullptr;
+  bool converted = false;
+  switch (ts->op) {
+  case OP_DATETIME:
+  case OP_DATE:
+  case OP_TIME:
+  case OP_UUID:
+    if (PyUnicode_Check(value)) {
+      Py_ssize_t len;
+      const char *text = PyUnicode_AsUTF8AndSize(value, &len);
+      result = text ? parse_builtin_text(ts->op, text, len) : nullptr;
+      if (!result && !PyErr_Occurred()) {
+        result = ts->op == OP_UUID
+                     ? PyObject_CallOneArg(expected, value)
+                     : PyObject_CallMethodOneArg(expected, fromisoformat_name,
+                                                 value);
+      }
+      converted = true;
+    } else if (ts->op == OP_DATETIME && PyLong_CheckExact(value)) {
+      result = PyObject_CallMethodOneArg(expected, fromtimestamp_name, value);
+      converted = true;
+    }
+    break;
+  case OP_ENUM:
+    result = PyDict_GetItemWithError(ts->enum_members, value);
+    if (result) {
+      Py_INCREF(result);
+      return result;
+    }
+    PyErr_Clear(); // Unhashable values are left to the constructor.
+    break;
+  }
+  if (!converted) {
+    result = PyObject_CallOneArg(expected, value);
+  }
+  if (result && PyObject_IsInstance(result, expected) > 0) {
+    return result;
+  }
+  Py_XDECREF(result);
+  PyErr_Clear();
+  if (collector) {
+    collector->add_type_error(error_path, expected, value);
+  }
+  return nullptr;
+}
+
+Py_ssize_t format_builtin_value(PyObject *value, char *buffer) {
+  PyTypeObject *type = Py_TYPE(value);
+  if (type == PyDateTimeAPI->DateTimeType) {
+    if (PyDateTime_DATE_GET_TZINFO(value) != Py_None) {
+      return 0;
+    }
+    char *out = write_date(buffer, value);
+    *out++ = ' ';
+    out = write_time(out, PyDateTime_DATE_GET_HOUR(value),
+                     PyDateTime_DATE_GET_MINUTE(value),
+                     PyDateTime_DATE_GET_SECOND(value),
+                     PyDateTime_DATE_GET_MICROSECOND(value));
+    return out - buffer;
+  }
+  if (type == PyDateTimeAPI->DateType) {
+    return write_date(buffer, value) - buffer;
+  }
+  if (type == PyDateTimeAPI->TimeType) {
+    if (PyDateTime_TIME_GET_TZINFO(value) != Py_None) {
+      return 0;
+    }
+    return write_time(buffer, PyDateTime_TIME_GET_HOUR(value),
+                      PyDateTime_TIME_GET_MINUTE(value),
+                      PyDateTime_TIME_GET_SECOND(value),
+                      PyDateTime_TIME_GET_MICROSECOND(value)) -
+           buffer;
+  }
+  if ((PyObject *)type == UUIDType) {
+    return write_uuid(value, buffer);
+  }
+  return 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Python.h>
+
+#include "error_handling.hpp"
+#include "schema/schema.hpp"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initialize the native validators of standard library types.
+ *
+ * Imports the datetime C API and the constants used to build UUIDs. Must
+ * run after init_extension_globals.
+ *
+ * @return 0 on success; -1 on error.
+ */
+int init_builtin_validators(void);
+
+/**
+ * @brief Parse text in the canonical form of a standard library type.
+ *
+ * Handles ISO 8601 dates (YYYY-MM-DD), times (HH:MM[:SS[.fff[fff]]] with an
+ * optional Z or +HH:MM offset) and datetimes joined by 'T' or a space, and
+ * UUIDs written as 32 hex digits with or without the four hyphens. Text in
+ * any other form is left to the Python constructors.
+ *
+ * @param op OP_DATETIME, OP_DATE, OP_TIME or OP_UUID.
+ * @param text The text (not necessarily NUL-terminated).
+ * @param len Length of the text in bytes.
+ * @return New reference to the parsed value, or nullptr with no exception
+ * set if the text is not in a handled form (or is out of range), or nullptr
+ * with an exception set on an allocation failure.
+ */
+PyObject *parse_builtin_text(int op, const char *text, Py_ssize_t len);
+
+/**
+ * @brief Validate a value for one of the standard library type opcodes.
+ *
+ * Strings convert to datetimes, dates, times and UUIDs through
+ * parse_builtin_text and then fromisoformat or the constructor; ints convert
+ * to datetimes as POSIX timestamps; Enum members are found by value. Other
+ * values are passed to the constructor of the type. Only called when no
+ * deserializer is registered for the type of the value.
+ *
+ * @param value The Python object to validate.
+ * @param ts The TypeSchema, whose op is OP_DATETIME to OP_ENUM.
+ * @param collector Optional error collector for reporting errors.
+ * @param error_path Path to include in any error messages.
+ * @return New reference to the converted value on success; nullptr on
+ * failure.
+ */
+PyObject *validate_builtin(PyObject *value, TypeSchema *ts,
+                           ErrorCollector *collector,
+                           const ErrorPath *error_path);
+
+/**
+ * @brief Format a standard library value as its str() text.
+ *
+ * Handles exact naive datetimes and times, dates and UUIDs, which covers
+ * the values produced by validation without calling their __str__.
+ *
+ * @param value The value to format.
+ * @param buffer Output buffer of at least 40 bytes.
+ * @return The length of the text, 0 if the value is not handled, or -1 on
+ * error.
+ */
+Py_ssize_t format_builtin_value(PyObject *value, char *buffer);
+
+#ifdef __cplusplus
+}
+#endif
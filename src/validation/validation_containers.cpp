@@ -3,98 +3,95 @@
 #include "init_globals.hpp"
 #include "schema/deserializer.hpp"
 #include "schema/schema.hpp"
+#include "stats.hpp"
 #include "validation.hpp"
 #include "validation_primitives.hpp"
 #include <Python.h>
-#include <array>
-#include <stdio.h>
 #include <string>
 
-/**
- * @brief Returns a safe type name for a Python object.
- *
- * If the object is a type, returns its __name__ or __qualname__ attribute.
- * Otherwise, returns the type's name or "<unknown>" if unavailable.
- *
- * @param obj The Python object.
- * @return A C-string representing the safe type name.
- */
-static const char *safe_type_name(PyObject *obj) {
-  if (!obj) {
-    return "<unknown>";
-  }
-  if (PyType_Check(obj)) {
-    PyObject *name_obj = PyObject_GetAttrString(obj, "__name__");
-    if (!name_obj) {
-      PyErr_Clear();
-      name_obj = PyObject_GetAttrString(obj, "__qualname__");
-    }
-    if (name_obj) {
-      const char *name = PyUnicode_AsUTF8(name_obj);
-      Py_DECREF(name_obj);
-      if (name) {
-        return name;
-      }
-    }
-    return ((PyTypeObject *)obj)->tp_name;
-  }
-  PyTypeObject *type = Py_TYPE(obj);
-  if (!type || !type->tp_name) {
-    return "<unknown>";
-  }
-  return type->tp_name;
-}
-
 /**
  * @brief Validates and converts a Python list.
  *
  * Checks if the given value is a list and converts each element using
- * validate_and_convert.
+ * validate_and_convert. A list whose elements are all valid as is is
+ * returned itself; otherwise a copy is made from the first element that
+ * changes, reusing the elements before it.
  *
  * @param value The Python object to validate.
  * @param ts The type schema for the list elements.
  * @param collector The error collector.
  * @param error_path The base error path.
  * @param deserializers The deserializers container.
- * @return A new list with validated and converted items, or nullptr on error.
+ * @return The validated list (possibly value itself), or nullptr on error.
  */
 PyObject *validate_list(PyObject *value, TypeSchema *ts,
-                        ErrorCollector *collector, const char *error_path,
+                        ErrorCollector *collector, const ErrorPath *error_path,
                         Deserializers *deserializers) {
   if (!PyList_Check(value)) {
     if (collector) {
-      collector->add_error(error_path, std::string("Expected a list, got ") +
-                                           safe_type_name(value));
+      collector->add_code(error_path, ERR_LIST_TYPE, value);
     }
     return nullptr;
   }
-  Py_ssize_t size = PyList_Size(value);
-  PyObject *new_list = PyList_New(size);
-  if (!new_list) {
-    return nullptr;
-  }
-
-  size_t base_len = strlen(error_path);
-  std::array<char, 256> new_path;
-  if (base_len >= new_path.size() - 2) {
-    base_len = new_path.size() - 2;
+  TypeSchema *item_schema = ts->args[0];
+  Py_ssize_t size = PyList_GET_SIZE(value);
+  Py_ssize_t start = 0;
+  if (PyList_CheckExact(value)) {
+    while (start < size &&
+           value_is_exact(PyList_GET_ITEM(value, start), item_schema)) {
+      start++;
+    }
+    if (start == size) {
+      Py_INCREF(value);
+      return value;
+    }
   }
-  memcpy(new_path.data(), error_path, base_len);
-  new_path[base_len] = '.';
-  new_path[base_len + 1] = '\0';
 
-  for (Py_ssize_t i = 0; i < size; i++) {
-    PyObject *item = PyList_GetItem(value, i);
-    snprintf(new_path.data() + base_len + 1, new_path.size() - base_len - 1,
-             "%zd", i);
-    PyObject *conv_item = validate_and_convert(item, ts->args[0], collector,
-                                               new_path.data(), deserializers);
+  PyObject *new_list = nullptr;
+  for (Py_ssize_t i = start; i < size; i++) {
+    PyObject *item = PyList_GET_ITEM(value, i);
+    Py_INCREF(item);
+    ErrorPath item_path(error_path, i);
+    PyObject *conv_item = validate_and_convert(item, item_schema, collector,
+                                               &item_path, deserializers);
+    Py_DECREF(item);
     if (!conv_item) {
-      Py_DECREF(new_list);
+      Py_XDECREF(new_list);
+      return nullptr;
+    }
+    // Validators run arbitrary code that may resize the list.
+    if (PyList_GET_SIZE(value) != size) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "list changed size during validation");
+      Py_DECREF(conv_item);
+      Py_XDECREF(new_list);
       return nullptr;
     }
+    if (!new_list) {
+      if (conv_item == item && PyList_CheckExact(value)) {
+        Py_DECREF(conv_item);
+        continue;
+      }
+      new_list = PyList_New(size);
+      if (!new_list) {
+        Py_DECREF(conv_item);
+        return nullptr;
+      }
+      for (Py_ssize_t j = 0; j < i; j++) {
+        PyObject *kept = PyList_GET_ITEM(value, j);
+        Py_INCREF(kept);
+        PyList_SET_ITEM(new_list, j, kept);
+      }
+    }
     PyList_SET_ITEM(new_list, i, conv_item);
   }
+  if (!new_list) {
+    if (!PyList_CheckExact(value)) {
+      return PyList_New(0); // An empty list subclass.
+    }
+    Py_INCREF(value);
+    return value;
+  }
   return new_list;
 }
 
@@ -102,58 +99,58 @@ PyObject *validate_list(PyObject *value, TypeSchema *ts,
  * @brief Validates and converts a Python dictionary.
  *
  * Checks if the given value is a dict and converts each key-value pair using
- * validate_and_convert.
+ * validate_and_convert. A dict whose keys and values are all valid as is is
+ * returned itself.
  *
  * @param value The Python object to validate.
  * @param ts The type schema for the dictionary keys and values.
  * @param collector The error collector.
  * @param error_path The base error path.
  * @param deserializers The deserializers container.
- * @return A new dictionary with validated and converted key-value pairs, or
- * nullptr on error.
+ * @return The validated dictionary (possibly value itself), or nullptr on
+ * error.
  */
 PyObject *validate_dict(PyObject *value, TypeSchema *ts,
-                        ErrorCollector *collector, const char *error_path,
+                        ErrorCollector *collector, const ErrorPath *error_path,
                         Deserializers *deserializers) {
   if (!PyDict_Check(value)) {
     if (collector) {
-      collector->add_error(error_path, std::string("Expected a dict, got ") +
-                                           safe_type_name(value));
+      collector->add_code(error_path, ERR_DICT_TYPE, value);
     }
     return nullptr;
   }
-  PyObject *new_dict = PyDict_New();
-  if (!new_dict) {
-    return nullptr;
-  }
-
   TypeSchema *key_schema = ts->args[0];
   TypeSchema *val_schema = ts->args[1];
+  PyObject *key, *val;
+  Py_ssize_t pos = 0;
+  if (PyDict_CheckExact(value)) {
+    bool valid = true;
+    while (valid && PyDict_Next(value, &pos, &key, &val)) {
+      valid =
+          value_is_exact(key, key_schema) && value_is_exact(val, val_schema);
+    }
+    if (valid) {
+      Py_INCREF(value);
+      return value;
+    }
+    pos = 0;
+  }
 
-  size_t base_len = strlen(error_path);
-  std::array<char, 256> new_path;
-  if (base_len >= new_path.size() - 2) {
-    base_len = new_path.size() - 2;
+  PyObject *new_dict = PyDict_New();
+  if (!new_dict) {
+    return nullptr;
   }
-  memcpy(new_path.data(), error_path, base_len);
-  new_path[base_len] = '.';
-  new_path[base_len + 1] = '\0';
 
-  PyObject *key, *val;
-  Py_ssize_t pos = 0;
   while (PyDict_Next(value, &pos, &key, &val)) {
-    const char *key_str =
-        PyUnicode_Check(key) ? PyUnicode_AsUTF8(key) : safe_type_name(key);
-    snprintf(new_path.data() + base_len + 1, new_path.size() - base_len - 1,
-             "%s", key_str);
+    ErrorPath key_path(error_path, key);
     PyObject *conv_key = validate_and_convert(key, key_schema, collector,
-                                              new_path.data(), deserializers);
+                                              &key_path, deserializers);
     if (!conv_key) {
       Py_DECREF(new_dict);
       return nullptr;
     }
     PyObject *conv_val = validate_and_convert(val, val_schema, collector,
-                                              new_path.data(), deserializers);
+                                              &key_path, deserializers);
     if (!conv_val) {
       Py_DECREF(conv_key);
       Py_DECREF(new_dict);
@@ -175,51 +172,80 @@ PyObject *validate_dict(PyObject *value, TypeSchema *ts,
  * @brief Validates and converts a Python tuple.
  *
  * Checks if the given value is a tuple with the expected length and converts
- * each element using validate_and_convert.
+ * each element using validate_and_convert. Like lists, a tuple that is valid
+ * as is is returned itself and is otherwise copied from the first element
+ * that changes.
  *
  * @param value The Python object to validate.
  * @param ts The type schema for the tuple elements.
  * @param collector The error collector.
  * @param error_path The base error path.
  * @param deserializers The deserializers container.
- * @return A new tuple with validated and converted items, or nullptr on error.
+ * @return The validated tuple (possibly value itself), or nullptr on error.
  */
 PyObject *validate_tuple(PyObject *value, TypeSchema *ts,
-                         ErrorCollector *collector, const char *error_path,
+                         ErrorCollector *collector, const ErrorPath *error_path,
                          Deserializers *deserializers) {
   if (!PyTuple_Check(value)) {
     if (collector) {
-      collector->add_error(error_path, std::string("Expected a tuple, got ") +
-                                           safe_type_name(value));
+      collector->add_code(error_path, ERR_TUPLE_TYPE, value);
     }
     return nullptr;
   }
   Py_ssize_t size = PyTuple_Size(value);
   if (ts->num_args != size) {
     if (collector) {
-      std::array<char, 128> buf;
-      snprintf(buf.data(), buf.size(), "Expected tuple of length %zd, got %zd",
-               ts->num_args, size);
-      collector->add_error(error_path, buf.data());
+      collector->add_length_error(error_path, ts->num_args, size);
     }
     return nullptr;
   }
-  PyObject *new_tuple = PyTuple_New(size);
-  if (!new_tuple) {
-    return nullptr;
+  bool exact = PyTuple_CheckExact(value);
+  Py_ssize_t start = 0;
+  if (exact) {
+    while (start < size &&
+           value_is_exact(PyTuple_GET_ITEM(value, start), ts->args[start])) {
+      start++;
+    }
+    if (start == size) {
+      Py_INCREF(value);
+      return value;
+    }
   }
-  for (Py_ssize_t i = 0; i < size; i++) {
-    PyObject *item = PyTuple_GetItem(value, i);
-    std::array<char, 256> new_path;
-    snprintf(new_path.data(), new_path.size(), "%s.%zd", error_path, i);
+  PyObject *new_tuple = nullptr;
+  for (Py_ssize_t i = start; i < size; i++) {
+    PyObject *item = PyTuple_GET_ITEM(value, i);
+    ErrorPath item_path(error_path, i);
     PyObject *conv_item = validate_and_convert(item, ts->args[i], collector,
-                                               new_path.data(), deserializers);
+                                               &item_path, deserializers);
     if (!conv_item) {
-      Py_DECREF(new_tuple);
+      Py_XDECREF(new_tuple);
       return nullptr;
     }
+    if (!new_tuple) {
+      if (conv_item == item && exact) {
+        Py_DECREF(conv_item);
+        continue;
+      }
+      new_tuple = PyTuple_New(size);
+      if (!new_tuple) {
+        Py_DECREF(conv_item);
+        return nullptr;
+      }
+      for (Py_ssize_t j = 0; j < i; j++) {
+        PyObject *kept = PyTuple_GET_ITEM(value, j);
+        Py_INCREF(kept);
+        PyTuple_SET_ITEM(new_tuple, j, kept);
+      }
+    }
     PyTuple_SET_ITEM(new_tuple, i, conv_item);
   }
+  if (!new_tuple) {
+    if (!exact) {
+      return PyTuple_New(0); // An empty tuple subclass.
+    }
+    Py_INCREF(value);
+    return value;
+  }
   return new_tuple;
 }
 
@@ -227,25 +253,45 @@ PyObject *validate_tuple(PyObject *value, TypeSchema *ts,
  * @brief Validates and converts a Python set.
  *
  * Checks if the given value is a set and converts each element using
- * validate_and_convert.
+ * validate_and_convert. A set whose elements are all valid as is is returned
+ * itself.
  *
  * @param value The Python object to validate.
  * @param ts The type schema for the set elements.
  * @param collector The error collector.
  * @param error_path The base error path.
  * @param deserializers The deserializers container.
- * @return A new set with validated and converted items, or nullptr on error.
+ * @return The validated set (possibly value itself), or nullptr on error.
  */
 PyObject *validate_set(PyObject *value, TypeSchema *ts,
-                       ErrorCollector *collector, const char *error_path,
+                       ErrorCollector *collector, const ErrorPath *error_path,
                        Deserializers *deserializers) {
   if (!PySet_Check(value)) {
     if (collector) {
-      collector->add_error(error_path, std::string("Expected a set, got ") +
-                                           safe_type_name(value));
+      collector->add_code(error_path, ERR_SET_TYPE, value);
     }
     return nullptr;
   }
+  PyObject *item;
+  if (PySet_CheckExact(value)) {
+    PyObject *iterator = PyObject_GetIter(value);
+    if (!iterator) {
+      return nullptr;
+    }
+    bool valid = true;
+    while (valid && (item = PyIter_Next(iterator)) != nullptr) {
+      valid = value_is_exact(item, ts->args[0]);
+      Py_DECREF(item);
+    }
+    Py_DECREF(iterator);
+    if (PyErr_Occurred()) {
+      return nullptr;
+    }
+    if (valid) {
+      Py_INCREF(value);
+      return value;
+    }
+  }
   PyObject *new_set = PySet_New(nullptr);
   if (!new_set) {
     return nullptr;
@@ -255,13 +301,11 @@ PyObject *validate_set(PyObject *value, TypeSchema *ts,
     Py_DECREF(new_set);
     return nullptr;
   }
-  PyObject *item;
   Py_ssize_t idx = 0;
   while ((item = PyIter_Next(iterator)) != nullptr) {
-    std::array<char, 256> new_path;
-    snprintf(new_path.data(), new_path.size(), "%s.%zd", error_path, idx++);
+    ErrorPath item_path(error_path, idx++);
     PyObject *conv_item = validate_and_convert(item, ts->args[0], collector,
-                                               new_path.data(), deserializers);
+                                               &item_path, deserializers);
     Py_DECREF(item);
     if (!conv_item) {
       Py_DECREF(iterator);
@@ -280,12 +324,71 @@ PyObject *validate_set(PyObject *value, TypeSchema *ts,
   return new_set;
 }
 
+/**
+ * @brief Validates and converts a Python object for Optional[X].
+ *
+ * Equivalent to validate_union for a two-member union of a non-generic X and
+ * None, without scanning the members.
+ *
+ * @param value The Python object to validate.
+ * @param ts The type schema for the optional.
+ * @param collector The error collector.
+ * @param error_path The base error path.
+ * @param deserializers The deserializers container.
+ * @return The validated and converted Python object, or nullptr on error.
+ */
+PyObject *validate_optional(PyObject *value, TypeSchema *ts,
+                            ErrorCollector *collector,
+                            const ErrorPath *error_path,
+                            Deserializers *deserializers) {
+  if (value == Py_None) {
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  PyObject *conv = validate_and_convert(value, ts->optional_target, nullptr,
+                                        error_path, deserializers);
+  if (conv) {
+    return conv;
+  }
+  PyErr_Clear();
+  if (collector) {
+    collector->add_code(error_path, ERR_UNION, value);
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Selects the member of a discriminated union for a tag value.
+ *
+ * @param ts The union type schema.
+ * @param tag The discriminator value, or nullptr if absent.
+ * @param collector The error collector.
+ * @param error_path The base error path.
+ * @return The member schema, or nullptr after recording an error.
+ */
+TypeSchema *select_tagged_candidate(TypeSchema *ts, PyObject *tag,
+                                    ErrorCollector *collector,
+                                    const ErrorPath *error_path) {
+  PyObject *index = tag ? PyDict_GetItemWithError(ts->tag_table, tag) : nullptr;
+  if (index) {
+    return ts->args[PyLong_AsSsize_t(index)];
+  }
+  // Unhashable tags are simply unknown.
+  PyErr_Clear();
+  if (collector) {
+    collector->add_tag_error(error_path, ts->discriminator, tag);
+  }
+  return nullptr;
+}
+
 /**
  * @brief Validates and converts a Python object for a Union type.
  *
- * First checks if the value is already an instance of any candidate type.
- * If not, attempts conversion for each candidate. Returns the converted value
- * if successful, or logs an error if all candidates fail.
+ * An exact type match against a union of plain types is a table lookup;
+ * otherwise the value is checked against each candidate with isinstance.
+ * Discriminated unions then pick the single candidate named by the tag
+ * value. Other unions attempt conversion for each candidate, returning the
+ * first success or logging an error if all candidates fail.
  *
  * @param value The Python object to validate.
  * @param ts The type schema for the union.
@@ -295,21 +398,47 @@ PyObject *validate_set(PyObject *value, TypeSchema *ts,
  * @return The validated and converted Python object, or nullptr on error.
  */
 PyObject *validate_union(PyObject *value, TypeSchema *ts,
-                         ErrorCollector *collector, const char *error_path,
+                         ErrorCollector *collector, const ErrorPath *error_path,
                          Deserializers *deserializers) {
+  if (ts->type_table &&
+      PyDict_GetItemWithError(ts->type_table, (PyObject *)Py_TYPE(value))) {
+    Py_INCREF(value);
+    return value;
+  }
   for (Py_ssize_t i = 0; i < ts->num_args; i++) {
     TypeSchema *candidate = ts->args[i];
-    PyObject *check_type = (candidate->origin != Py_None)
-                               ? candidate->origin
-                               : candidate->expected_type;
-    if (PyObject_IsInstance(value, check_type)) {
+    // Model metaclasses do not customize isinstance, so skip the generic
+    // __instancecheck__ dispatch for them.
+    int matches =
+        candidate->is_data_model
+            ? PyObject_TypeCheck(
+                  value,
+                  reinterpret_cast<PyTypeObject *>(candidate->expected_type))
+            : PyObject_IsInstance(value, (candidate->origin != Py_None)
+                                             ? candidate->origin
+                                             : candidate->expected_type);
+    if (matches) {
       Py_INCREF(value);
       return value;
     }
   }
-  ErrorCollector temp_collector;
+  if (ts->tag_table && PyDict_Check(value)) {
+    PyObject *tag = nullptr;
+    for (Py_ssize_t i = 0; !tag && i < PyList_GET_SIZE(ts->tag_keys); i++) {
+      tag = PyDict_GetItemWithError(value, PyList_GET_ITEM(ts->tag_keys, i));
+    }
+    TypeSchema *candidate =
+        select_tagged_candidate(ts, tag, collector, error_path);
+    if (candidate) {
+      stats_count_union_attempt();
+    }
+    return candidate ? validate_and_convert(value, candidate, collector,
+                                            error_path, deserializers)
+                     : nullptr;
+  }
   for (Py_ssize_t i = 0; i < ts->num_args; i++) {
-    PyObject *conv = validate_and_convert(value, ts->args[i], &temp_collector,
+    stats_count_union_attempt();
+    PyObject *conv = validate_and_convert(value, ts->args[i], nullptr,
                                           error_path, deserializers);
     if (conv) {
       return conv;
@@ -317,10 +446,7 @@ PyObject *validate_union(PyObject *value, TypeSchema *ts,
     PyErr_Clear();
   }
   if (collector) {
-    collector->add_error(
-        error_path,
-        std::string("Value did not match any candidate in Union: got ") +
-            safe_type_name(value));
+    collector->add_code(error_path, ERR_UNION, value);
   }
   return nullptr;
 }
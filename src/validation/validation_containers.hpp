@@ -16,6 +16,11 @@ struct TypeSchema;
  */
 class ErrorCollector;
 
+/**
+ * @brief Forward declaration of ErrorPath.
+ */
+struct ErrorPath;
+
 /**
  * @brief Forward declaration of Deserializers.
  */
@@ -27,12 +32,12 @@ struct Deserializers;
  * @param value The Python list to validate.
  * @param ts The type schema for validation.
  * @param collector ErrorCollector for recording errors.
- * @param error_path Path string for error messages.
+ * @param error_path Location of the value for error messages.
  * @param deserializers Deserializers for conversion.
  * @return A new PyObject after validation, or nullptr on error.
  */
 PyObject *validate_list(PyObject *value, TypeSchema *ts,
-                        ErrorCollector *collector, const char *error_path,
+                        ErrorCollector *collector, const ErrorPath *error_path,
                         Deserializers *deserializers);
 
 /**
@@ -41,12 +46,12 @@ PyObject *validate_list(PyObject *value, TypeSchema *ts,
  * @param value The Python dictionary to validate.
  * @param ts The type schema for validation.
  * @param collector ErrorCollector for recording errors.
- * @param error_path Path string for error messages.
+ * @param error_path Location of the value for error messages.
  * @param deserializers Deserializers for conversion.
  * @return A new PyObject after validation, or nullptr on error.
  */
 PyObject *validate_dict(PyObject *value, TypeSchema *ts,
-                        ErrorCollector *collector, const char *error_path,
+                        ErrorCollector *collector, const ErrorPath *error_path,
                         Deserializers *deserializers);
 
 /**
@@ -55,12 +60,12 @@ PyObject *validate_dict(PyObject *value, TypeSchema *ts,
  * @param value The Python tuple to validate.
  * @param ts The type schema for validation.
  * @param collector ErrorCollector for recording errors.
- * @param error_path Path string for error messages.
+ * @param error_path Location of the value for error messages.
  * @param deserializers Deserializers for conversion.
  * @return A new PyObject after validation, or nullptr on error.
  */
 PyObject *validate_tuple(PyObject *value, TypeSchema *ts,
-                         ErrorCollector *collector, const char *error_path,
+                         ErrorCollector *collector, const ErrorPath *error_path,
                          Deserializers *deserializers);
 
 /**
@@ -69,12 +74,12 @@ PyObject *validate_tuple(PyObject *value, TypeSchema *ts,
  * @param value The Python set to validate.
  * @param ts The type schema for validation.
  * @param collector ErrorCollector for recording errors.
- * @param error_path Path string for error messages.
+ * @param error_path Location of the value for error messages.
  * @param deserializers Deserializers for conversion.
  * @return A new PyObject after validation, or nullptr on error.
  */
 PyObject *validate_set(PyObject *value, TypeSchema *ts,
-                       ErrorCollector *collector, const char *error_path,
+                       ErrorCollector *collector, const ErrorPath *error_path,
                        Deserializers *deserializers);
 
 /**
@@ -83,14 +88,46 @@ PyObject *validate_set(PyObject *value, TypeSchema *ts,
  * @param value The Python object to validate.
  * @param ts The union type schema for validation.
  * @param collector ErrorCollector for recording errors.
- * @param error_path Path string for error messages.
+ * @param error_path Location of the value for error messages.
  * @param deserializers Deserializers for conversion.
  * @return A new PyObject after validation, or nullptr on error.
  */
 PyObject *validate_union(PyObject *value, TypeSchema *ts,
-                         ErrorCollector *collector, const char *error_path,
+                         ErrorCollector *collector, const ErrorPath *error_path,
                          Deserializers *deserializers);
 
+/**
+ * @brief Validate a value against Optional[X] for a non-generic X.
+ *
+ * None is accepted; anything else is validated as X. Failures are reported
+ * like those of any other union.
+ *
+ * @param value The input value.
+ * @param ts The TypeSchema describing the optional (OP_OPTIONAL).
+ * @param collector ErrorCollector for recording errors.
+ * @param error_path Location of the value for error messages.
+ * @param deserializers Pointer to a Deserializers cache.
+ * @return A new reference to the validated value, or nullptr on failure.
+ */
+PyObject *validate_optional(PyObject *value, TypeSchema *ts,
+                            ErrorCollector *collector,
+                            const ErrorPath *error_path,
+                            Deserializers *deserializers);
+
+/**
+ * @brief Select the member of a discriminated union for a tag value.
+ *
+ * @param ts The union type schema (with a tag table).
+ * @param tag The value of the discriminator key, or nullptr if absent.
+ * @param collector ErrorCollector for recording errors.
+ * @param error_path Location of the value for error messages.
+ * @return The selected member's schema, or nullptr if the tag is missing or
+ * unknown (an error is recorded).
+ */
+TypeSchema *select_tagged_candidate(TypeSchema *ts, PyObject *tag,
+                                    ErrorCollector *collector,
+                                    const ErrorPath *error_path);
+
 #ifdef __cplusplus
 }
 #endif
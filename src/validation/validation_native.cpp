@@ -0,0 +1,342 @@
+#include <Python.h>
+#include <string>
+
+#include "conversion/rapidjson_to_pyobject.hpp"
+#include "data_model.hpp"
+#include "error_handling.hpp"
+#include "init_globals.hpp"
+#include "schema/deserializer.hpp"
+#include "schema/schema.hpp"
+#include "validation.hpp"
+#include "validation_builtins.hpp"
+#include "validation_containers.hpp"
+#include "validation_native.hpp"
+
+/**
+ * @brief Records the pending Python exception as nested model errors.
+ *
+ * Mirrors the handling of nested models in validate_and_convert: the errors of
+ * a ValidationError are merged under the given path, the text of any other
+ * exception is added as suberrors.
+ *
+ * @param collector Pointer to an ErrorCollector for reporting errors.
+ * @param error_path The base error path.
+ */
+static void record_nested_error(ErrorCollector *collector,
+                                const ErrorPath *error_path) {
+  PyObject *exc_type = nullptr, *exc_value = nullptr, *exc_tb = nullptr;
+  PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+  const std::vector<ErrorRecord> *records = validation_error_records(exc_value);
+  if (records) {
+    if (collector) {
+      collector->merge(ErrorPath::format(error_path), *records);
+    }
+  } else {
+    PyObject *exc_str = exc_value ? PyObject_Str(exc_value) : nullptr;
+    const char *nested_json =
+        exc_str ? PyUnicode_AsUTF8(exc_str) : "Unknown error";
+    if (collector) {
+      collector->add_suberror(ErrorPath::format(error_path),
+                              nested_json ? nested_json : "Unknown error");
+    }
+    Py_XDECREF(exc_str);
+  }
+  Py_XDECREF(exc_type);
+  Py_XDECREF(exc_value);
+  Py_XDECREF(exc_tb);
+  PyErr_Clear();
+}
+
+/**
+ * @brief Builds a nested DataModel directly from a JSON object.
+ *
+ * The instance is allocated for the model's schema and initialized with
+ * DataModel_init_native_nested, so no intermediate dict is created and field
+ * errors land in the caller's collector under error_path.
+ *
+ * @param native The rapidjson object.
+ * @param ts Pointer to the TypeSchema describing the nested model.
+ * @param collector Pointer to an ErrorCollector for reporting errors.
+ * @param error_path The base error path.
+ * @return A new model instance on success, or nullptr on error.
+ */
+static PyObject *validate_native_model(const rapidjson::Value &native,
+                                       TypeSchema *ts,
+                                       ErrorCollector *collector,
+                                       const ErrorPath *error_path) {
+  PyTypeObject *type = reinterpret_cast<PyTypeObject *>(ts->expected_type);
+  SchemaCache *schema = get_schema_cached(ts->expected_type);
+  PyObject *instance = schema ? DataModel_alloc(type, schema) : nullptr;
+  if (!instance) {
+    record_nested_error(collector, error_path);
+    return nullptr;
+  }
+  ErrorCollector local;
+  int result = DataModel_init_native_nested(instance, native, schema,
+                                            collector ? collector : &local,
+                                            error_path);
+  if (result == 0) {
+    return instance;
+  }
+  Py_DECREF(instance);
+  if (result < 0) {
+    record_nested_error(collector, error_path);
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Validates and converts a JSON array into a Python list.
+ *
+ * @param native The rapidjson array.
+ * @param ts The type schema for the list.
+ * @param collector The error collector.
+ * @param error_path The base error path.
+ * @param deserializers The deserializers container.
+ * @return A new list with validated and converted items, or nullptr on error.
+ */
+static PyObject *validate_native_list(const rapidjson::Value &native,
+                                      TypeSchema *ts, ErrorCollector *collector,
+                                      const ErrorPath *error_path,
+                                      Deserializers *deserializers) {
+  rapidjson::SizeType size = native.Size();
+  PyObject *new_list = PyList_New(size);
+  if (!new_list) {
+    return nullptr;
+  }
+
+  for (rapidjson::SizeType i = 0; i < size; i++) {
+    ErrorPath item_path(error_path, static_cast<Py_ssize_t>(i));
+    PyObject *conv_item = validate_native_value(
+        native[i], ts->args[0], collector, &item_path, deserializers);
+    if (!conv_item) {
+      Py_DECREF(new_list);
+      return nullptr;
+    }
+    PyList_SET_ITEM(new_list, i, conv_item);
+  }
+  return new_list;
+}
+
+/**
+ * @brief Validates and converts a JSON object into a Python dict.
+ *
+ * JSON keys are always strings; they are passed through the key schema only
+ * when it expects something other than str.
+ *
+ * @param native The rapidjson object.
+ * @param ts The type schema for the dictionary keys and values.
+ * @param collector The error collector.
+ * @param error_path The base error path.
+ * @param deserializers The deserializers container.
+ * @return A new dictionary with validated and converted key-value pairs, or
+ * nullptr on error.
+ */
+static PyObject *validate_native_dict(const rapidjson::Value &native,
+                                      TypeSchema *ts, ErrorCollector *collector,
+                                      const ErrorPath *error_path,
+                                      Deserializers *deserializers) {
+  PyObject *new_dict = PyDict_New();
+  if (!new_dict) {
+    return nullptr;
+  }
+
+  TypeSchema *key_schema = ts->args[0];
+  TypeSchema *val_schema = ts->args[1];
+
+  for (auto itr = native.MemberBegin(); itr != native.MemberEnd(); ++itr) {
+    ErrorPath key_path(error_path, itr->name.GetString(),
+                       itr->name.GetStringLength());
+    PyObject *key = PyUnicode_FromStringAndSize(itr->name.GetString(),
+                                                itr->name.GetStringLength());
+    if (!key) {
+      Py_DECREF(new_dict);
+      return nullptr;
+    }
+    PyObject *conv_key = key;
+    if (key_schema->expected_type != StrType) {
+      conv_key = validate_and_convert(key, key_schema, collector,
+                                      &key_path, deserializers);
+      Py_DECREF(key);
+      if (!conv_key) {
+        Py_DECREF(new_dict);
+        return nullptr;
+      }
+    }
+    PyObject *conv_val = validate_native_value(
+        itr->value, val_schema, collector, &key_path, deserializers);
+    if (!conv_val) {
+      Py_DECREF(conv_key);
+      Py_DECREF(new_dict);
+      return nullptr;
+    }
+    if (PyDict_SetItem(new_dict, conv_key, conv_val) < 0) {
+      Py_DECREF(conv_key);
+      Py_DECREF(conv_val);
+      Py_DECREF(new_dict);
+      return nullptr;
+    }
+    Py_DECREF(conv_key);
+    Py_DECREF(conv_val);
+  }
+  return new_dict;
+}
+
+/**
+ * @brief Validates a JSON value against Optional[X] for a non-generic X.
+ *
+ * Mirrors validate_optional; the value is only materialized to report a
+ * failure.
+ *
+ * @param native The rapidjson value.
+ * @param ts The optional type schema.
+ * @param collector The error collector.
+ * @param error_path The base error path.
+ * @param deserializers The deserializers container.
+ * @return A new PyObject on success, or nullptr on error.
+ */
+static PyObject *validate_native_optional(const rapidjson::Value &native,
+                                          TypeSchema *ts,
+                                          ErrorCollector *collector,
+                                          const ErrorPath *error_path,
+                                          Deserializers *deserializers) {
+  if (native.IsNull()) {
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  PyObject *conv = validate_native_value(native, ts->optional_target, nullptr,
+                                         error_path, deserializers);
+  if (conv) {
+    return conv;
+  }
+  PyErr_Clear();
+  if (collector) {
+    PyObject *value = rapidjson_to_pyobject(native);
+    if (!value) {
+      return nullptr;
+    }
+    collector->add_code(error_path, ERR_UNION, value);
+    Py_DECREF(value);
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Validates a JSON object against a discriminated union.
+ *
+ * Only the tag value, read from the first tag key present, is materialized;
+ * the object itself is validated by the selected member without going
+ * through a dict.
+ *
+ * @param native The rapidjson object.
+ * @param ts The union type schema.
+ * @param collector The error collector.
+ * @param error_path The base error path.
+ * @param deserializers The deserializers container.
+ * @return A new PyObject on success, or nullptr on error.
+ */
+static PyObject *validate_native_tagged(const rapidjson::Value &native,
+                                        TypeSchema *ts,
+                                        ErrorCollector *collector,
+                                        const ErrorPath *error_path,
+                                        Deserializers *deserializers) {
+  PyObject *tag = nullptr;
+  for (Py_ssize_t i = 0; !tag && i < PyList_GET_SIZE(ts->tag_keys); i++) {
+    Py_ssize_t key_len;
+    const char *key =
+        PyUnicode_AsUTF8AndSize(PyList_GET_ITEM(ts->tag_keys, i), &key_len);
+    if (!key) {
+      return nullptr;
+    }
+    const rapidjson::Value *member =
+        find_last_member(native, key, static_cast<size_t>(key_len));
+    if (member) {
+      tag = rapidjson_to_pyobject(*member);
+      if (!tag) {
+        return nullptr;
+      }
+    }
+  }
+  TypeSchema *candidate =
+      select_tagged_candidate(ts, tag, collector, error_path);
+  Py_XDECREF(tag);
+  return candidate ? validate_native_value(native, candidate, collector,
+                                           error_path, deserializers)
+                   : nullptr;
+}
+
+/**
+ * @brief Validates and converts a JSON value to the expected type.
+ *
+ * Dispatches on the schema's opcode. Nested models, lists and dicts are
+ * validated straight from the DOM, as are the non-null values of an optional
+ * and the objects of a discriminated union once the tag has picked the
+ * member. Strings in the canonical form of a datetime, date, time or UUID are
+ * parsed without creating a str. All other values are materialized once and
+ * passed to validate_and_convert, which accepts exact primitive matches
+ * first.
+ *
+ * @param native The rapidjson value to validate.
+ * @param ts Pointer to the TypeSchema describing the expected type.
+ * @param collector Pointer to an ErrorCollector for reporting errors.
+ * @param error_path The base error path.
+ * @param deserializers Pointer to registered deserializers.
+ * @return A new PyObject on success, or nullptr on error.
+ */
+PyObject *validate_native_value(const rapidjson::Value &native, TypeSchema *ts,
+                                ErrorCollector *collector,
+                                const ErrorPath *error_path,
+                                Deserializers *deserializers) {
+  switch (ts->op) {
+  case OP_MODEL:
+    if (native.IsObject() &&
+        DataModel_supports_native_init(
+            reinterpret_cast<PyTypeObject *>(ts->expected_type))) {
+      return validate_native_model(native, ts, collector, error_path);
+    }
+    break;
+  case OP_LIST:
+    if (native.IsArray()) {
+      return validate_native_list(native, ts, collector, error_path,
+                                  deserializers);
+    }
+    break;
+  case OP_DICT:
+    if (native.IsObject()) {
+      return validate_native_dict(native, ts, collector, error_path,
+                                  deserializers);
+    }
+    break;
+  case OP_OPTIONAL:
+    return validate_native_optional(native, ts, collector, error_path,
+                                    deserializers);
+  case OP_UNION:
+    if (ts->tag_table && native.IsObject()) {
+      return validate_native_tagged(native, ts, collector, error_path,
+                                    deserializers);
+    }
+    break;
+  case OP_DATETIME:
+  case OP_DATE:
+  case OP_TIME:
+  case OP_UUID:
+    if (native.IsString() &&
+        (!deserializers || !find_deserializer(ts, deserializers, StrType))) {
+      PyObject *parsed = parse_builtin_text(ts->op, native.GetString(),
+                                            native.GetStringLength());
+      if (parsed || PyErr_Occurred()) {
+        return parsed;
+      }
+    }
+    break;
+  }
+
+  PyObject *value = rapidjson_to_pyobject(native);
+  if (!value) {
+    return nullptr;
+  }
+  PyObject *converted =
+      validate_and_convert(value, ts, collector, error_path, deserializers);
+  Py_DECREF(value);
+  return converted;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "error_handling.hpp"
+#include "schema/deserializer.hpp"
+#include "schema/schema.hpp"
+#include <Python.h>
+#include <rapidjson/document.h>
+
+/**
+ * @brief Validate and convert a rapidjson value according to a type schema.
+ *
+ * Walks the JSON DOM against the compiled TypeSchema and creates only the
+ * final validated Python objects. Nested models, lists and dicts are built
+ * directly from the DOM; scalars and types without a native path are
+ * materialized and handed to validate_and_convert, so the result is the same
+ * as validating the equivalent Python object.
+ *
+ * @param native The rapidjson value to validate.
+ * @param ts Pointer to the compiled type schema against which to validate.
+ * @param collector Pointer to an ErrorCollector for recording any validation
+ * errors.
+ * @param error_path The current location in the data structure for error
+ * reporting, formatted only if an error is recorded.
+ * @param deserializers Pointer to a Deserializers cache (from the model
+ * configuration) used to convert between types.
+ * @return A new reference to the validated/converted value on success, or
+ * nullptr if validation fails.
+ */
+PyObject *validate_native_value(const rapidjson::Value &native, TypeSchema *ts,
+                                ErrorCollector *collector,
+                                const ErrorPath *error_path,
+                                Deserializers *deserializers);
@@ -12,42 +12,6 @@
 // extern PyObject *FloatType;
 // extern PyObject *BoolType;
 
-/**
- * @brief Returns a safe type name for a Python object.
- *
- * This function attempts to retrieve the __name__ or __qualname__ attribute of
- * a Python object if it is a type. Otherwise, it returns the type name or
- * "<unknown>".
- *
- * @param obj The Python object.
- * @return The safe type name as a C-string.
- */
-static const char *safe_type_name(PyObject *obj) {
-  if (!obj) {
-    return "<unknown>";
-  }
-  if (PyType_Check(obj)) {
-    PyObject *name_obj = PyObject_GetAttrString(obj, "__name__");
-    if (!name_obj) {
-      PyErr_Clear();
-      name_obj = PyObject_GetAttrString(obj, "__qualname__");
-    }
-    if (name_obj) {
-      const char *name = PyUnicode_AsUTF8(name_obj);
-      Py_DECREF(name_obj);
-      if (name) {
-        return name;
-      }
-    }
-    return ((PyTypeObject *)obj)->tp_name;
-  }
-  PyTypeObject *type = Py_TYPE(obj);
-  if (!type || !type->tp_name) {
-    return "<unknown>";
-  }
-  return type->tp_name;
-}
-
 /**
  * @brief Validates and converts a Python object to an integer.
  *
@@ -61,20 +25,19 @@ static const char *safe_type_name(PyObject *obj) {
  * @return A new reference to the integer, or nullptr on error.
  */
 PyObject *validate_int(PyObject *value, ErrorCollector *collector,
-                       const char *error_path) {
+                       const ErrorPath *error_path) {
   if (PyLong_Check(value)) {
     Py_INCREF(value);
     return value;
   } else {
-    PyObject *conv = PyObject_CallFunctionObjArgs(IntType, value, nullptr);
+    PyObject *conv = PyObject_CallOneArg(IntType, value);
     if (conv && PyLong_Check(conv)) {
       return conv;
     }
     Py_XDECREF(conv);
     PyErr_Clear();
     if (collector) {
-      collector->add_error(error_path, std::string("Expected type int, got ") +
-                                           safe_type_name(value));
+      collector->add_type_error(error_path, IntType, value);
     }
     return nullptr;
   }
@@ -93,20 +56,19 @@ PyObject *validate_int(PyObject *value, ErrorCollector *collector,
  * @return A new reference to the string, or nullptr on error.
  */
 PyObject *validate_str(PyObject *value, ErrorCollector *collector,
-                       const char *error_path) {
+                       const ErrorPath *error_path) {
   if (PyUnicode_Check(value)) {
     Py_INCREF(value);
     return value;
   } else {
-    PyObject *conv = PyObject_CallFunctionObjArgs(StrType, value, nullptr);
+    PyObject *conv = PyObject_CallOneArg(StrType, value);
     if (conv && PyUnicode_Check(conv)) {
       return conv;
     }
     Py_XDECREF(conv);
     PyErr_Clear();
     if (collector) {
-      collector->add_error(error_path, std::string("Expected type str, got ") +
-                                           safe_type_name(value));
+      collector->add_type_error(error_path, StrType, value);
     }
     return nullptr;
   }
@@ -125,21 +87,19 @@ PyObject *validate_str(PyObject *value, ErrorCollector *collector,
  * @return A new reference to the float, or nullptr on error.
  */
 PyObject *validate_float(PyObject *value, ErrorCollector *collector,
-                         const char *error_path) {
+                         const ErrorPath *error_path) {
   if (PyFloat_Check(value)) {
     Py_INCREF(value);
     return value;
   } else {
-    PyObject *conv = PyObject_CallFunctionObjArgs(FloatType, value, nullptr);
+    PyObject *conv = PyObject_CallOneArg(FloatType, value);
     if (conv && PyFloat_Check(conv)) {
       return conv;
     }
     Py_XDECREF(conv);
     PyErr_Clear();
     if (collector) {
-      collector->add_error(error_path,
-                           std::string("Expected type float, got ") +
-                               safe_type_name(value));
+      collector->add_type_error(error_path, FloatType, value);
     }
     return nullptr;
   }
@@ -158,20 +118,19 @@ PyObject *validate_float(PyObject *value, ErrorCollector *collector,
  * @return A new reference to the boolean, or nullptr on error.
  */
 PyObject *validate_bool(PyObject *value, ErrorCollector *collector,
-                        const char *error_path) {
+                        const ErrorPath *error_path) {
   if (PyBool_Check(value)) {
     Py_INCREF(value);
     return value;
   } else {
-    PyObject *conv = PyObject_CallFunctionObjArgs(BoolType, value, nullptr);
+    PyObject *conv = PyObject_CallOneArg(BoolType, value);
     if (conv && PyBool_Check(conv)) {
       return conv;
     }
     Py_XDECREF(conv);
     PyErr_Clear();
     if (collector) {
-      collector->add_error(error_path, std::string("Expected type bool, got ") +
-                                           safe_type_name(value));
+      collector->add_type_error(error_path, BoolType, value);
     }
     return nullptr;
   }
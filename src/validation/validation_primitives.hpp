@@ -20,7 +20,7 @@ extern "C" {
  * @return New reference to a valid int object on success; nullptr on failure.
  */
 PyObject *validate_int(PyObject *value, ErrorCollector *collector,
-                       const char *error_path);
+                       const ErrorPath *error_path);
 
 /**
  * @brief Validate and possibly convert to a string primitive.
@@ -32,7 +32,7 @@ PyObject *validate_int(PyObject *value, ErrorCollector *collector,
  * failure.
  */
 PyObject *validate_str(PyObject *value, ErrorCollector *collector,
-                       const char *error_path);
+                       const ErrorPath *error_path);
 
 /**
  * @brief Validate and possibly convert to a float primitive.
@@ -43,7 +43,7 @@ PyObject *validate_str(PyObject *value, ErrorCollector *collector,
  * @return New reference to a valid float object on success; nullptr on failure.
  */
 PyObject *validate_float(PyObject *value, ErrorCollector *collector,
-                         const char *error_path);
+                         const ErrorPath *error_path);
 
 /**
  * @brief Validate and possibly convert to a bool primitive.
@@ -54,7 +54,7 @@ PyObject *validate_float(PyObject *value, ErrorCollector *collector,
  * @return New reference to a valid bool object on success; nullptr on failure.
  */
 PyObject *validate_bool(PyObject *value, ErrorCollector *collector,
-                        const char *error_path);
+                        const ErrorPath *error_path);
 
 #ifdef __cplusplus
 }
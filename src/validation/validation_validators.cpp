@@ -1,5 +1,10 @@
 #include "validation_validators.hpp"
+#include "data_model.hpp"
+#include "error_handling.hpp"
+#include "stats.hpp"
+#include "validation.hpp"
 #include <Python.h>
+#include <new>
 
 /**
  * @brief Returns a new reference to a callable validator.
@@ -23,119 +28,206 @@ static PyObject *get_callable_validator(PyObject *validator) {
     }
     Py_XDECREF(func);
   }
+  PyErr_Clear();
   return nullptr;
 }
 
 /**
- * @brief Runs model validators.
+ * @brief Tells whether a model AFTER validator takes the class argument.
  *
- * Iterates over validator_list and calls each callable validator on target,
- * optionally including cls as argument.
+ * Validators whose code object has a single positional parameter are
+ * instance methods called with the instance only.
  *
- * @param cls The model class.
- * @param validator_list List of validator objects.
- * @param target The target PyObject to validate.
- * @param call_with_cls Flag indicating if cls should be passed.
+ * @param validator The original validator object.
+ * @return 1 to call with (cls, instance), 0 to call with (instance).
+ */
+static int model_after_takes_cls(PyObject *validator) {
+  int argcount = 0;
+  PyObject *code = PyObject_GetAttrString(validator, "__code__");
+  if (code) {
+    PyObject *argcount_obj = PyObject_GetAttrString(code, "co_argcount");
+    if (argcount_obj && PyLong_Check(argcount_obj)) {
+      argcount = static_cast<int>(PyLong_AsLong(argcount_obj));
+    }
+    Py_XDECREF(argcount_obj);
+    Py_DECREF(code);
+  }
+  PyErr_Clear();
+  return argcount != 1;
+}
+
+/**
+ * @brief Resolves a list of validators into a chain.
+ *
+ * Entries that are not callable are skipped.
+ *
+ * @param validator_list A Python list of validators, or another object for
+ * an empty chain.
+ * @param model_after Whether the list holds model AFTER validators, whose
+ * calling signature depends on the validator.
+ * @param chain The chain to fill; must be empty.
  * @return 0 on success, -1 on error.
  */
-int run_model_validators(PyObject *cls, PyObject *validator_list,
-                         PyObject *target, int call_with_cls) {
-  Py_ssize_t len = PyList_Size(validator_list);
-  if (len == 0) {
+static int compile_chain(PyObject *validator_list, bool model_after,
+                         ValidatorChain *chain) {
+  if (!validator_list || !PyList_Check(validator_list) ||
+      PyList_GET_SIZE(validator_list) == 0) {
     return 0;
   }
+  Py_ssize_t len = PyList_GET_SIZE(validator_list);
+  chain->items = new (std::nothrow) CompiledValidator[len];
+  if (!chain->items) {
+    PyErr_NoMemory();
+    return -1;
+  }
   for (Py_ssize_t i = 0; i < len; i++) {
-    PyObject *validator = PyList_GetItem(validator_list, i);
-    PyObject *callable_validator = get_callable_validator(validator);
-    if (!callable_validator) {
+    PyObject *validator = PyList_GET_ITEM(validator_list, i);
+    PyObject *func = get_callable_validator(validator);
+    if (!func) {
       continue;
     }
-    PyObject *result =
-        call_with_cls
-            ? PyObject_CallFunctionObjArgs(callable_validator, cls, target,
-                                           nullptr)
-            : PyObject_CallFunctionObjArgs(callable_validator, target, nullptr);
-    Py_DECREF(callable_validator);
-    if (!result) {
+    CompiledValidator &item = chain->items[chain->count++];
+    item.func = func;
+    item.with_cls = model_after ? model_after_takes_cls(validator) : 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Releases the validators of a chain.
+ *
+ * @param chain The chain to empty.
+ */
+static void free_chain(ValidatorChain *chain) {
+  for (Py_ssize_t i = 0; i < chain->count; i++) {
+    Py_DECREF(chain->items[i].func);
+  }
+  delete[] chain->items;
+  chain->items = nullptr;
+  chain->count = 0;
+}
+
+/**
+ * @brief Resolves the per-field validators of one mode.
+ *
+ * @param schema The schema whose fields receive the chains.
+ * @param field_validators Dict mapping field names to validator lists.
+ * @param after Whether the dict holds AFTER validators.
+ * @return The number of fields with validators, or -1 on error.
+ */
+static Py_ssize_t compile_field_chains(SchemaCache *schema,
+                                       PyObject *field_validators,
+                                       bool after) {
+  if (!field_validators || !PyDict_Check(field_validators)) {
+    return 0;
+  }
+  Py_ssize_t fields_with_validators = 0;
+  Py_ssize_t pos = 0;
+  PyObject *key, *validator_list;
+  while (PyDict_Next(field_validators, &pos, &key, &validator_list)) {
+    Py_ssize_t index = lookup_field_index(schema, key);
+    if (index < 0) {
+      continue;
+    }
+    FieldSchema *fs = &schema->fields[index];
+    ValidatorChain *chain =
+        after ? &fs->after_validators : &fs->before_validators;
+    free_chain(chain);
+    if (compile_chain(validator_list, false, chain) < 0) {
       return -1;
     }
-    if (result && PyDict_Check(result) && call_with_cls) {
-      if (PyDict_Update(target, result) != 0) {
-        Py_DECREF(result);
-        return -1;
-      }
+    if (chain->count > 0) {
+      fields_with_validators++;
     }
-    Py_DECREF(result);
   }
+  return fields_with_validators;
+}
+
+int compile_validator_chains(SchemaCache *schema) {
+  PyObject *validators = schema->validators;
+  Py_ssize_t before = compile_field_chains(
+      schema, PyDict_GetItemString(validators, "field_before"), false);
+  Py_ssize_t after = compile_field_chains(
+      schema, PyDict_GetItemString(validators, "field_after"), true);
+  if (before < 0 || after < 0 ||
+      compile_chain(PyDict_GetItemString(validators, "model_before"), false,
+                    &schema->model_before) < 0 ||
+      compile_chain(PyDict_GetItemString(validators, "model_after"), true,
+                    &schema->model_after) < 0) {
+    return -1;
+  }
+  schema->has_field_before = before > 0;
+  schema->has_field_after = after > 0;
+  schema->has_model_before = schema->model_before.count > 0;
+  schema->has_model_after = schema->model_after.count > 0;
   return 0;
 }
 
+void free_validator_chains(SchemaCache *schema) {
+  for (Py_ssize_t i = 0; i < schema->num_fields; i++) {
+    free_chain(&schema->fields[i].before_validators);
+    free_chain(&schema->fields[i].after_validators);
+  }
+  free_chain(&schema->model_before);
+  free_chain(&schema->model_after);
+}
+
 /**
- * @brief Runs field before validators.
+ * @brief Calls a compiled validator.
  *
- * Applies 'field_before' validators from the schema on the provided keyword
- * arguments dictionary.
+ * The call is accounted as validator time by vldt.stats().
  *
- * @param schema SchemaCache containing validators.
+ * @param validator The validator.
  * @param cls The model class.
- * @param pKwds Pointer to the keyword arguments dictionary.
- * @return 0 on success, -1 on error.
+ * @param target The value, dict or instance to validate.
+ * @return New reference to the result, or nullptr on error.
  */
-int run_field_before_validators(SchemaCache *schema, PyObject *cls,
-                                PyObject **pKwds) {
-  if (!schema->has_field_before) {
-    return 0;
-  }
-  PyObject *field_before =
-      PyDict_GetItemString(schema->validators, "field_before");
-  if (field_before && PyDict_Check(field_before) &&
-      PyDict_Size(field_before) == 0) {
-    return 0;
+static inline PyObject *call_validator(const CompiledValidator &validator,
+                                       PyObject *cls, PyObject *target) {
+  ValidatorTimer timer;
+  PyObject *args[3] = {nullptr, cls, target};
+  if (validator.with_cls) {
+    return PyObject_Vectorcall(validator.func, args + 1,
+                               2 | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
   }
-  if (field_before && PyDict_Check(field_before)) {
-    PyObject *key;
-    PyObject *val;
-    Py_ssize_t pos = 0;
-    while (PyDict_Next(field_before, &pos, &key, &val)) {
-      if (PyDict_Contains(*pKwds, key)) {
-        PyObject *current_value = PyDict_GetItem(*pKwds, key);
-        Py_INCREF(current_value);
-        if (val && PyList_Check(val)) {
-          Py_ssize_t len_val = PyList_Size(val);
-          for (Py_ssize_t i = 0; i < len_val; i++) {
-            PyObject *validator = PyList_GetItem(val, i);
-            PyObject *callable_validator = get_callable_validator(validator);
-            if (callable_validator && PyCallable_Check(callable_validator)) {
-              PyObject *new_value = PyObject_CallFunctionObjArgs(
-                  callable_validator, cls, current_value, nullptr);
-              Py_DECREF(callable_validator);
-              if (!new_value) {
-                Py_DECREF(current_value);
-                return -1;
-              }
-              Py_DECREF(current_value);
-              current_value = new_value;
-            } else if (callable_validator) {
-              Py_DECREF(callable_validator);
-            }
-          }
-        }
-        if (PyDict_SetItem(*pKwds, key, current_value) < 0) {
-          Py_DECREF(current_value);
-          return -1;
-        }
-        Py_DECREF(current_value);
-      }
+  return PyObject_Vectorcall(validator.func, args + 2,
+                             1 | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
+}
+
+/**
+ * @brief Runs a chain of field validators on a value.
+ *
+ * Each validator receives the result of the previous one.
+ *
+ * @param chain The validators.
+ * @param cls The model class.
+ * @param value The value of the field.
+ * @return New reference to the final value, or nullptr on error.
+ */
+static PyObject *run_field_chain(const ValidatorChain &chain, PyObject *cls,
+                                 PyObject *value) {
+  Py_INCREF(value);
+  for (Py_ssize_t i = 0; i < chain.count; i++) {
+    PyObject *new_value = call_validator(chain.items[i], cls, value);
+    Py_DECREF(value);
+    if (!new_value) {
+      return nullptr;
     }
+    value = new_value;
   }
-  return 0;
+  return value;
+}
+
+PyObject *run_field_before_validators(FieldSchema *fs, PyObject *cls,
+                                      PyObject *value) {
+  return run_field_chain(fs->before_validators, cls, value);
 }
 
 /**
  * @brief Runs model before validators.
  *
- * Applies 'model_before' validators from the schema on the provided keyword
- * arguments dictionary.
+ * Applies the model BEFORE validators of the schema to the keyword arguments
+ * dictionary, merging any dict a validator returns into it.
  *
  * @param schema SchemaCache containing validators.
  * @param cls The model class.
@@ -144,16 +236,17 @@ int run_field_before_validators(SchemaCache *schema, PyObject *cls,
  */
 int run_model_before_validators(SchemaCache *schema, PyObject *cls,
                                 PyObject **pKwds) {
-  if (!schema->has_model_before) {
-    return 0;
-  }
-  PyObject *model_before =
-      PyDict_GetItemString(schema->validators, "model_before");
-  if (model_before && PyList_Check(model_before)) {
-    if (PyList_Size(model_before) == 0) {
-      return 0;
+  const ValidatorChain &chain = schema->model_before;
+  for (Py_ssize_t i = 0; i < chain.count; i++) {
+    PyObject *result = call_validator(chain.items[i], cls, *pKwds);
+    if (!result) {
+      return -1;
+    }
+    if (PyDict_Check(result) && PyDict_Update(*pKwds, result) != 0) {
+      Py_DECREF(result);
+      return -1;
     }
-    return run_model_validators(cls, model_before, *pKwds, 1);
+    Py_DECREF(result);
   }
   return 0;
 }
@@ -161,8 +254,9 @@ int run_model_before_validators(SchemaCache *schema, PyObject *cls,
 /**
  * @brief Runs field after validators.
  *
- * Applies 'field_after' validators from the schema on the attributes of the
- * instance.
+ * Applies the field AFTER validators of the schema to the values stored in
+ * the instance. Results are validated against the type of the field, as an
+ * assignment would be, and stored back.
  *
  * @param schema SchemaCache containing validators.
  * @param cls The model class.
@@ -174,45 +268,35 @@ int run_field_after_validators(SchemaCache *schema, PyObject *cls,
   if (!schema->has_field_after) {
     return 0;
   }
-  PyObject *field_after =
-      PyDict_GetItemString(schema->validators, "field_after");
-  if (field_after && PyDict_Check(field_after)) {
-    if (PyDict_Size(field_after) == 0) {
-      return 0;
+  PyObject **slots = DataModel_slots(self);
+  for (Py_ssize_t i = 0;
+       i < schema->num_fields && i < DataModel_num_slots(self); i++) {
+    FieldSchema *fs = &schema->fields[i];
+    if (fs->after_validators.count == 0 || !slots[i]) {
+      continue;
     }
-    PyObject *key;
-    PyObject *val;
-    Py_ssize_t pos = 0;
-    while (PyDict_Next(field_after, &pos, &key, &val)) {
-      if (PyObject_HasAttr(self, key)) {
-        PyObject *current_value = PyObject_GetAttr(self, key);
-        if (current_value && PyList_Check(val)) {
-          Py_ssize_t len_val = PyList_Size(val);
-          for (Py_ssize_t i = 0; i < len_val; i++) {
-            PyObject *validator = PyList_GetItem(val, i);
-            PyObject *callable_validator = get_callable_validator(validator);
-            if (callable_validator && PyCallable_Check(callable_validator)) {
-              PyObject *new_value = PyObject_CallFunctionObjArgs(
-                  callable_validator, cls, current_value, nullptr);
-              Py_DECREF(callable_validator);
-              if (!new_value) {
-                Py_DECREF(current_value);
-                return -1;
-              }
-              Py_DECREF(current_value);
-              current_value = new_value;
-            } else if (callable_validator) {
-              Py_DECREF(callable_validator);
-            }
-          }
-          if (PyObject_SetAttr(self, key, current_value) < 0) {
-            Py_DECREF(current_value);
-            return -1;
-          }
-          Py_DECREF(current_value);
-        }
+    PyObject *result = run_field_chain(fs->after_validators, cls, slots[i]);
+    if (!result) {
+      return -1;
+    }
+    ErrorCollector collector;
+    ErrorPath field_path(nullptr, fs->field_name_c);
+    PyObject *converted =
+        validate_and_convert(result, fs->type_schema, &collector, &field_path,
+                             schema->deserializers);
+    Py_DECREF(result);
+    if (!converted) {
+      if (collector.has_errors()) {
+        collector.raise();
+      } else if (!PyErr_Occurred()) {
+        PyErr_Format(PyExc_TypeError, "Invalid value for attribute %R",
+                     fs->field_name);
       }
+      return -1;
     }
+    PyObject *old = slots[i];
+    slots[i] = converted;
+    Py_DECREF(old);
   }
   return 0;
 }
@@ -220,7 +304,7 @@ int run_field_after_validators(SchemaCache *schema, PyObject *cls,
 /**
  * @brief Runs model after validators.
  *
- * Applies 'model_after' validators from the schema on the instance.
+ * Applies the model AFTER validators of the schema to the instance.
  *
  * @param schema SchemaCache containing validators.
  * @param cls The model class.
@@ -229,46 +313,13 @@ int run_field_after_validators(SchemaCache *schema, PyObject *cls,
  */
 int run_model_after_validators(SchemaCache *schema, PyObject *cls,
                                PyObject *self) {
-  if (!schema->has_model_after) {
-    return 0;
-  }
-  PyObject *model_after =
-      PyDict_GetItemString(schema->validators, "model_after");
-  if (model_after && PyList_Check(model_after)) {
-    if (PyList_Size(model_after) == 0) {
-      return 0;
-    }
-    Py_ssize_t len = PyList_Size(model_after);
-    for (Py_ssize_t i = 0; i < len; i++) {
-      PyObject *validator = PyList_GetItem(model_after, i);
-      PyObject *callable_validator = get_callable_validator(validator);
-      if (!callable_validator) {
-        continue;
-      }
-      int argcount = 0;
-      PyObject *code = PyObject_GetAttrString(validator, "__code__");
-      if (code) {
-        PyObject *argcount_obj = PyObject_GetAttrString(code, "co_argcount");
-        if (argcount_obj && PyLong_Check(argcount_obj)) {
-          argcount = static_cast<int>(PyLong_AsLong(argcount_obj));
-        }
-        Py_XDECREF(argcount_obj);
-        Py_DECREF(code);
-      }
-      if (argcount == 1) {
-        if (!PyObject_CallFunctionObjArgs(callable_validator, self, nullptr)) {
-          Py_DECREF(callable_validator);
-          return -1;
-        }
-      } else {
-        if (!PyObject_CallFunctionObjArgs(callable_validator, cls, self,
-                                          nullptr)) {
-          Py_DECREF(callable_validator);
-          return -1;
-        }
-      }
-      Py_DECREF(callable_validator);
+  const ValidatorChain &chain = schema->model_after;
+  for (Py_ssize_t i = 0; i < chain.count; i++) {
+    PyObject *result = call_validator(chain.items[i], cls, self);
+    if (!result) {
+      return -1;
     }
+    Py_DECREF(result);
   }
   return 0;
 }
@@ -8,29 +8,33 @@ extern "C" {
 #endif
 
 /**
- * Run a list of model-level validators.
- * If call_with_cls is true, each validator is called with (cls, target);
- * otherwise, with (target,).
+ * Resolve the validators of a schema into its validator chains.
  *
- * @param cls            The model class.
- * @param validator_list A Python list of validators.
- * @param target         The dictionary or model instance to validate.
- * @param call_with_cls  Flag to control the calling signature.
+ * Reads schema->validators (the __vldt_validators__ dict) and updates the
+ * has_* flags from the resulting chains.
+ *
+ * @param schema A pointer to the SchemaCache being compiled.
  * @return 0 on success, -1 on failure.
  */
-int run_model_validators(PyObject *cls, PyObject *validator_list,
-                         PyObject *target, int call_with_cls);
+int compile_validator_chains(SchemaCache *schema);
 
 /**
- * Run field BEFORE validators.
+ * Release the validator chains of a schema.
  *
- * @param schema A pointer to the compiled SchemaCache.
+ * @param schema A pointer to the SchemaCache.
+ */
+void free_validator_chains(SchemaCache *schema);
+
+/**
+ * Run the field BEFORE validators of one field on its input value.
+ *
+ * @param fs     The field schema.
  * @param cls    The model class.
- * @param pKwds  Pointer to the dict containing field values.
- * @return 0 on success, -1 on failure.
+ * @param value  The input value of the field.
+ * @return New reference to the value to validate, or nullptr on failure.
  */
-int run_field_before_validators(SchemaCache *schema, PyObject *cls,
-                                PyObject **pKwds);
+PyObject *run_field_before_validators(FieldSchema *fs, PyObject *cls,
+                                      PyObject *value);
 
 /**
  * Run model BEFORE validators.
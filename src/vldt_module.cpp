@@ -1,20 +1,80 @@
+#include "conversion/json_lines.hpp"
 #include "data_model.hpp"
+#include "error_handling.hpp"
 #include "init_globals.hpp"
+#include "schema/schema.hpp"
+#include "stats.hpp"
 #include "validation/validation.hpp"
 #include <Python.h>
 
+static PyMethodDef vldt_methods[] = {
+    {"freelist_stats", (PyCFunction)DataModel_freelist_stats, METH_O,
+     "Return the counters of the instance freelist of a model class."},
+    {"stats", (PyCFunction)stats_snapshot, METH_NOARGS,
+     "Return the validation counters of each model class."},
+    {"reset_stats", (PyCFunction)stats_reset, METH_NOARGS,
+     "Reset the validation counters of every model class."},
+    {"enable_stats", (PyCFunction)stats_enable, METH_VARARGS | METH_KEYWORDS,
+     "Enable or disable counting validations for vldt.stats()."},
+    {nullptr, nullptr, 0, nullptr}};
+
+/**
+ * @brief Execute the module: ready the types and fill its namespace.
+ *
+ * The types and globals of the extension are shared by the whole process
+ * and initialized once; executing the module again, after it has been
+ * removed from sys.modules, only adds them to the new module object.
+ *
+ * @param m The module being executed.
+ * @return 0 on success, -1 on failure.
+ */
+static int vldt_exec(PyObject *m) {
+  // Imports of one module are serialized, so a plain flag is enough.
+  static bool globals_ready = false;
+  if (!globals_ready) {
+    if (PyType_Ready(&ModelMetaType) < 0 || PyType_Ready(&DataModelType) < 0 ||
+        PyType_Ready(&JsonLinesIterType) < 0 ||
+        init_validation_error_type() < 0) {
+      return -1;
+    }
+    if (init_data_model_globals() != 0 || init_validation_globals() != 0 ||
+        init_schema_globals() != 0) {
+      return -1;
+    }
+    globals_ready = true;
+  }
+
+  if (PyModule_AddObjectRef(m, "DataModel", (PyObject *)&DataModelType) < 0 ||
+      PyModule_AddObjectRef(m, "ModelMeta", (PyObject *)&ModelMetaType) < 0 ||
+      PyModule_AddObjectRef(m, "ValidationError",
+                            (PyObject *)&ValidationErrorType) < 0) {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * Module slots. The static types and the globals they use are shared by the
+ * whole process, so loading into other interpreters is refused. Shared state
+ * is synchronized by the extension itself, so it can run without the GIL.
+ */
+static PyModuleDef_Slot vldt_slots[] = {
+    {Py_mod_exec, (void *)vldt_exec},
+#if PY_VERSION_HEX >= 0x030C0000
+    {Py_mod_multiple_interpreters, Py_MOD_MULTIPLE_INTERPRETERS_NOT_SUPPORTED},
+#endif
+#if PY_VERSION_HEX >= 0x030D0000
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, nullptr}};
+
 static PyModuleDef vldtmodule = {
-    .m_base =
-        {
-            .ob_base = {.ob_refcnt = 1, .ob_type = &PyType_Type},
-            .m_index = 0,
-            .m_copy = 0,
-        },
+    .m_base = PyModuleDef_HEAD_INIT,
     .m_name = "vldt._vldt",
     .m_doc = "vldt C++ extension module",
-    .m_size = -1,
-    .m_methods = nullptr,
-    .m_slots = nullptr,
+    .m_size = 0,
+    .m_methods = vldt_methods,
+    .m_slots = vldt_slots,
     .m_traverse = nullptr,
     .m_clear = nullptr,
     .m_free = nullptr,
@@ -22,28 +82,6 @@ static PyModuleDef vldtmodule = {
 
 extern "C" {
 
-PyMODINIT_FUNC PyInit__vldt(void) {
-  if (PyType_Ready(&DataModelType) < 0) {
-    return nullptr;
-  }
-
-  auto m = PyModule_Create(&vldtmodule);
-  if (!m) {
-    return nullptr;
-  }
-
-  if (init_data_model_globals() != 0 || init_validation_globals() != 0) {
-    Py_DECREF(m);
-    return nullptr;
-  }
-
-  Py_INCREF(&DataModelType);
-  if (PyModule_AddObject(m, "DataModel", (PyObject *)&DataModelType) < 0) {
-    Py_DECREF(&DataModelType);
-    Py_DECREF(m);
-    return nullptr;
-  }
-  return m;
-}
+PyMODINIT_FUNC PyInit__vldt(void) { return PyModuleDef_Init(&vldtmodule); }
 
 } // extern "C"
@@ -1,10 +1,12 @@
 """Tests for async validators and async data models."""
 
+import asyncio
 import json
 import pytest
 from typing import Any
 from vldt import (
     AsyncDataModel,
+    Config,
     async_field_validator,
     async_model_validator,
     ValidatorMode,
@@ -292,6 +294,143 @@ class TestAsyncModelValidatorInstanceMethod:
         assert emp.name == "JANE"
 
 
+class AsyncAccount(AsyncDataModel):
+    """Async data model whose field validators run concurrently.
+
+    Attributes:
+        owner (str): The account owner.
+        region (str): The account region.
+    """
+
+    __vldt_config__ = Config(concurrent_validators=True)
+
+    owner: str
+    region: str
+
+    @async_field_validator(mode=ValidatorMode.BEFORE)
+    @classmethod
+    async def check_owner(cls, owner: str):
+        """Waits for the region check to start, then validates the owner.
+
+        Args:
+            owner (str): The input owner value.
+
+        Returns:
+            str: The owner in lowercase.
+
+        Raises:
+            ValueError: If the owner is empty.
+        """
+        await asyncio.wait_for(region_started.wait(), timeout=1)
+        if not owner:
+            raise ValueError("Owner must not be empty")
+        return owner.lower()
+
+    @async_field_validator(mode=ValidatorMode.BEFORE)
+    @classmethod
+    async def check_region(cls, region: str):
+        """Signals that it started, then validates the region.
+
+        Args:
+            region (str): The input region value.
+
+        Returns:
+            str: The region in uppercase.
+
+        Raises:
+            ValueError: If the region is empty.
+        """
+        region_started.set()
+        await asyncio.sleep(0)
+        if not region:
+            raise ValueError("Region must not be empty")
+        return region.upper()
+
+
+region_started = None
+
+
+class AsyncPair(AsyncDataModel):
+    """Async data model whose validators are defined out of field order.
+
+    Attributes:
+        x (int): The first field.
+        y (int): The second field.
+    """
+
+    __vldt_config__ = Config(concurrent_validators=True)
+
+    x: int
+    y: int
+
+    @async_field_validator(mode=ValidatorMode.BEFORE)
+    @classmethod
+    async def check_y(cls, y: int):
+        """Rejects negative values of y.
+
+        Args:
+            y (int): The input value.
+
+        Returns:
+            int: The unchanged value.
+
+        Raises:
+            ValueError: If the value is negative.
+        """
+        if y < 0:
+            raise ValueError("y failed")
+        return y
+
+    @async_field_validator(mode=ValidatorMode.BEFORE)
+    @classmethod
+    async def check_x(cls, x: int):
+        """Rejects negative values of x.
+
+        Args:
+            x (int): The input value.
+
+        Returns:
+            int: The unchanged value.
+
+        Raises:
+            ValueError: If the value is negative.
+        """
+        if x < 0:
+            raise ValueError("x failed")
+        return x
+
+
+@pytest.mark.asyncio
+class TestConcurrentAsyncValidators:
+    """Tests for concurrently run async validators."""
+
+    async def test_field_validators_run_concurrently(self):
+        """Test that validators of different fields overlap and errors are ordered."""
+        global region_started
+        region_started = asyncio.Event()
+        account = await AsyncAccount(owner="Ann", region="eu")
+        assert account.owner == "ann"
+        assert account.region == "EU"
+        with pytest.raises(ValueError, match="Owner must not be empty"):
+            await AsyncAccount(owner="", region="")
+
+    async def test_first_error_in_field_order(self):
+        """Test that the error of the first declared field wins, not the first validator."""
+        with pytest.raises(ValueError, match="x failed"):
+            await AsyncPair(x=-1, y=-1)
+        assert (await AsyncPair(x=1, y=2)).y == 2
+
+    async def test_validate_many_async(self):
+        """Test that validate_many_async keeps the record order and reports the first error."""
+        records = [{"name": "ann", "age": 20}, {"name": "bob", "age": "30"}]
+        people = await AsyncPerson.validate_many_async(records, concurrency=1)
+        assert [(p.name, p.age) for p in people] == [("Ann", 20), ("Bob", 30)]
+        records.append({"name": "tom", "age": "17"})
+        records.append({"name": "kim", "age": "abc"})
+        with pytest.raises(ValueError, match="older than 18"):
+            await AsyncPerson.validate_many_async(records)
+
+
 @pytest.mark.asyncio
 class TestInvalidAsyncValidatorSignature:
     """Tests for models with invalid async validator signatures."""
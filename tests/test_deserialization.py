@@ -1,4 +1,6 @@
+import sys
 from datetime import datetime
+from typing import List, Optional
 from uuid import UUID
 
 from vldt import DataModel, Config
@@ -44,6 +46,20 @@ class ModelWithManyTypes(DataModel):
     )
 
 
+class Event(DataModel):
+    """Data model using the global datetime deserializers.
+
+    Attributes:
+        at (datetime): The time of the event.
+        reminders (List[datetime]): Times to send reminders.
+        ended_at (Optional[datetime]): The end time, if known.
+    """
+
+    at: datetime
+    reminders: List[datetime]
+    ended_at: Optional[datetime] = None
+
+
 class TestDeserializer:
     """Test cases for the ModelWithManyTypes data model deserialization."""
 
@@ -81,3 +97,43 @@ class TestDeserializer:
         assert obj.height == 1.75
         assert obj.is_active is True
         assert obj.created_at == datetime(2021, 1, 1, 12, 0)
+
+    def test_deserializers_are_per_model(self):
+        """Test that models sharing a target type use their own deserializers."""
+        for _ in range(3):
+            custom = ModelWithManyTypes(
+                id=UUID("123e4567-e89b-12d3-a456-426614174000"),
+                name="Alice",
+                age=30,
+                height=1.75,
+                is_active=True,
+                created_at="2021/01/01 12:00:00",
+            )
+            event = Event(
+                at="2021-01-01T12:00:00",
+                reminders=["2021-01-01T11:00:00", 0],
+                ended_at="2021-01-01T13:00:00",
+            )
+            assert custom.created_at == datetime(2021, 1, 1, 12, 0)
+            assert event.at == datetime(2021, 1, 1, 12, 0)
+            assert event.reminders == [
+                datetime(2021, 1, 1, 11, 0),
+                datetime.fromtimestamp(0),
+            ]
+            assert event.ended_at == datetime(2021, 1, 1, 13, 0)
+
+    def test_deserializer_references_released(self):
+        """Test that calling a deserializer does not leak references."""
+        data = {
+            "id": "123e4567-e89b-12d3-a456-426614174000",
+            "name": "Alice",
+            "age": 30,
+            "height": 1.75,
+            "is_active": True,
+            "created_at": "2021/01/01 12:00:00",
+        }
+        ModelWithManyTypes.from_dict(data)
+        before = sys.getrefcount(from_string)
+        for _ in range(100):
+            ModelWithManyTypes.from_dict(data)
+        assert sys.getrefcount(from_string) == before
@@ -1,3 +1,4 @@
+import json
 from typing import List, Dict, Optional, Union
 
 import pytest
@@ -281,3 +282,135 @@ class TestToDictFromDict:
         assert obj.c == 1.0
         assert obj.m.b == "test"
         assert isinstance(obj.m, B)
+
+    def test_validate_many(self):
+        """Test building a list of models from a list of dictionaries."""
+        records = [
+            {"street": "1 Main St", "city": "Springfield", "postal_code": "111"},
+            {"street": "2 Main St", "city": "Shelbyville", "postal_code": "222"},
+        ]
+        addresses = Address.validate_many(records)
+        assert [a.to_dict() for a in addresses] == records
+        assert Address.validate_many(tuple(records))[1].city == "Shelbyville"
+
+    def test_validate_many_errors_by_index(self):
+        """Test that batch errors are keyed by record index."""
+        records = [
+            {"street": "1 Main St", "city": "Springfield", "postal_code": "111"},
+            {"street": "2 Main St", "postal_code": "222"},
+            "not a dict",
+        ]
+        with pytest.raises(TypeError) as exc:
+            Address.validate_many(records)
+        assert json.loads(str(exc.value)) == {"1.city": "Missing required field"}
+
+        with pytest.raises(TypeError) as exc:
+            Address.validate_many(records, fail_fast=False)
+        assert json.loads(str(exc.value)) == {
+            "1.city": "Missing required field",
+            "2": "Expected type dict, got str",
+        }
+
+    def test_to_columns(self):
+        """Test exporting models as columns with nested fields flattened."""
+        users = [
+            User(
+                id=1,
+                name="Alice",
+                age=30,
+                active=True,
+                address={"street": "Main", "city": "Springfield", "postal_code": "1"},
+                notes=None,
+            ),
+            User(
+                id=2,
+                name="Bob",
+                age=25,
+                active=False,
+                address={"street": "Elm", "city": "Shelbyville", "postal_code": "2"},
+                notes="VIP",
+            ),
+        ]
+        assert User.to_columns(users) == {
+            "id": [1, 2],
+            "name": ["Alice", "Bob"],
+            "age": [30, 25],
+            "active": [True, False],
+            "address.street": ["Main", "Elm"],
+            "address.city": ["Springfield", "Shelbyville"],
+            "address.postal_code": ["1", "2"],
+            "notes": [None, "VIP"],
+        }
+        assert ConfigModel.to_columns([ConfigModel(value=1.234)]) == {"value": ["1.23"]}
+        assert Address.to_columns([])["city"] == []
+        with pytest.raises(TypeError):
+            User.to_columns([Address(street="Main", city="X", postal_code="1")])
+
+    def test_to_arrow(self):
+        """Test exporting primitive columns through the Arrow C Data Interface."""
+        import ctypes
+
+        class ArrowSchema(ctypes.Structure):
+            pass
+
+        ArrowSchema._fields_ = [
+            ("format", ctypes.c_char_p),
+            ("name", ctypes.c_char_p),
+            ("metadata", ctypes.c_char_p),
+            ("flags", ctypes.c_int64),
+            ("n_children", ctypes.c_int64),
+            ("children", ctypes.POINTER(ctypes.POINTER(ArrowSchema))),
+            ("dictionary", ctypes.c_void_p),
+            ("release", ctypes.c_void_p),
+            ("private_data", ctypes.c_void_p),
+        ]
+
+        class ArrowArray(ctypes.Structure):
+            pass
+
+        ArrowArray._fields_ = [
+            ("length", ctypes.c_int64),
+            ("null_count", ctypes.c_int64),
+            ("offset", ctypes.c_int64),
+            ("n_buffers", ctypes.c_int64),
+            ("n_children", ctypes.c_int64),
+            ("buffers", ctypes.POINTER(ctypes.c_void_p)),
+            ("children", ctypes.POINTER(ctypes.POINTER(ArrowArray))),
+            ("dictionary", ctypes.c_void_p),
+            ("release", ctypes.c_void_p),
+            ("private_data", ctypes.c_void_p),
+        ]
+        get_pointer = ctypes.pythonapi.PyCapsule_GetPointer
+        get_pointer.restype = ctypes.c_void_p
+        get_pointer.argtypes = [ctypes.py_object, ctypes.c_char_p]
+
+        companies = [
+            Company(name="Acme", industry="Tools", employees=10),
+            Company(name="Globex", industry="Energy", employees=250),
+        ]
+        batch = Company.to_arrow(companies)
+        schema_capsule, array_capsule = batch.__arrow_c_array__()
+        schema = ArrowSchema.from_address(get_pointer(schema_capsule, b"arrow_schema"))
+        array = ArrowArray.from_address(get_pointer(array_capsule, b"arrow_array"))
+        assert schema.format == b"+s"
+        assert array.length == 2
+        names = [schema.children[i].contents.name for i in range(schema.n_children)]
+        assert names == [b"name", b"industry", b"employees"]
+
+        name_column = array.children[0].contents
+        assert schema.children[0].contents.format == b"u"
+        offsets = (ctypes.c_int32 * 3).from_address(name_column.buffers[1])
+        assert list(offsets) == [0, 4, 10]
+        assert ctypes.string_at(name_column.buffers[2], 10) == b"AcmeGlobex"
+
+        employees = array.children[2].contents
+        assert schema.children[2].contents.format == b"l"
+        assert employees.null_count == 0
+        assert list((ctypes.c_int64 * 2).from_address(employees.buffers[1])) == [10, 250]
+
+        with pytest.raises(ValueError):
+            batch.__arrow_c_array__()
+        # Container fields have no Arrow column.
+        collection = CollectionModel(items=[1], mapping={})
+        _, empty = CollectionModel.to_arrow([collection]).__arrow_c_array__()
+        assert ArrowArray.from_address(get_pointer(empty, b"arrow_array")).n_children == 0
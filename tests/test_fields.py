@@ -1,7 +1,8 @@
 from random import randint
+from typing import Optional, Union
 
 import pytest
-from vldt import DataModel, Field
+from vldt import DataModel, Field, ValidationError
 
 
 class LiteralDefaultModel(DataModel):
@@ -58,6 +59,42 @@ class RoundTripModel(DataModel):
     c: float = Field(default=3.14, alias="c_alias")
 
 
+class Cat(DataModel):
+    """Data model tagged with kind "cat".
+
+    Attributes:
+        kind (str): Discriminator value.
+        lives (int): Number of lives.
+    """
+
+    kind: str = "cat"
+    lives: int
+
+
+class Dog(DataModel):
+    """Data model tagged with kind "dog".
+
+    Attributes:
+        kind (str): Discriminator value.
+        good (bool): Whether the dog is good.
+    """
+
+    kind: str = "dog"
+    good: bool
+
+
+class PetOwnerModel(DataModel):
+    """Data model with a union of models discriminated by kind.
+
+    Attributes:
+        pet (Union[Cat, Dog]): The pet, selected by its kind.
+        other (Optional[Union[Cat, Dog]]): An optional second pet.
+    """
+
+    pet: Union[Cat, Dog] = Field(discriminator="kind")
+    other: Optional[Union[Cat, Dog]] = Field(discriminator="kind")
+
+
 class TestFieldBehavior:
     """Test cases for field behavior in DataModel implementations."""
 
@@ -148,3 +185,90 @@ class TestFieldBehavior:
         d = m.to_dict()
         expected = {"a": 5, "b": "override", "c": 2.71}
         assert d == expected
+
+    def test_discriminated_union(self):
+        """Test that a discriminator selects the union member from dicts and JSON alike."""
+        m = PetOwnerModel(pet={"kind": "dog", "good": True})
+        assert isinstance(m.pet, Dog)
+        assert m.other is None
+
+        m2 = PetOwnerModel.from_json(
+            '{"pet": {"kind": "cat", "lives": 9}, "other": {"kind": "dog", "good": false}}'
+        )
+        assert isinstance(m2.pet, Cat) and m2.pet.lives == 9
+        assert isinstance(m2.other, Dog) and m2.other.good is False
+
+        cat = Cat(lives=3)
+        assert PetOwnerModel(pet=cat).pet is cat
+
+    def test_discriminated_union_errors(self):
+        """Test that discriminated unions report tag errors and the selected member's errors."""
+        for source in ('{"pet": {"lives": 9}}', '{"pet": {"kind": "fish"}}'):
+            with pytest.raises(ValidationError) as exc:
+                PetOwnerModel.from_json(source)
+            (error,) = exc.value.errors()
+            assert error["path"] == "pet"
+        with pytest.raises(ValidationError) as exc:
+            PetOwnerModel(pet={"lives": 9})
+        assert exc.value.errors()[0]["type"] == "discriminator_missing"
+        with pytest.raises(ValidationError) as exc:
+            PetOwnerModel(pet={"kind": "fish"})
+        assert exc.value.errors()[0]["type"] == "discriminator_unknown"
+        with pytest.raises(ValidationError) as exc:
+            PetOwnerModel(pet={"kind": "cat", "lives": "many"})
+        assert [e["path"] for e in exc.value.errors()] == ["pet.lives"]
+
+    def test_discriminator_alias(self):
+        """Test that the tag is also read from the aliases of the tag field."""
+
+        class Parrot(DataModel):
+            """Data model whose tag field has an alias.
+
+            Attributes:
+                kind (str): Discriminator value, also read from "type".
+                words (int): Number of known words.
+            """
+
+            kind: str = Field(default="parrot", alias="type")
+            words: int = 0
+
+        class Aviary(DataModel):
+            """Data model with a union whose members alias the tag differently.
+
+            Attributes:
+                bird (Union[Parrot, Cat]): The bird, selected by its kind.
+            """
+
+            bird: Union[Parrot, Cat] = Field(discriminator="kind")
+
+        assert isinstance(Aviary(bird={"type": "parrot"}).bird, Parrot)
+        assert isinstance(Aviary(bird={"kind": "cat", "lives": 1}).bird, Cat)
+        aviary = Aviary.from_json('{"bird": {"type": "parrot", "words": 3}}')
+        assert isinstance(aviary.bird, Parrot) and aviary.bird.words == 3
+        with pytest.raises(ValidationError) as exc:
+            Aviary.from_json('{"bird": {"type": "fish"}}')
+        assert exc.value.errors()[0]["type"] == "discriminator_unknown"
+
+    def test_discriminator_requires_tagged_models(self):
+        """Test that every member of a discriminated union must declare a distinct tag."""
+
+        class Untagged(DataModel):
+            """Data model without a kind field.
+
+            Attributes:
+                lives (int): Number of lives.
+            """
+
+            lives: int
+
+        class BadModel(DataModel):
+            """Data model whose union member has no discriminator default.
+
+            Attributes:
+                pet (Union[Cat, Untagged]): The pet.
+            """
+
+            pet: Union[Cat, Untagged] = Field(discriminator="kind")
+
+        with pytest.raises(Exception):
+            BadModel(pet={"kind": "cat", "lives": 1})
@@ -5,10 +5,14 @@ and includes tests for converting models to and from JSON format using pytest.
 """
 
 from typing import List, Dict, Optional
+import io
 import json
+import os
+import sys
+import tempfile
 import pytest
 
-from vldt import DataModel
+from vldt import DataModel, Field, ValidationError
 from vldt.config import Config
 
 
@@ -247,3 +251,363 @@ class TestToJsonFromJson:
         user = User.from_json(json_str)
         d = json.loads(user.to_json())
         assert d == data
+
+    def test_from_json_nested_containers(self):
+        """Test that nested models inside lists and dicts are built from JSON."""
+
+        class Directory(DataModel):
+            """Data model holding nested models in containers.
+
+            Attributes:
+                addresses (List[Address]): A list of addresses.
+                offices (Dict[str, Company]): Companies keyed by office name.
+                primary (Optional[Address]): An optional primary address.
+            """
+
+            addresses: List[Address]
+            offices: Dict[str, Company]
+            primary: Optional[Address]
+
+        data = {
+            "addresses": [
+                {"street": "A St", "city": "X", "postal_code": "1"},
+                {"street": "B St", "city": "Y", "postal_code": "2"},
+            ],
+            "offices": {"hq": {"name": "Acme", "industry": "Tools", "employees": 5}},
+            "primary": None,
+        }
+        directory = Directory.from_json(json.dumps(data))
+        assert isinstance(directory.addresses[1], Address)
+        assert directory.addresses[1].street == "B St"
+        assert isinstance(directory.offices["hq"], Company)
+        assert directory.offices["hq"].employees == 5
+        assert directory.primary is None
+        assert json.loads(directory.to_json()) == data
+
+    def test_from_json_coerces_like_from_dict(self):
+        """Test that from_json applies the same conversions as from_dict."""
+        data = {
+            "id": "8",
+            "name": "Grace",
+            "age": 33,
+            "active": True,
+            "address": {"street": "Eighth St", "city": "Port", "postal_code": 99},
+            "notes": None,
+        }
+        from_json = User.from_json(json.dumps(data))
+        from_dict = User.from_dict(data)
+        assert from_json.id == 8
+        assert from_json.address.postal_code == "99"
+        assert from_json.to_dict() == from_dict.to_dict()
+
+    def test_from_json_nested_error_path(self):
+        """Test that nested validation errors are reported with their full path."""
+        data = {
+            "id": 9,
+            "name": "Heidi",
+            "age": 41,
+            "active": True,
+            "address": {"street": "Ninth St", "city": "Lake"},
+            "notes": None,
+        }
+        with pytest.raises(TypeError) as exc:
+            User.from_json(json.dumps(data))
+        assert json.loads(str(exc.value)) == {
+            "address.postal_code": "Missing required field"
+        }
+
+    def test_from_json_many(self):
+        """Test building a list of models from a JSON array."""
+        payload = json.dumps(
+            [
+                {"name": "Acme", "industry": "Tools", "employees": 10},
+                {"name": "Globex", "industry": "Energy", "employees": "250"},
+            ]
+        )
+        companies = Company.from_json_many(payload)
+        assert [c.name for c in companies] == ["Acme", "Globex"]
+        assert companies[1].employees == 250
+
+        companies = Company.from_json_many(payload.encode())
+        assert len(companies) == 2
+        assert Company.from_json_many("[]") == []
+
+    def test_from_json_many_errors_by_index(self):
+        """Test that batch errors are keyed by record index."""
+        payload = json.dumps(
+            [
+                {"name": "Acme", "industry": "Tools", "employees": 10},
+                {"name": "Initech", "industry": "Software", "employees": "many"},
+                [],
+                {"name": "Hooli", "industry": "Software"},
+            ]
+        )
+        with pytest.raises(TypeError) as exc:
+            Company.from_json_many(payload)
+        assert json.loads(str(exc.value)) == {
+            "1.employees": "Expected type int, got str"
+        }
+
+        with pytest.raises(TypeError) as exc:
+            Company.from_json_many(payload, fail_fast=False)
+        assert json.loads(str(exc.value)) == {
+            "1.employees": "Expected type int, got str",
+            "2": "Expected a JSON object",
+            "3.employees": "Missing required field",
+        }
+
+        with pytest.raises(TypeError, match="JSON root must be an array"):
+            Company.from_json_many('{"name": "Acme"}')
+
+    def test_from_json_many_workers(self):
+        """Test that a large array parsed by several workers gives the same models."""
+        records = [
+            {"name": f"Company {i}", "industry": "Tools, [bulk]", "employees": i}
+            for i in range(4000)
+        ]
+        payload = json.dumps(records)
+        expected = [c.to_dict() for c in Company.from_json_many(payload)]
+        for workers in (0, 2, 4):
+            companies = Company.from_json_many(payload, workers=workers)
+            assert [c.to_dict() for c in companies] == expected
+        companies = Company.from_json_many(bytearray(payload.encode()), workers=3)
+        assert companies[-1].employees == 3999
+        companies = Company.from_json_many(memoryview(payload.encode()))
+        assert len(companies) == 4000
+
+        with pytest.raises(ValueError):
+            Company.from_json_many(payload, workers=-1)
+
+    def test_from_json_many_workers_errors(self):
+        """Test that a parallel parse reports the same errors as a serial one."""
+        records = [
+            {"name": f"Company {i}", "industry": "Tools", "employees": i}
+            for i in range(4000)
+        ]
+        records[3500]["employees"] = "many"
+        payload = json.dumps(records)
+        with pytest.raises(TypeError) as exc:
+            Company.from_json_many(payload, workers=4)
+        assert json.loads(str(exc.value)) == {
+            "3500.employees": "Expected type int, got str"
+        }
+
+        broken = payload.replace('"employees": 3000}', '"employees": 3000,}')
+        with pytest.raises(ValueError) as serial:
+            Company.from_json_many(broken)
+        with pytest.raises(ValueError) as parallel:
+            Company.from_json_many(broken, workers=4)
+        assert str(parallel.value) == str(serial.value)
+
+    def test_to_json_many(self):
+        """Test writing many models as one JSON array."""
+        companies = [
+            Company(name="Acme", industry="Tools", employees=10),
+            Company(name="Globex", industry="Energy", employees=250),
+        ]
+        payload = Company.to_json_many(companies)
+        assert json.loads(payload) == [c.to_dict() for c in companies]
+        assert Company.from_json_many(payload) == companies
+        assert Company.to_json_many(()) == "[]"
+        with pytest.raises(TypeError):
+            Company.to_json_many([companies[0], {"name": "Initech"}])
+
+    def test_to_json_into(self):
+        """Test streaming JSON into writers, callables, buffers and files."""
+        companies = [
+            Company(name=f"Company {i}", industry="Tools", employees=i)
+            for i in range(200)
+        ]
+        expected = Company.to_json_many(companies).encode()
+
+        chunks = []
+        written = Company.to_json_many_into(companies, chunks.append, chunk_size=256)
+        assert written == len(expected)
+        assert b"".join(chunks) == expected
+        assert max(len(chunk) for chunk in chunks) == 256
+
+        stream = io.BytesIO()
+        companies[0].to_json_into(stream, chunk_size=8)
+        assert stream.getvalue() == companies[0].to_json().encode()
+
+        appended = bytearray(b">")
+        Company.to_json_many_into(companies, appended)
+        assert appended == b">" + expected
+
+        with tempfile.TemporaryFile() as f:
+            Company.to_json_many_into(companies, f.fileno())
+            f.seek(0)
+            assert f.read() == expected
+
+    def test_to_json_into_errors(self):
+        """Test that output and argument errors are raised."""
+        company = Company(name="Acme", industry="Tools", employees=10)
+
+        def fail(chunk):
+            raise OSError("disk full")
+
+        with pytest.raises(OSError, match="disk full"):
+            company.to_json_into(fail)
+        with pytest.raises(ValueError):
+            company.to_json_into(memoryview(bytearray(4)))
+        with pytest.raises(ValueError):
+            company.to_json_into(io.BytesIO(), chunk_size=0)
+        with pytest.raises(MemoryError):
+            company.to_json_into(bytearray(), chunk_size=sys.maxsize)
+        with pytest.raises(MemoryError):
+            Company.to_json_many_into([company], bytearray(), chunk_size=sys.maxsize)
+        with pytest.raises(TypeError):
+            company.to_json_into(1.5)
+        target = bytearray(len(company.to_json()))
+        assert company.to_json_into(memoryview(target)) == len(target)
+        assert target == company.to_json().encode()
+
+    def test_iter_json_lines(self):
+        """Test iterating over models stored as JSON lines."""
+        lines = b'{"name": "Acme", "industry": "Tools", "employees": 10}\n\n'
+        lines += b'{"name": "Globex", "industry": "Energy", "employees": 250}\r\n'
+        assert [c.name for c in Company.iter_json_lines(lines)] == ["Acme", "Globex"]
+        assert len(list(Company.iter_json_lines(io.BytesIO(lines)))) == 2
+        assert len(list(Company.iter_json_lines(io.StringIO(lines.decode())))) == 2
+
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "companies.jsonl")
+            with open(path, "wb") as f:
+                f.write(lines)
+            companies = list(Company.iter_json_lines(path))
+        assert [c.employees for c in companies] == [10, 250]
+
+    def test_iter_json_lines_invalid_lines(self):
+        """Test raising on and skipping invalid JSON lines."""
+        lines = (
+            b'{"name": "Acme", "industry": "Tools", "employees": 10}\n'
+            b'{"name": "Initech", "industry": "Software", "employees": "many"}\n'
+            b"{not json\n"
+            b'{"name": "Globex", "industry": "Energy", "employees": 250}'
+        )
+        with pytest.raises(TypeError) as exc:
+            list(Company.iter_json_lines(lines))
+        assert json.loads(str(exc.value)) == {
+            "2.employees": "Expected type int, got str"
+        }
+
+        it = Company.iter_json_lines(lines, skip_invalid=True)
+        assert [c.name for c in it] == ["Acme", "Globex"]
+        assert [line for line, _ in it.errors] == [2, 3]
+        assert json.loads(it.errors[0][1]) == {
+            "employees": "Expected type int, got str"
+        }
+        assert "parse error" in it.errors[1][1]
+
+    def test_from_json_bytes_like(self):
+        """Test from_json with bytes, bytearray and memoryview input."""
+        payload = json.dumps(
+            {"name": "Acme", "industry": "Tools", "employees": 10}
+        ).encode()
+        for data in (payload, bytearray(payload), memoryview(payload)):
+            company = Company.from_json(data)
+            assert company.name == "Acme"
+            assert company.employees == 10
+
+        with pytest.raises(ValueError):
+            Company.from_json(b"")
+        with pytest.raises(TypeError):
+            Company.from_json(10)
+
+    def test_from_json_nul_byte(self):
+        """Test that text after a NUL byte is not silently dropped."""
+        payload = '{"name": "Acme", "industry": "Tools", "employees": 10}'
+        for data in (
+            payload.encode() + b"\x00 garbage",
+            payload + "\x00{",
+            payload + "\x00",
+            payload.replace("Acme", "Ac\x00me"),
+        ):
+            with pytest.raises(ValueError, match="parse error"):
+                Company.from_json(data)
+        with pytest.raises(ValueError, match="parse error"):
+            Company.from_json_many(f"[{payload}\x00 garbage]")
+        records = [payload] * 4000
+        records[3000] += "\x00 garbage"
+        with pytest.raises(ValueError, match="parse error"):
+            Company.from_json_many(f"[{', '.join(records)}]", workers=2)
+        lines = f"{payload}\x00 garbage\n{payload}".encode()
+        it = Company.iter_json_lines(lines, skip_invalid=True)
+        assert [c.name for c in it] == ["Acme"]
+        assert [line for line, _ in it.errors] == [1]
+
+    def test_to_json_bytes(self):
+        """Test that to_json_bytes matches the UTF-8 encoding of to_json."""
+        addr = Address(street="Königstraße 1", city="Zürich", postal_code="8001")
+        user = User(id=3, name="Zoë", age=28, active=True, address=addr, notes="✓")
+        data = user.to_json_bytes()
+        assert isinstance(data, bytes)
+        assert data == user.to_json().encode()
+        assert json.loads(data)["address"]["city"] == "Zürich"
+        for _ in range(3):
+            assert user.to_json_bytes() == data
+
+    def test_to_json_inside_serializer(self):
+        """Test calling to_json from a custom serializer during to_json."""
+        inner = Address(street="Main St", city="Town", postal_code="12345")
+
+        class Wrapper:
+            pass
+
+        class Outer(DataModel):
+            label: str
+            extra: object
+            __vldt_config__ = Config(json_serializer={Wrapper: lambda w: inner.to_json()})
+
+        model = Outer(label="outer", extra=Wrapper())
+        d = json.loads(model.to_json())
+        assert d["label"] == "outer"
+        assert json.loads(d["extra"]) == inner.to_dict()
+
+    def test_from_json_alias_priority(self):
+        """Test that JSON members bind to fields in alias order, whatever their position."""
+
+        class AliasedModel(DataModel):
+            value: str = Field(alias=["first", "second"])
+            other: int = 0
+
+        data = '{"value": "name", "second": "b", "other": 2, "first": "a"}'
+        model = AliasedModel.from_json(data)
+        assert model.value == "a"
+        assert model.other == 2
+        assert AliasedModel.from_json('{"value": "name", "second": "b"}').value == "b"
+        assert AliasedModel.from_json('{"value": "name"}').value == "name"
+
+    def test_from_json_shared_key(self):
+        """Test that a key naming two fields binds to both of them."""
+
+        class SharedKeyModel(DataModel):
+            a: int = Field(alias="b")
+            b: int = 0
+
+        model = SharedKeyModel.from_json('{"b": 5}')
+        assert model.a == 5
+        assert model.b == 5
+
+    def test_from_json_duplicate_keys(self):
+        """Test that the last of repeated keys wins, as with json.loads."""
+
+        class Pair(DataModel):
+            a: int
+            b: int = 0
+
+        class SharedKeyPair(DataModel):
+            a: int = Field(alias="b")
+            b: int = 0
+
+        data = '{"a": 1, "a": 5, "b": 2, "b": 3}'
+        assert Pair.from_json(data).to_dict() == json.loads(data)
+        assert SharedKeyPair.from_json(data).to_dict() == {"a": 3, "b": 3}
+        with pytest.raises(ValidationError):
+            Pair.from_json('{"a": 1, "b": 1, "b": "x"}')
+
+        class AliasedModel(DataModel):
+            value: str = Field(alias="first")
+
+        aliased = '{"first": "a", "value": "name", "first": "c"}'
+        assert AliasedModel.from_json(aliased).value == "c"
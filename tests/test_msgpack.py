@@ -0,0 +1,143 @@
+"""Module providing data models and tests for msgpack and pickle round trips.
+
+This module defines data models using a custom DataModel base class, and
+includes tests for converting models to and from msgpack, with and without
+validation, and for pickling them, using pytest.
+"""
+
+from typing import Dict, List, Optional, Set, Tuple
+import copy
+import datetime
+import pickle
+import uuid
+import pytest
+
+from vldt import DataModel, Field, ValidationError
+
+
+class Address(DataModel):
+    """Data model for an address.
+
+    Attributes:
+        street (str): The street address.
+        city (str): The city name.
+    """
+
+    street: str
+    city: str
+
+
+class Order(DataModel):
+    """Data model for an order covering the msgpack value types.
+
+    Attributes:
+        id (int): The order ID.
+        total (float): The order total.
+        tags (List[str]): Free-form tags.
+        point (Tuple[int, int]): A pair of coordinates.
+        codes (Set[int]): Distinct product codes.
+        created (datetime.datetime): The creation time.
+        reference (uuid.UUID): The external reference.
+        address (Address): The shipping address.
+        branches (Dict[str, Address]): Addresses by branch name.
+        quantities (Dict[int, int]): Quantities by product code.
+        note (Optional[str]): An optional note.
+        payload (bytes): Opaque data.
+    """
+
+    id: int
+    total: float
+    tags: List[str]
+    point: Tuple[int, int]
+    codes: Set[int]
+    created: datetime.datetime
+    reference: uuid.UUID
+    address: Address
+    branches: Dict[str, Address]
+    quantities: Dict[int, int]
+    note: Optional[str]
+    payload: bytes
+
+
+def make_order() -> Order:
+    """Create an order with every field set."""
+    return Order(
+        id=-7,
+        total=12.345678,
+        tags=["gift", "fragile"],
+        point=(3, 4),
+        codes={1, 2**40},
+        created=datetime.datetime(2024, 5, 6, 7, 8, 9),
+        reference=uuid.UUID(int=42),
+        address={"street": "Main", "city": "Springfield"},
+        branches={"north": {"street": "Elm", "city": "Shelbyville"}},
+        quantities={1: 2, -300: 2**62},
+        note=None,
+        payload=b"\x00\xff",
+    )
+
+
+class TestMsgpack:
+    """Tests for msgpack serialization and pickling of DataModel instances."""
+
+    def test_msgpack_round_trip(self):
+        """Test that both load modes rebuild the fields with their types."""
+        order = make_order()
+        data = order.to_msgpack()
+        assert isinstance(data, bytes)
+        assert len(data) < len(order.to_json())
+        for trusted in (False, True):
+            loaded = Order.from_msgpack(bytearray(data), trusted=trusted)
+            assert loaded.to_dict() == order.to_dict()
+            assert loaded.point == (3, 4)
+            assert loaded.codes == {1, 2**40}
+            assert loaded.created == order.created
+            assert loaded.reference == order.reference
+            assert isinstance(loaded.branches["north"], Address)
+            assert loaded.quantities == {1: 2, -300: 2**62}
+
+    def test_msgpack_errors(self):
+        """Test that invalid data and values are reported."""
+        data = Address(street="Main", city="Springfield").to_msgpack()
+        with pytest.raises(ValueError):
+            Address.from_msgpack(data[:-1])
+        with pytest.raises(ValueError):
+            Address.from_msgpack(data + b"\x00")
+        with pytest.raises(TypeError):
+            Address.from_msgpack(b"\x91\x01")
+        with pytest.raises(ValidationError):
+            Order.from_msgpack(data)
+
+        # Trusted loads still convert values that are not of the field type.
+        with pytest.raises(ValidationError):
+            Order.from_msgpack(b"\x81\xa2id\xa1x", trusted=True)
+        with pytest.raises(ValidationError, match="city"):
+            Address.from_msgpack(b"\x81\xa6street\xa4Main", trusted=True)
+
+    def test_trusted_msgpack_defaults(self):
+        """Test that trusted loads fill fields added after the data was written."""
+
+        class Versioned(DataModel):
+            a: int
+            b: int = 7
+            c: List[int] = Field(default_factory=list)
+            d: Optional[str]
+
+        data = b"\x81\xa1a\x01"
+        for trusted in (False, True):
+            loaded = Versioned.from_msgpack(data, trusted=trusted)
+            assert loaded.to_dict() == {"a": 1, "b": 7, "c": [], "d": None}
+            assert Versioned.from_msgpack(data, trusted=trusted).c is not loaded.c
+        with pytest.raises(ValidationError, match="a"):
+            Versioned.from_msgpack(b"\x80", trusted=True)
+
+    def test_pickle(self):
+        """Test pickling instances with their extra attributes."""
+        order = make_order()
+        order.source = "import"
+        restored = pickle.loads(pickle.dumps(order))
+        assert isinstance(restored, Order)
+        assert restored.to_dict() == order.to_dict()
+        assert restored.source == "import"
+        shallow = copy.copy(order)
+        assert shallow.tags is order.tags
@@ -0,0 +1,112 @@
+"""Module providing tests for the opt-in validation counters of vldt.
+
+This module defines data models using a custom DataModel base class, and
+includes tests for enabling, reading and resetting the counters returned
+by vldt.stats(), using pytest.
+"""
+
+from contextlib import contextmanager
+from typing import List, Union
+
+import pytest
+
+import vldt
+from vldt import DataModel, ValidationError, ValidatorMode, model_validator
+
+
+class Address(DataModel):
+    """Data model for an address.
+
+    Attributes:
+        street (str): The street address.
+        zipcode (int): The postal code.
+    """
+
+    street: str
+    zipcode: int
+
+
+class Customer(DataModel):
+    """Data model for a customer with a union field and a validator.
+
+    Attributes:
+        id (int): The customer ID.
+        score (Union[List[int], float]): Scores, or a single score.
+        address (Address): The address.
+    """
+
+    id: int
+    score: Union[List[int], float]
+    address: Address
+
+    @model_validator(mode=ValidatorMode.AFTER)
+    def check_id(self):
+        """Reject negative IDs.
+
+        Raises:
+            ValueError: If the ID is negative.
+        """
+        if self.id < 0:
+            raise ValueError("ID must be non-negative")
+
+
+@contextmanager
+def counting():
+    """Enable the counters within a block, starting from zero."""
+    previous = vldt.enable_stats()
+    vldt.reset_stats()
+    try:
+        yield
+    finally:
+        vldt.enable_stats(previous)
+
+
+class TestStats:
+    """Tests for vldt.stats() and its companions."""
+
+    def test_counters_need_opt_in(self):
+        """Test that nothing is counted while the counters are disabled."""
+        previous = vldt.enable_stats(False)
+        try:
+            before = vldt.stats().get(Customer, {}).get("instances", 0)
+            Customer(id=1, score=1.0, address={"street": "Main", "zipcode": 1})
+            assert vldt.enable_stats(False) is False
+            assert vldt.stats().get(Customer, {}).get("instances", 0) == before
+        finally:
+            vldt.enable_stats(previous)
+
+    def test_counters(self):
+        """Test the instance, failure, union and validator counters."""
+        address = {"street": "Main", "zipcode": 1}
+        with counting():
+            for _ in range(3):
+                Customer(id=1, score="2.5", address=address)
+            Customer.from_json(
+                '{"id": 2, "score": [1], "address": {"street": "E", "zipcode": 2}}'
+            )
+            with pytest.raises(ValidationError):
+                Customer(id="x", score=1.0, address={"street": "Main"})
+            with pytest.raises(ValueError):
+                Customer(id=-1, score=1.0, address=address)
+            counters = vldt.stats()
+
+        customer = counters[Customer]
+        assert customer["instances"] == 6
+        assert customer["failures"] == 2
+        assert customer["field_failures"] == {"id": 1, "address": 1}
+        assert customer["union_attempts"] >= 6
+        assert customer["validator_ns"] > 0
+        assert customer["validation_ns"] > 0
+        assert customer["compile_ns"] > 0
+        nested = counters[Address]
+        assert (nested["instances"], nested["failures"]) == (6, 1)
+        assert nested["field_failures"] == {"zipcode": 1}
+
+    def test_reset_stats(self):
+        """Test that reset_stats zeroes the counters of every model."""
+        with counting():
+            Customer(id=1, score=1.0, address={"street": "Main", "zipcode": 1})
+            vldt.reset_stats()
+            counters = vldt.stats()[Customer]
+            assert counters["instances"] == 0
+            assert counters["field_failures"] == {}
@@ -1,7 +1,12 @@
-from datetime import datetime
+import json
+from datetime import date, datetime, time, timedelta, timezone
+from decimal import Decimal
+from enum import Enum
+from typing import Optional
 from uuid import UUID
 
-from vldt import DataModel
+import pytest
+from vldt import DataModel, ValidationError
 
 
 class ModelWithManyTypes(DataModel):
@@ -24,6 +29,57 @@ class ModelWithManyTypes(DataModel):
     created_at: datetime
 
 
+class Point(DataModel):
+    """Data model representing a point.
+
+    Attributes:
+        x (int): Horizontal coordinate.
+        y (int): Vertical coordinate.
+    """
+
+    x: int
+    y: int
+
+
+class ModelWithOptionals(DataModel):
+    """Data model with optional plain and nested fields.
+
+    Attributes:
+        count (Optional[int]): Optional count.
+        point (Optional[Point]): Optional nested point.
+    """
+
+    count: Optional[int] = None
+    point: Optional[Point] = None
+
+
+class Color(Enum):
+    """An enumeration of colors."""
+
+    RED = "red"
+    GREEN = "green"
+
+
+class ModelWithStdlibTypes(DataModel):
+    """Data model with standard library value types.
+
+    Attributes:
+        at (datetime): A point in time.
+        day (date): A calendar date.
+        opens (time): A time of day.
+        id (UUID): Unique identifier.
+        price (Decimal): A decimal amount.
+        color (Color): An enum member.
+    """
+
+    at: datetime
+    day: date
+    opens: time
+    id: UUID
+    price: Decimal
+    color: Color
+
+
 class TestTypes:
     """Test suite for ModelWithManyTypes."""
 
@@ -69,3 +125,105 @@ class TestTypes:
         assert obj.height == 1.75
         assert obj.is_active is True
         assert obj.created_at == datetime(2021, 1, 1, 12, 0)
+
+    def test_exact_types_and_subclasses(self):
+        """Test that exact types are kept as is and subclasses are not replaced."""
+
+        class Count(int):
+            """An int subclass."""
+
+        name = "Alice"
+        count = Count(3)
+        obj = ModelWithManyTypes.from_dict(
+            {
+                "id": "123e4567-e89b-12d3-a456-426614174000",
+                "name": name,
+                "age": True,
+                "height": 2,
+                "is_active": False,
+                "created_at": "2021-01-01T12:00:00",
+            }
+        )
+        assert obj.name is name
+        assert obj.age is True
+        assert obj.height == 2.0
+        assert ModelWithOptionals(count=count).count is count
+
+    def test_optional_fields(self):
+        """Test that optional fields accept None, their type, and report mismatches as unions."""
+        assert ModelWithOptionals(count=None, point=None).point is None
+        obj = ModelWithOptionals.from_json('{"count": 2, "point": {"x": 1, "y": 2}}')
+        assert obj.count == 2 and obj.point.y == 2
+        obj = ModelWithOptionals(point={"x": 1, "y": 2})
+        assert isinstance(obj.point, Point)
+        assert ModelWithOptionals.from_json('{"point": null}').point is None
+        for build in (
+            lambda: ModelWithOptionals(point=5),
+            lambda: ModelWithOptionals.from_json('{"point": 5}'),
+        ):
+            with pytest.raises(ValidationError) as exc:
+                build()
+            assert exc.value.errors()[0]["type"] == "union"
+
+    def test_stdlib_types_from_text(self):
+        """Test that standard library types are parsed from their text forms."""
+        data = {
+            "at": "2025-01-01T13:00:00.250+02:00",
+            "day": "2025-01-01",
+            "opens": "09:30",
+            "id": "123E4567E89B12D3A456426614174000",
+            "price": "1.10",
+            "color": "green",
+        }
+        for obj in (
+            ModelWithStdlibTypes.from_dict(data),
+            ModelWithStdlibTypes.from_json(ModelWithStdlibTypes(**data).to_json()),
+        ):
+            assert obj.at == datetime(
+                2025, 1, 1, 13, 0, 0, 250000, timezone(timedelta(hours=2))
+            )
+            assert obj.day == date(2025, 1, 1)
+            assert obj.opens == time(9, 30)
+            assert obj.id == UUID("123e4567-e89b-12d3-a456-426614174000")
+            assert obj.price == Decimal("1.10")
+            assert obj.color is Color.GREEN
+        assert ModelWithStdlibTypes(**data).to_json() == (
+            '{"at":"2025-01-01 13:00:00.250000+02:00","day":"2025-01-01",'
+            '"opens":"09:30:00","id":"123e4567-e89b-12d3-a456-426614174000",'
+            '"price":"1.10","color":"green"}'
+        )
+        # Forms outside the native parser are still accepted as before.
+        assert ModelWithStdlibTypes(**{**data, "at": "20250101T130000"}).at == (
+            datetime(2025, 1, 1, 13, 0)
+        )
+        assert ModelWithStdlibTypes(**{**data, "at": 0}).at == (
+            datetime.fromtimestamp(0)
+        )
+
+    def test_stdlib_types_invalid(self):
+        """Test that invalid standard library values are reported by type."""
+        valid = {
+            "at": "2025-01-01T13:00:00",
+            "day": "2025-01-01",
+            "opens": "09:30",
+            "id": "123e4567-e89b-12d3-a456-426614174000",
+            "price": "1.10",
+            "color": "red",
+        }
+        for name, value in (
+            ("at", "2025-02-30T00:00:00"),
+            ("day", "2025-01-01T00:00:00Z"),
+            ("opens", "25:00"),
+            ("id", "123e4567-e89b-12d3-a456-42661417400g"),
+            ("price", "cheap"),
+            ("color", "blue"),
+        ):
+            for build in (
+                lambda: ModelWithStdlibTypes(**{**valid, name: value}),
+                lambda: ModelWithStdlibTypes.from_json(
+                    json.dumps({**valid, name: value})
+                ),
+            ):
+                with pytest.raises(ValidationError) as exc:
+                    build()
+                assert exc.value.errors()[0]["path"] == name
@@ -2,7 +2,7 @@
 
 import pytest
 from typing import Any
-from vldt import DataModel, field_validator, model_validator, ValidatorMode
+from vldt import Config, DataModel, field_validator, model_validator, ValidatorMode
 
 
 class Person(DataModel):
@@ -140,6 +140,48 @@ class Order(DataModel):
         self.total = round(self.total, 2)
 
 
+class Booking(DataModel):
+    """Data model representing a booking, validated when patched.
+
+    Attributes:
+        start (int): The first day.
+        end (int): The last day.
+    """
+
+    __vldt_config__ = Config(patch_validators=True)
+
+    start: int
+    end: int
+
+    @field_validator(mode=ValidatorMode.BEFORE)
+    @classmethod
+    def check_start(cls, start: Any):
+        """Reject negative start days.
+
+        Args:
+            start (Any): The start value to validate.
+
+        Returns:
+            Any: The unchanged start value.
+
+        Raises:
+            ValueError: If the start day is negative.
+        """
+        if isinstance(start, int) and start < 0:
+            raise ValueError("Start must be non-negative")
+        return start
+
+    @model_validator(mode=ValidatorMode.AFTER)
+    def check_range(self):
+        """Ensure the booking does not end before it starts.
+
+        Raises:
+            ValueError: If end is before start.
+        """
+        if self.end < self.start:
+            raise ValueError("Booking must not end before it starts")
+
+
 def create_invalid_validator_model():
     """Create a data model with an invalid field validator signature.
 
@@ -262,6 +304,46 @@ class TestModelValidatorInstanceMethod:
         assert emp.name == "JANE"
 
 
+class TestFieldValidatorInput:
+    """Test cases for the input seen by field validators."""
+
+    def test_before_validator_leaves_input_unchanged(self):
+        """Test that a field BEFORE validator does not write into the input dict."""
+        data = {"name": "john", "age": "20"}
+        person = Person.from_dict(data)
+        assert person.age == 20
+        assert data["age"] == "20"
+
+    def test_validators_run_on_json_input(self):
+        """Test that field validators run on values read from JSON."""
+        person = Person.from_json('{"name": "john", "age": "42"}')
+        assert person.age == 42
+        assert person.name == "John"
+        product = Product.from_json('{"name": "pen", "price": "1.5"}')
+        assert product.price == 1.5
+        with pytest.raises(ValueError):
+            Product.from_json('{"name": "pen", "price": "-1"}')
+
+
+class TestPatchValidators:
+    """Test cases for validators run by apply_patch."""
+
+    def test_validators_run_only_if_configured(self):
+        """Test that apply_patch runs the validators with patch_validators."""
+        person = Person(name="john", age=20)
+        person.apply_patch({"age": 10})
+        assert person.age == 10
+
+        booking = Booking(start=1, end=5)
+        with pytest.raises(ValueError):
+            booking.apply_patch({"end": 0})
+        with pytest.raises(ValueError):
+            booking.apply_patch({"start": -1})
+        assert (booking.start, booking.end) == (1, 5)
+        booking.apply_patch({"start": 3})
+        assert booking.start == 3
+
+
 class TestInvalidValidatorSignature:
     """Test cases for models with invalid validator signatures."""
 
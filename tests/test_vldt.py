@@ -1,10 +1,19 @@
 import copy
-from typing import ClassVar, Union, Optional, List, Dict, Any
+import json
+from typing import ClassVar, Union, Optional, List, Dict, Any, Tuple
 
 import pytest
 
 from tests.conftest import type_error_to_dict
-from vldt import DataModel, Field
+from vldt import (
+    Config,
+    DataModel,
+    Field,
+    ValidationError,
+    ValidatorMode,
+    freelist_stats,
+    model_validator,
+)
 
 
 class Address(DataModel):
@@ -178,6 +187,26 @@ class TestDataModelValidation:
             "identifier": "Value did not match any candidate in Union: got str"
         }
 
+    def test_union_member_subclass(self):
+        """Test that union members accept exact types and subclasses unchanged."""
+
+        class Label(str):
+            """A str subclass."""
+
+        class UnionModel(DataModel):
+            """A model with a union of plain types.
+
+            Attributes:
+                value (Union[int, str, bytes]): The value.
+            """
+
+            value: Union[int, str, bytes]
+
+        label = Label("x")
+        assert UnionModel(value=label).value is label
+        assert UnionModel(value=True).value is True
+        assert UnionModel(value=b"x").value == b"x"
+
     def test_nested_models(self):
         """Test validation of nested DataModel instances.
 
@@ -248,6 +277,64 @@ class TestDataModelValidation:
         error = type_error_to_dict(exc)
         assert error == {"mapping.b": "Expected type int, got str"}
 
+    def test_valid_containers_pass_through(self):
+        """Test that already valid containers are kept and others are copied lazily.
+
+        Raises:
+            AssertionError: If a valid container is copied or an input is modified.
+        """
+
+        class ContainerModel(DataModel):
+            """A model with container attributes.
+
+            Attributes:
+                values (List[float]): A list of floats.
+                nested (List[List[int]]): A list of integer lists.
+                mapping (Dict[str, int]): A mapping of string keys to integers.
+            """
+
+            values: List[float]
+            nested: List[List[int]]
+            mapping: Dict[str, int]
+
+        values, nested, mapping = [0.5, 1.5], [[1], [2]], {"a": 1}
+        obj = ContainerModel(values=values, nested=nested, mapping=mapping)
+        assert obj.values is values
+        assert obj.nested is nested
+        assert obj.mapping is mapping
+
+        values = [0.5, 1]
+        obj = ContainerModel(values=values, nested=[[1], ["2"]], mapping={"a": 1.0})
+        assert obj.values == [0.5, 1.0] and obj.values is not values
+        assert values == [0.5, 1]
+        assert obj.nested == [[1], [2]]
+        assert obj.mapping == {"a": 1}
+
+    def test_mutable_defaults_not_shared(self):
+        """Test that container defaults are copied for each instance.
+
+        Raises:
+            AssertionError: If instances share a default container.
+        """
+
+        class DefaultContainerModel(DataModel):
+            """A model with mutable default values.
+
+            Attributes:
+                items (List[List[int]]): A list of integer lists.
+                mapping (Dict[str, int]): A mapping of string keys to integers.
+            """
+
+            items: List[List[int]] = [[1]]
+            mapping: Dict[str, int] = {}
+
+        first, second = DefaultContainerModel(), DefaultContainerModel()
+        first.items[0].append(2)
+        first.mapping["a"] = 1
+        assert second.items == [[1]]
+        assert second.mapping == {}
+        assert DefaultContainerModel.from_json("{}").items == [[1]]
+
     def test_class_variable_validation(self):
         """Test class variable validation.
 
@@ -694,6 +781,179 @@ class TestDataModelValidation:
         assert obj1 == obj2
         assert obj1 is not obj2
 
+    def test_model_copy_update(self):
+        """Test model_copy with updated fields.
+
+        Raises:
+            AssertionError: If the copy does not share unchanged values or
+                updated fields are not validated.
+        """
+
+        class StateModel(DataModel):
+            """A model to test copying with updates.
+
+            Attributes:
+                id (int): The identifier.
+                tags (List[str]): The tags.
+            """
+
+            id: int
+            tags: List[str]
+
+        state = StateModel(id=1, tags=["a"])
+        updated = state.model_copy(update={"id": 2, "label": "extra"})
+        assert (updated.id, updated.label) == (2, "extra")
+        assert updated.tags is state.tags
+        assert state.id == 1
+
+        deep = state.model_copy(deep=True)
+        assert deep.tags == state.tags
+        assert deep.tags is not state.tags
+
+        with pytest.raises(ValidationError) as exc:
+            state.model_copy(update={"id": "x", "tags": 5})
+        assert set(json.loads(str(exc.value))) == {"id", "tags"}
+        with pytest.raises(TypeError):
+            state.model_copy(update=[("id", 2)])
+
+    def test_deepcopy_shares_immutable_values(self):
+        """Test that deep copies share immutable values and copy the rest.
+
+        Raises:
+            AssertionError: If mutable values are shared or references within
+                the instance are not preserved.
+        """
+
+        class DeepModel(DataModel):
+            """A model to test deep copies.
+
+            Attributes:
+                name (str): The name.
+                point (Tuple[int, int]): A pair of coordinates.
+                tags (List[str]): The tags.
+            """
+
+            name: str
+            point: Tuple[int, int]
+            tags: List[str]
+
+        original = DeepModel(name="x" * 100, point=(1, 2), tags=["a"])
+        original.same_tags = original.tags
+        original.itself = original
+        copied = copy.deepcopy(original)
+        assert copied.name is original.name
+        assert copied.point is original.point
+        assert copied.tags is not original.tags
+        assert copied.same_tags is copied.tags
+        assert copied.itself is copied
+
+    def test_apply_patch(self):
+        """Test applying merge patches from dicts and JSON.
+
+        Raises:
+            AssertionError: If patched fields are not validated, nested
+                models are replaced or untouched values are not kept.
+        """
+
+        class Customer(DataModel):
+            """A model to test patching.
+
+            Attributes:
+                id (int): The identifier.
+                address (Address): The address.
+                scores (Dict[str, int]): Scores by name.
+                tags (List[str]): The tags.
+            """
+
+            id: int
+            address: Address
+            scores: Dict[str, int]
+            tags: List[str]
+
+        customer = Customer(
+            id=1,
+            address={"street": "Main", "zipcode": 1},
+            scores={"a": 1, "b": 2},
+            tags=["x"],
+        )
+        address, tags = customer.address, customer.tags
+        customer.apply_patch(
+            {"id": "2", "address": {"zipcode": "A1"}, "scores": {"a": None, "c": 3}}
+        )
+        assert customer.id == 2
+        assert customer.address is address
+        assert (address.street, address.zipcode) == ("Main", "A1")
+        assert customer.scores == {"b": 2, "c": 3}
+        assert customer.tags is tags
+
+        customer.apply_patch(b'{"note": "vip", "tags": ["y"]}')
+        assert (customer.note, customer.tags) == ("vip", ["y"])
+        customer.apply_patch('{"note": null}')
+        assert not hasattr(customer, "note")
+
+    def test_apply_patch_aliases(self):
+        """Test that patch keys may be field aliases, as in init.
+
+        Raises:
+            AssertionError: If an aliased key is stored as an extra
+                attribute or its value is not validated.
+        """
+
+        class Person(DataModel):
+            age: int = Field(alias="Age")
+            name: str = Field(default="", alias=["Name", "FullName"])
+
+        person = Person(Age=3)
+        person.apply_patch({"Age": "4", "FullName": "Ann"})
+        assert (person.age, person.name) == (4, "Ann")
+        assert not hasattr(person, "Age")
+        with pytest.raises(ValidationError):
+            person.apply_patch('{"Age": "notint"}')
+        assert person.age == 4
+
+        class Swapped(DataModel):
+            first: int = Field(alias="second")
+            second: int = 0
+            third: int = Field(default=0, alias="Third")
+
+        # A key naming two fields leaves the key table unset; names win.
+        swapped = Swapped(second=1)
+        swapped.apply_patch({"second": 2, "Third": "3"})
+        assert (swapped.first, swapped.second, swapped.third) == (1, 2, 3)
+
+    def test_apply_patch_is_atomic(self):
+        """Test that an invalid patch leaves the instance unchanged.
+
+        Raises:
+            AssertionError: If part of an invalid patch is applied or the
+                errors are not reported with their paths.
+        """
+
+        class Account(DataModel):
+            """A model to test atomic patches.
+
+            Attributes:
+                id (int): The identifier.
+                product (Product): The product.
+            """
+
+            id: int
+            product: Product
+
+        account = Account(id=1, product={"id": 1, "name": "Pen", "price": 1.5})
+        before = account.to_dict()
+        with pytest.raises(ValidationError) as exc:
+            account.apply_patch(
+                {"id": "x", "label": "new", "product": {"name": "Ink", "price": []}}
+            )
+        assert set(json.loads(str(exc.value))) == {"id", "product.price"}
+        assert account.to_dict() == before
+        assert not hasattr(account, "label")
+        with pytest.raises(ValueError):
+            account.apply_patch("{")
+        with pytest.raises(TypeError):
+            account.apply_patch([("id", 2)])
+
     def test_model_update(self):
         """Test updating a model's attributes.
 
@@ -816,3 +1076,473 @@ class TestDataModelValidation:
         )
         assert m.data["address1"].zipcode == 90210
         assert m.data["product1"].id == "wrong"
+
+    def test_extra_attributes(self):
+        """Test attributes that are not declared as fields.
+
+        Raises:
+            AssertionError: If extra attributes are not stored alongside fields.
+        """
+        product = Product(id=1, name="Test", price=10.0)
+        product.note = "not a field"
+        assert product.note == "not a field"
+        assert product.to_dict() == {
+            "id": 1,
+            "name": "Test",
+            "price": 10.0,
+            "in_stock": True,
+        }
+
+        product.note = "updated"
+        product.id = 2
+        assert product.note == "updated"
+        assert product.id == 2
+
+        copied = copy.deepcopy(product)
+        assert copied.note == "updated"
+        assert copied.id == 2
+
+        with pytest.raises(AttributeError):
+            product.missing
+
+    def test_field_delete_rejected(self):
+        """Test that declared fields cannot be deleted.
+
+        Raises:
+            AssertionError: If deleting a field does not raise AttributeError.
+        """
+        product = Product(id=1, name="Test", price=10.0)
+        with pytest.raises(AttributeError):
+            del product.id
+        assert product.id == 1
+
+        product.note = "temporary"
+        del product.note
+        with pytest.raises(AttributeError):
+            product.note
+
+    def test_assignment_validates_generic_fields(self):
+        """Test that assignment validates nested generic field types.
+
+        Raises:
+            AssertionError: If assigned values are not validated per field.
+        """
+
+        class Metrics(DataModel):
+            values: List[Dict[str, float]]
+            label: ClassVar[str] = "metrics"
+
+        m = Metrics(values=[])
+        for _ in range(3):
+            m.values = [{"a": 1.0}, {"b": 2}]
+        assert m.values == [{"a": 1.0}, {"b": 2.0}]
+
+        with pytest.raises(TypeError) as exc:
+            m.values = [{"a": "x"}]
+        assert type_error_to_dict(exc) == {
+            "values.0.a": "Expected type float, got str"
+        }
+
+        with pytest.raises(AttributeError):
+            m.label = "other"
+
+    def test_nested_error_paths(self):
+        """Test that errors of deeply nested models carry their full path.
+
+        Raises:
+            AssertionError: If nested errors are not reported per field path.
+        """
+
+        class Leaf(DataModel):
+            x: int
+            y: str
+
+        class Branch(DataModel):
+            leaf: Leaf
+            leaves: List[Leaf]
+
+        class Root(DataModel):
+            branch: Branch
+
+        data = {
+            "branch": {
+                "leaf": {"x": "no"},
+                "leaves": [{"x": 1, "y": "a"}, {"x": "z", "y": "b"}],
+            }
+        }
+        expected = {
+            "branch.leaf.x": "Expected type int, got str",
+            "branch.leaf.y": "Missing required field",
+            "branch.leaves.1.x": "Expected type int, got str",
+        }
+        with pytest.raises(TypeError) as exc:
+            Root.from_dict(data)
+        assert type_error_to_dict(exc) == expected
+        with pytest.raises(TypeError) as exc:
+            Root.from_json(json.dumps(data))
+        assert type_error_to_dict(exc) == expected
+
+    def test_long_error_paths(self):
+        """Test that error paths through long keys and non-str keys are complete.
+
+        Raises:
+            AssertionError: If an error path is truncated or misformatted.
+        """
+
+        class KeyedModel(DataModel):
+            """A model with nested mappings.
+
+            Attributes:
+                groups (Dict[str, List[Dict[int, int]]]): Nested mappings.
+            """
+
+            groups: Dict[str, List[Dict[int, int]]]
+
+        key = "k" * 300
+        with pytest.raises(ValidationError) as exc:
+            KeyedModel(groups={key: [{1: 1}, {2: "x"}]})
+        assert exc.value.errors()[0]["path"] == f"groups.{key}.1.int"
+        with pytest.raises(ValidationError) as exc:
+            KeyedModel.from_json(json.dumps({"groups": {key: [{"1": "x"}]}}))
+        assert exc.value.errors()[0]["path"] == f"groups.{key}.0.1"
+
+    def test_nested_validators(self):
+        """Test that validators of nested models keep their behaviour.
+
+        Raises:
+            AssertionError: If nested validators run when they should not.
+        """
+        calls = []
+
+        class Leaf(DataModel):
+            x: int
+
+            @model_validator(mode=ValidatorMode.AFTER)
+            def check(self):
+                calls.append(self.x)
+                if self.x < 0:
+                    raise ValueError("negative")
+
+        class Root(DataModel):
+            leaf: Leaf
+
+        assert Root(leaf={"x": 2}).leaf.x == 2
+        assert Root.from_json('{"leaf": {"x": 3}}').leaf.x == 3
+        assert calls == [2, 3]
+
+        with pytest.raises(TypeError) as exc:
+            Root(leaf={"x": "bad"})
+        assert type_error_to_dict(exc) == {"leaf.x": "Expected type int, got str"}
+        assert calls == [2, 3]
+
+        with pytest.raises(TypeError) as exc:
+            Root(leaf={"x": -1})
+        assert type_error_to_dict(exc) == {"leaf": "Invalid suberror JSON"}
+
+    def test_validation_error_structure(self):
+        """Test that validation failures raise a structured ValidationError.
+
+        Raises:
+            AssertionError: If the exception does not expose its errors.
+        """
+
+        class Inner(DataModel):
+            value: int
+
+        class Outer(DataModel):
+            name: str
+            inner: Inner
+            tags: List[str]
+
+        with pytest.raises(ValidationError) as exc:
+            Outer(inner={"value": "x"}, tags="nope")
+        assert isinstance(exc.value, TypeError)
+        assert exc.value.errors() == [
+            {"path": "name", "type": "missing", "msg": "Missing required field"},
+            {
+                "path": "inner.value",
+                "type": "type_error",
+                "msg": "Expected type int, got str",
+            },
+            {"path": "tags", "type": "list_type", "msg": "Expected a list, got str"},
+        ]
+        assert type_error_to_dict(exc) == {
+            "name": "Missing required field",
+            "inner.value": "Expected type int, got str",
+            "tags": "Expected a list, got str",
+        }
+        assert str(exc.value) is str(exc.value)
+
+    def test_validation_error_pickle(self):
+        """Test that a ValidationError survives pickling as its message.
+
+        Raises:
+            AssertionError: If the unpickled error has a different message.
+        """
+        import pickle
+
+        class Point(DataModel):
+            x: int
+            y: int
+
+        with pytest.raises(ValidationError) as exc:
+            Point(x="a")
+        restored = pickle.loads(pickle.dumps(exc.value))
+        assert isinstance(restored, ValidationError)
+        assert str(restored) == str(exc.value)
+
+    def test_subclass_schema_is_separate(self):
+        """Test that a subclass compiles its own schema after its base.
+
+        Raises:
+            AssertionError: If the subclass reuses the base schema.
+        """
+
+        class Base(DataModel):
+            x: int
+
+        assert Base(x=1).to_dict() == {"x": 1}
+
+        class Child(Base):
+            y: str
+
+        assert Child(x=2, y="a").to_dict() == {"x": 2, "y": "a"}
+        with pytest.raises(TypeError):
+            Child(x=2)
+        assert Base(x=3).to_dict() == {"x": 3}
+
+    def test_model_class_released(self):
+        """Test that model classes and their schemas can be garbage collected.
+
+        Raises:
+            AssertionError: If a deleted model class stays alive.
+        """
+        import gc
+        import weakref
+
+        class Temporary(DataModel):
+            value: int
+
+        Temporary(value=1).to_json()
+        ref = weakref.ref(Temporary)
+        del Temporary
+        gc.collect()
+        assert ref() is None
+
+    def test_weak_references(self):
+        """Test that instances, including recycled ones, support weakrefs.
+
+        Raises:
+            AssertionError: If a reference outlives its instance.
+        """
+        import gc
+        import weakref
+
+        class Referenced(DataModel):
+            __vldt_config__ = Config(freelist_size=1)
+
+            id: int
+
+        instance = Referenced(id=1)
+        ref = weakref.ref(instance)
+        assert ref() is instance
+        del instance
+        gc.collect()
+        assert ref() is None
+        reused = Referenced(id=2)
+        assert freelist_stats(Referenced)["reused"] == 1
+        assert weakref.ref(reused)().id == 2
+
+    def test_subclass_slots(self):
+        """Test that model subclasses may declare __slots__.
+
+        Raises:
+            AssertionError: If the slot or the fields are not kept.
+        """
+
+        class Slotted(Product):
+            __slots__ = ("cache",)
+
+            label: str = "new"
+
+        item = Slotted(id=1, name="Widget", price=2.5)
+        item.cache = {"hits": 1}
+        assert item.cache == {"hits": 1}
+        assert item.label == "new"
+        assert item.to_dict()["price"] == 2.5
+        assert copy.deepcopy(item).to_dict() == item.to_dict()
+
+    def test_lazy_validation_on_access(self):
+        """Test that lazy models validate each field on first access.
+
+        Raises:
+            AssertionError: If an unread field is validated on init or an
+                invalid field is not reported on access or by validate_all.
+        """
+
+        class LazyItem(DataModel):
+            __vldt_config__ = Config(lazy=True)
+
+            value: int
+
+        class LazyOrder(DataModel):
+            __vldt_config__ = Config(lazy=True)
+
+            id: int
+            note: str
+            items: List[LazyItem]
+
+        order = LazyOrder(id="bad", note="n", items=[{"value": 1}, {"value": "x"}])
+        assert order.note == "n"
+        with pytest.raises(ValidationError) as exc_info:
+            order.id
+        assert exc_info.value.errors()[0]["path"] == "id"
+        assert order.items[0].value == 1
+        with pytest.raises(ValidationError) as exc_info:
+            order.validate_all()
+        paths = [error["path"] for error in exc_info.value.errors()]
+        assert paths == ["id", "items.1.value"]
+
+        with pytest.raises(ValidationError):
+            LazyOrder(note="n").validate_all()
+
+    def test_lazy_validation_from_json(self):
+        """Test that lazy models read pending fields from the parsed JSON.
+
+        Raises:
+            AssertionError: If values read lazily or serialized differ from
+                the input, or serializing does not validate pending fields.
+        """
+
+        class LazyRecord(DataModel):
+            __vldt_config__ = Config(lazy=True)
+
+            id: int
+            tags: List[str]
+            address: Address
+            extra: Optional[int] = None
+
+        data = {"id": 1, "tags": ["a"], "address": {"street": "s", "zipcode": 1}}
+        record = LazyRecord.from_json(json.dumps(data))
+        assert record.tags == ["a"]
+        expected = dict(data, address=dict(data["address"], country="USA"))
+        expected["extra"] = None
+        assert record.to_dict() == expected
+        assert json.loads(LazyRecord.from_json(json.dumps(data)).to_json()) == expected
+        assert copy.deepcopy(record).to_dict() == expected
+
+        invalid = LazyRecord.from_json(json.dumps(dict(data, id="x")))
+        assert invalid.tags == ["a"]
+        with pytest.raises(ValidationError):
+            invalid.to_json()
+        with pytest.raises(ValidationError):
+            invalid.to_dict()
+
+    def test_freelist_reuses_instances(self):
+        """Test that deallocated instances are recycled up to the limit.
+
+        Raises:
+            AssertionError: If the freelist counters or the reused instances
+                are wrong.
+        """
+
+        class Pooled(DataModel):
+            __vldt_config__ = Config(freelist_size=2)
+
+            value: int
+            tags: List[str] = []
+
+        instances = [Pooled(value=i, tags=["t"]) for i in range(4)]
+        instances[0].extra = "x"
+        del instances
+        stats = freelist_stats(Pooled)
+        assert stats["size"] == 2
+        assert stats["limit"] == 2
+        assert stats["created"] == 4
+
+        reused = [Pooled(value=i) for i in range(3)]
+        stats = freelist_stats(Pooled)
+        assert stats["reused"] == 2
+        assert stats["size"] == 0
+        assert [item.to_dict() for item in reused] == [
+            {"value": i, "tags": []} for i in range(3)
+        ]
+        assert not hasattr(reused[0], "extra")
+
+    def test_freelist_disabled(self):
+        """Test that a freelist size of 0 frees every instance.
+
+        Raises:
+            AssertionError: If an instance is recycled.
+        """
+
+        class Unpooled(DataModel):
+            __vldt_config__ = Config(freelist_size=0)
+
+            value: int
+
+        for i in range(3):
+            Unpooled(value=i)
+        stats = freelist_stats(Unpooled)
+        assert stats["size"] == 0
+        assert stats["reused"] == 0
+        assert stats["created"] == 3
+        with pytest.raises(TypeError):
+            freelist_stats(int)
+
+    def test_concurrent_first_use(self):
+        """Test that threads using a new model at once share one schema.
+
+        Raises:
+            AssertionError: If a thread fails or sees a different schema.
+        """
+        import threading
+
+        class Shared(DataModel):
+            address: Address
+            tags: List[str]
+
+        rounds = 200
+        barrier = threading.Barrier(8)
+        failures = []
+
+        def worker():
+            barrier.wait()
+            try:
+                for i in range(rounds):
+                    item = Shared(address={"street": "Main", "zipcode": i}, tags=["a"])
+                    item.tags = [str(i)]
+                    assert item.address.zipcode == i
+                    assert item.tags == [str(i)]
+            except Exception as exc:
+                failures.append(exc)
+
+        threads = [threading.Thread(target=worker) for _ in range(8)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        assert failures == []
+        stats = freelist_stats(Shared)
+        assert stats["reused"] + stats["created"] == 8 * rounds
+
+    def test_extension_module_reexecuted(self):
+        """Test that importing the extension again reuses its shared types.
+
+        Raises:
+            AssertionError: If the new module exposes different types.
+        """
+        import importlib
+        import sys
+
+        import vldt._vldt as original
+
+        del sys.modules["vldt._vldt"]
+        try:
+            fresh = importlib.import_module("vldt._vldt")
+            assert fresh is not original
+            assert fresh.DataModel is original.DataModel
+            assert fresh.ValidationError is original.ValidationError
+            assert Address(street="Main", zipcode=1).country == "USA"
+        finally:
+            sys.modules["vldt._vldt"] = original
@@ -1,3 +1,10 @@
+from vldt._vldt import (
+    ValidationError,
+    enable_stats,
+    freelist_stats,
+    reset_stats,
+    stats,
+)
 from vldt.config import Config
 from vldt.fields import Field
 from vldt.models import DataModel, AsyncDataModel
@@ -19,4 +26,9 @@ __all__ = [
     "model_validator",
     "Field",
     "Config",
+    "ValidationError",
+    "enable_stats",
+    "freelist_stats",
+    "reset_stats",
+    "stats",
 ]
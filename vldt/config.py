@@ -8,17 +8,50 @@ class Config:
         dict_serializer (dict): Encoder for dictionaries.
         json_serializer (dict): Encoder for JSON.
         deserializer (dict): Deserializer.
+        lazy (bool): Validate each field on first access instead of on init.
+        freelist_size (int): Number of deallocated instances kept for reuse.
+        concurrent_validators (bool): Run the async validators of different
+            fields concurrently.
+        patch_validators (bool): Run the validators on the result of
+            `apply_patch()`.
     """
 
-    def __init__(self, dict_serializer=None, json_serializer=None, deserializer=None):
+    def __init__(
+        self,
+        dict_serializer=None,
+        json_serializer=None,
+        deserializer=None,
+        lazy=False,
+        freelist_size=None,
+        concurrent_validators=False,
+        patch_validators=False,
+    ):
         """Initialize the Config instance.
 
         Args:
             dict_serializer (dict, optional): Encoder for dictionaries. Defaults to {}.
             json_serializer (dict, optional): Encoder for JSON. Defaults to {}.
             deserializer (dict, optional): Deserializer.
+            lazy (bool, optional): Keep the raw input and validate each field
+                the first time it is read; `validate_all()` validates the
+                rest. Ignored for models with validators. Defaults to False.
+            freelist_size (int, optional): Number of deallocated instances of
+                the model kept to serve later allocations; 0 disables the
+                freelist. Defaults to 64.
+            concurrent_validators (bool, optional): Run the async field
+                validators of an AsyncDataModel for different fields
+                concurrently; the validators of one field and the model
+                validators still run in order. Defaults to False.
+            patch_validators (bool, optional): Run the BEFORE validators of
+                the patched fields and the AFTER validators of each patched
+                model in `apply_patch()`; a failing validator discards the
+                whole patch. Defaults to False.
         """
         self.dict_serializer = dict_serializer if dict_serializer is not None else {}
         self.json_serializer = json_serializer if json_serializer is not None else {}
         deserializer = deserializer if deserializer is not None else {}
         self.deserializer = GLOBAL_DESERIALIZER | deserializer
+        self.lazy = lazy
+        self.freelist_size = freelist_size
+        self.concurrent_validators = concurrent_validators
+        self.patch_validators = patch_validators
@@ -1,8 +1,5 @@
-from datetime import datetime
-
-GLOBAL_DESERIALIZER = {
-    datetime: {
-        str: lambda v: datetime.fromisoformat(v),
-        int: lambda v: datetime.fromtimestamp(v),
-    },
-}
+# Deserializers applied to every model before those of its Config.
+#
+# Strings and timestamps convert to datetime, and strings to date, time and
+# UUID, natively; registering a function for a source type overrides that.
+GLOBAL_DESERIALIZER = {}
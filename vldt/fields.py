@@ -5,9 +5,13 @@ class Field:
         default (Any): The default value of the field.
         default_factory (Callable, optional): A callable to generate the default value.
         alias (list): A list of alternative names for the field.
+        discriminator (str, optional): For a union of models, the key whose value
+            selects the model to validate against.
     """
 
-    def __init__(self, *, default=None, alias=None, default_factory=None):
+    def __init__(
+        self, *, default=None, alias=None, default_factory=None, discriminator=None
+    ):
         """Initialize a Field instance.
 
         Args:
@@ -16,6 +20,9 @@ class Field:
                 for the field. If not provided, defaults to an empty list.
             default_factory (Callable, optional): A callable that returns a default value.
                 Cannot be used together with `default`.
+            discriminator (str, optional): The name of a field that every model of
+                the union declares with a distinct default value. Input dicts are
+                dispatched on that key instead of trying each model in turn.
 
         Raises:
             ValueError: If both `default` and `default_factory` are provided.
@@ -24,6 +31,7 @@ class Field:
             raise ValueError("Cannot specify both default and default_factory")
         self.default = default
         self.default_factory = default_factory
+        self.discriminator = discriminator
         if alias is None:
             self.alias = []
         elif isinstance(alias, (list, tuple)):
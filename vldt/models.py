@@ -1,13 +1,14 @@
+import asyncio
 import inspect
 import sys
 from typing import ClassVar, get_type_hints, get_origin, get_args
 
-from vldt._vldt import DataModel as _DataModel
+from vldt._vldt import DataModel as _DataModel, ModelMeta as _ModelMeta
 from vldt.config import Config
 from vldt.validators import ValidatorMode
 
 
-class DataModelMeta(type):
+class DataModelMeta(_ModelMeta):
     def __new__(mcls, name, bases, namespace):
         cls = super().__new__(mcls, name, bases, namespace)
         return cls
@@ -93,9 +94,37 @@ class DataModelMeta(type):
         super().__init__(name, bases, namespace)
 
 
+class ArrowBatch:
+    """Columns exported by ``DataModel.to_arrow`` as an Arrow struct array.
+
+    Implements the Arrow PyCapsule interface, so it can be passed to
+    ``pyarrow.record_batch`` or any other consumer of ``__arrow_c_array__``.
+    The data is moved into the first consumer.
+    """
+
+    __slots__ = ("_capsules",)
+
+    def __init__(self, capsules):
+        self._capsules = capsules
+
+    def __arrow_c_array__(self, requested_schema=None):
+        if self._capsules is None:
+            raise ValueError("The Arrow batch has already been consumed")
+        capsules, self._capsules = self._capsules, None
+        return capsules
+
+
 class DataModel(_DataModel, metaclass=DataModelMeta):
     __vldt_config__: ClassVar[Config] = Config()
 
+    @classmethod
+    def to_arrow(cls, instances):
+        """Export the int, float, str and bool columns of instances to Arrow.
+
+        Columns are named as by ``to_columns``; other columns are left out.
+        """
+        return ArrowBatch(cls._to_arrow_capsules(instances))
+
     def __init_subclass__(cls, **kwargs):
         super().__init_subclass__(**kwargs)
         cls.__vldt_class_annotations__ = getattr(cls, "__vldt_class_annotations__", {})
@@ -148,9 +177,23 @@ class AsyncDataModelMeta(DataModelMeta):
                         async_model_before.append(attr_value)
                     elif mode == ValidatorMode.AFTER:
                         async_model_after.append(attr_value)
+        # Field chains run, and report errors, in field declaration order.
+        field_order = {
+            field: index
+            for index, field in enumerate(cls.__vldt_instance_annotations__)
+        }
+
+        def in_field_order(validators):
+            return dict(
+                sorted(
+                    validators.items(),
+                    key=lambda item: field_order.get(item[0], len(field_order)),
+                )
+            )
+
         cls.__async_validators__ = {
-            "field_before": async_field_before,
-            "field_after": async_field_after,
+            "field_before": in_field_order(async_field_before),
+            "field_after": in_field_order(async_field_after),
             "model_before": async_model_before,
             "model_after": async_model_after,
         }
@@ -210,36 +253,82 @@ class AsyncDataModel(DataModel, metaclass=AsyncDataModelMeta):
                 if isinstance(result, dict):
                     kwargs.update(result)
         if getattr(self.__class__, "__vldt_has_async_field_before_validators__", False):
-            for field, validators in self.__class__.__async_validators__.get(
-                "field_before", {}
-            ).items():
-                if field in kwargs:
-                    value = kwargs[field]
-                    for validator in validators:
-                        if isinstance(validator, (classmethod, staticmethod)):
-                            value = await validator.__func__(self.__class__, value)
-                        else:
-                            value = await validator(value)
-                    kwargs[field] = value
+            chains = [
+                (field, validators, kwargs[field])
+                for field, validators in self.__class__.__async_validators__.get(
+                    "field_before", {}
+                ).items()
+                if field in kwargs
+            ]
+            values = await self._run_field_chains(chains)
+            for (field, _, _), value in zip(chains, values):
+                kwargs[field] = value
         return kwargs
 
+    async def _run_field_chain(self, validators, value):
+        """Run the async validators of one field in order.
+
+        Args:
+            validators (list): The validators of the field.
+            value (Any): The value of the field.
+
+        Returns:
+            Any: The value returned by the last validator.
+        """
+        for validator in validators:
+            if isinstance(validator, (classmethod, staticmethod)):
+                value = await validator.__func__(self.__class__, value)
+            else:
+                value = await validator(value)
+        return value
+
+    async def _run_field_chains(self, chains):
+        """Run the async validators of several fields.
+
+        The validators of one field always run in order. With
+        `Config(concurrent_validators=True)` the fields are validated
+        concurrently; if several fail, the error of the first field in
+        declaration order is raised once all have finished.
+
+        Args:
+            chains (list): (field, validators, value) tuples.
+
+        Returns:
+            list: The validated value of each field, in the order given.
+        """
+        if not getattr(self.__vldt_config__, "concurrent_validators", False):
+            return [
+                await self._run_field_chain(validators, value)
+                for _, validators, value in chains
+            ]
+        results = await asyncio.gather(
+            *(
+                self._run_field_chain(validators, value)
+                for _, validators, value in chains
+            ),
+            return_exceptions=True,
+        )
+        for result in results:
+            if isinstance(result, BaseException):
+                raise result
+        return results
+
     async def _run_async_after(self):
         """Run asynchronous AFTER validators on this instance.
 
         This method awaits async field and model validators that modify the instance.
         """
         if getattr(self.__class__, "__vldt_has_async_field_after_validators__", False):
-            for field, validators in self.__class__.__async_validators__.get(
-                "field_after", {}
-            ).items():
-                if hasattr(self, field):
-                    value = getattr(self, field)
-                    for validator in validators:
-                        if isinstance(validator, (classmethod, staticmethod)):
-                            value = await validator.__func__(self.__class__, value)
-                        else:
-                            value = await validator(value)
-                    setattr(self, field, value)
+            chains = [
+                (field, validators, getattr(self, field))
+                for field, validators in self.__class__.__async_validators__.get(
+                    "field_after", {}
+                ).items()
+                if hasattr(self, field)
+            ]
+            values = await self._run_field_chains(chains)
+            for (field, _, _), value in zip(chains, values):
+                setattr(self, field, value)
         if getattr(self.__class__, "__vldt_has_async_model_after_validators__", False):
             for validator in self.__class__.__async_validators__.get("model_after", []):
                 if inspect.iscoroutinefunction(validator):
@@ -267,3 +356,37 @@ class AsyncDataModel(DataModel, metaclass=AsyncDataModelMeta):
 
     def __await__(self):
         return self._async_init().__await__()
+
+    @classmethod
+    async def validate_many_async(cls, records, *, concurrency=None):
+        """Create instances from a sequence of dictionaries concurrently.
+
+        The validators of different records overlap, so the I/O of async
+        validators is pipelined across the batch. If records fail, the error
+        of the first failing record is raised once all have finished.
+
+        Args:
+            records (Iterable[dict]): The input records.
+            concurrency (int, optional): Maximum number of records validated
+                at the same time. Defaults to no limit.
+
+        Returns:
+            list: The instances, in the order of the records.
+        """
+        if concurrency is not None and concurrency < 1:
+            raise ValueError("concurrency must be at least 1")
+        semaphore = asyncio.Semaphore(concurrency) if concurrency else None
+
+        async def build(record):
+            if semaphore is None:
+                return await cls(**record)
+            async with semaphore:
+                return await cls(**record)
+
+        results = await asyncio.gather(
+            *(build(record) for record in records), return_exceptions=True
+        )
+        for result in results:
+            if isinstance(result, BaseException):
+                raise result
+        return results